@@ -0,0 +1,106 @@
+// bench_gemm.cpp
+// GFLOP/s of the blocked, threaded Matrix product for square and skinny
+// shapes and each element type; results are checked against the naive
+// triple loop when it is cheap
+// usage: bench_gemm [max_n] [threads] [reps] [int|float|double|int64]
+#include "gemm.hpp"
+#include "matrix.hpp"
+#include "thread_pool.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+namespace {
+
+using size_type = dsa::Matrix::size_type;
+
+template <typename T>
+void fill(dsa::BasicMatrix<T>& M, unsigned seed){
+    for (size_type i = 0; i < M.getRows(); i++) {
+        T* r = M.row(i);
+        for (size_type j = 0; j < M.getCols(); j++) {
+            seed = seed * 1103515245u + 12345u;
+            r[j] = static_cast<T>(static_cast<int>(seed >> 16) % 17 - 8);
+        }
+    }
+}
+
+template <typename T>
+bool close(T a, T b){
+    return std::abs(static_cast<double>(a) - static_cast<double>(b)) <= 1e-3 * (1 + std::abs(static_cast<double>(b)));
+}
+
+template <typename F>
+double best_seconds(int reps, F work){
+    double best = 1e300;
+    for (int r = 0; r < reps; r++) {
+        auto start = std::chrono::steady_clock::now();
+        work();
+        auto stop = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(stop - start).count());
+    }
+    return best;
+}
+
+template <typename T>
+void run(const char* kind, size_type m, size_type k, size_type n, dsa::ThreadPool& pool, int reps){
+    dsa::BasicMatrix<T> A(m, k), B(k, n);
+    fill(A, 1);
+    fill(B, 2);
+    dsa::BasicMatrix<T> C(1, 1);
+    double t = best_seconds(reps, [&]{ C = A.multiply(B, pool); });
+    double gflops = 2.0 * m * n * k / t / 1e9;
+
+    const char* check = "skipped";
+    if (static_cast<double>(m) * n * k <= 512.0 * 512 * 512) {
+        dsa::BasicMatrix<T> R(m, n);
+        dsa::gemm::naive(m, n, k, A.row(0), A.getStride(), B.row(0), B.getStride(), R.row(0), R.getStride());
+        check = "ok";
+        for (size_type i = 0; i < m; i++)
+            for (size_type j = 0; j < n; j++)
+                if (!close(C(i, j), R(i, j))) check = "MISMATCH";
+    }
+    std::printf("%-7s %5zu x %5zu x %5zu  %9.3f ms  %8.2f GFLOP/s  verify: %s\n",
+                kind, m, k, n, t * 1e3, gflops, check);
+}
+
+} // namespace
+
+template <typename T>
+void runAll(size_type max_n, dsa::ThreadPool& pool, int reps){
+    for (size_type n = 64; n <= max_n; n *= 2) {
+        run<T>("square", n, n, n, pool, reps);
+    }
+    for (size_type n = 64; n <= max_n; n *= 2) {
+        run<T>("tall", n, 64, 64, pool, reps);     // tall-skinny A times small B
+        run<T>("inner", 64, n, 64, pool, reps);    // long inner dimension
+        run<T>("wide", 64, 64, n, pool, reps);     // short A times wide B
+    }
+}
+
+int main(int argc, char** argv){
+    size_type max_n = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 4096;
+    size_type threads = (argc > 2) ? std::strtoull(argv[2], nullptr, 10)
+                                   : std::max(1u, std::thread::hardware_concurrency());
+    int reps = (argc > 3) ? std::atoi(argv[3]) : 3;
+
+    const char* type = (argc > 4) ? argv[4] : "int";
+
+    dsa::ThreadPool pool(threads - 1);
+    std::printf("%s gemm on %zu thread(s), m x k x n\n", type, pool.concurrency());
+
+    if (std::strcmp(type, "float") == 0) {
+        runAll<float>(max_n, pool, reps);
+    } else if (std::strcmp(type, "double") == 0) {
+        runAll<double>(max_n, pool, reps);
+    } else if (std::strcmp(type, "int64") == 0) {
+        runAll<long long>(max_n, pool, reps);
+    } else {
+        runAll<int>(max_n, pool, reps);
+    }
+    return 0;
+}
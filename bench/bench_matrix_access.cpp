@@ -0,0 +1,84 @@
+// bench_matrix_access.cpp
+// ns/element for checked operator(), unchecked(), and row-pointer traversal,
+// plus operator+ which now works on whole rows
+#include "matrix.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+using size_type = dsa::Matrix::size_type;
+
+template <typename F>
+double best_ns_per_elem(size_type elems, int reps, F work){
+    double best = 1e300;
+    for (int r = 0; r < reps; r++) {
+        auto start = std::chrono::steady_clock::now();
+        work();
+        auto stop = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::nano>(stop - start).count());
+    }
+    return best / static_cast<double>(elems);
+}
+
+} // namespace
+
+int main(int argc, char** argv){
+    size_type n = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 2048;
+    int reps = (argc > 2) ? std::atoi(argv[2]) : 5;
+
+    dsa::Matrix a(n, n), b(n, n);
+    for (size_type i = 0; i < n; i++) {
+        for (size_type j = 0; j < n; j++) {
+            a(i, j) = static_cast<int>(i + j);
+            b(i, j) = static_cast<int>(i ^ j);
+        }
+    }
+    const size_type elems = n * n;
+    volatile long long sink = 0;
+
+    double checked = best_ns_per_elem(elems, reps, [&]{
+        long long s = 0;
+        for (size_type i = 0; i < n; i++)
+            for (size_type j = 0; j < n; j++)
+                s += a(i, j);
+        sink = s;
+    });
+    double unchecked = best_ns_per_elem(elems, reps, [&]{
+        long long s = 0;
+        for (size_type i = 0; i < n; i++)
+            for (size_type j = 0; j < n; j++)
+                s += a.unchecked(i, j);
+        sink = s;
+    });
+    double rows = best_ns_per_elem(elems, reps, [&]{
+        long long s = 0;
+        for (size_type i = 0; i < n; i++) {
+            const int* r = a.row(i);
+            for (size_type j = 0; j < n; j++)
+                s += r[j];
+        }
+        sink = s;
+    });
+    double add_checked = best_ns_per_elem(elems, reps, [&]{
+        dsa::Matrix c(n, n);
+        for (size_type i = 0; i < n; i++)
+            for (size_type j = 0; j < n; j++)
+                c(i, j) = a(i, j) + b(i, j);
+        sink = c(n - 1, n - 1);
+    });
+    double add_rows = best_ns_per_elem(elems, reps, [&]{
+        dsa::Matrix c = a + b;
+        sink = c(n - 1, n - 1);
+    });
+
+    std::printf("%zux%zu matrix, ns/element (best of %d)\n", n, n, reps);
+    std::printf("  sum via operator() (checked)   %7.3f\n", checked);
+    std::printf("  sum via unchecked()            %7.3f\n", unchecked);
+    std::printf("  sum via row() pointers         %7.3f\n", rows);
+    std::printf("  add via operator() (checked)   %7.3f\n", add_checked);
+    std::printf("  operator+ (row kernels)        %7.3f\n", add_rows);
+    return 0;
+}
@@ -0,0 +1,77 @@
+// bench_matrix_expr.cpp
+// 4- and 8-term matrix sums: one temporary per '+' (eager) against a single
+// fused pass through the expression templates; reports time, bytes moved
+// and the resulting bandwidth
+#include "matrix.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+using size_type = dsa::Matrix::size_type;
+
+template <typename F>
+double best_seconds(int reps, F work){
+    double best = 1e300;
+    for (int r = 0; r < reps; r++) {
+        auto start = std::chrono::steady_clock::now();
+        work();
+        auto stop = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(stop - start).count());
+    }
+    return best;
+}
+
+// t = m[0] + m[1]; t = t + m[2]; ... each step allocates and streams a full matrix
+dsa::Matrix eager(const std::vector<dsa::Matrix>& m){
+    dsa::Matrix t = m[0] + m[1];
+    for (size_t k = 2; k < m.size(); k++) {
+        dsa::Matrix next = t + m[k];
+        t = std::move(next);
+    }
+    return t;
+}
+
+void report(const char* name, int terms, double seconds, double bytes){
+    std::printf("  %-6s %d terms  %8.2f ms  %8.1f MB moved  %6.2f GB/s\n",
+                name, terms, seconds * 1e3, bytes / 1e6, bytes / seconds / 1e9);
+}
+
+} // namespace
+
+int main(int argc, char** argv){
+    size_type n = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 2048;
+    int reps = (argc > 2) ? std::atoi(argv[2]) : 5;
+
+    std::vector<dsa::Matrix> m;
+    for (int k = 0; k < 8; k++) {
+        m.emplace_back(n, n);
+        m.back()(0, 0) = k;
+    }
+    const double bytes = static_cast<double>(n) * n * sizeof(int);
+
+    std::printf("%zux%zu int matrices\n", n, n);
+    volatile int sink = 0;
+
+    std::vector<dsa::Matrix> four(m.begin(), m.begin() + 4);
+    double e4 = best_seconds(reps, [&]{ dsa::Matrix r = eager(four); sink = r(0, 0); });
+    double f4 = best_seconds(reps, [&]{ dsa::Matrix r = m[0] + m[1] + m[2] + m[3]; sink = r(0, 0); });
+    // eager: 3 temporaries, each zero-filled, 2 reads + 1 write
+    report("eager", 4, e4, 3 * 4 * bytes);
+    // fused: one zero-fill, 4 reads + 1 write
+    report("fused", 4, f4, (1 + 4 + 1) * bytes);
+
+    double e8 = best_seconds(reps, [&]{ dsa::Matrix r = eager(m); sink = r(0, 0); });
+    double f8 = best_seconds(reps, [&]{
+        dsa::Matrix r = m[0] + m[1] + m[2] + m[3] + m[4] + m[5] + m[6] + m[7];
+        sink = r(0, 0);
+    });
+    report("eager", 8, e8, 7 * 4 * bytes);
+    report("fused", 8, f8, (1 + 8 + 1) * bytes);
+
+    std::printf("  speedup: 4 terms %.2fx, 8 terms %.2fx\n", e4 / f4, e8 / f8);
+    return 0;
+}
@@ -0,0 +1,75 @@
+// bench_matrix_kernels.cpp
+// memory bandwidth of the element-wise kernels per instruction set,
+// with memcpy over the same bytes as the roofline
+#include "kernels.hpp"
+#include "matrix.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+using dsa::kernels::Isa;
+using size_type = dsa::kernels::size_type;
+
+// best GB/s over reps, bytes is the traffic of one call
+template <typename F>
+double gbps(double bytes, int reps, F work){
+    double best = 1e300;
+    for (int r = 0; r < reps; r++) {
+        auto start = std::chrono::steady_clock::now();
+        work();
+        auto stop = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(stop - start).count());
+    }
+    return bytes / best / 1e9;
+}
+
+} // namespace
+
+int main(int argc, char** argv){
+    size_type n = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : (size_type(1) << 24);
+    int reps = (argc > 2) ? std::atoi(argv[2]) : 10;
+
+    std::vector<int> a(n, 3), b(n, 5), out(n, 0);
+    const double word = sizeof(int);
+
+    // memcpy moves n words in and n words out
+    double roof = gbps(2 * word * n, reps, [&]{
+        std::memcpy(out.data(), a.data(), n * sizeof(int));
+    });
+    std::printf("%zu ints (%.1f MB per operand), detected isa: %s\n",
+                n, word * n / 1e6, dsa::kernels::isaName(dsa::kernels::detectIsa()));
+    std::printf("  %-8s %-7s %8.2f GB/s  (roofline)\n", "memcpy", "-", roof);
+
+    const Isa isas[] = {Isa::Scalar, Isa::SSE2, Isa::AVX2};
+    for (Isa isa : isas) {
+        if (!dsa::kernels::supported(isa)) {
+            continue;
+        }
+        const dsa::kernels::Table<int> t = dsa::kernels::table<int>(isa);
+        const char* name = dsa::kernels::isaName(isa);
+        struct Row { const char* op; double rate; };
+        Row rows[] = {
+            {"add",   gbps(3 * word * n, reps, [&]{ t.add(a.data(), b.data(), out.data(), n); })},
+            {"sub",   gbps(3 * word * n, reps, [&]{ t.sub(a.data(), b.data(), out.data(), n); })},
+            {"mul",   gbps(3 * word * n, reps, [&]{ t.mul(a.data(), b.data(), out.data(), n); })},
+            {"scale", gbps(2 * word * n, reps, [&]{ t.scale(a.data(), 7, out.data(), n); })},
+            {"axpy",  gbps(3 * word * n, reps, [&]{ t.axpy(7, a.data(), out.data(), n); })},
+        };
+        for (const Row& r : rows) {
+            std::printf("  %-8s %-7s %8.2f GB/s  %5.1f%% of memcpy\n", r.op, name, r.rate, 100 * r.rate / roof);
+        }
+    }
+
+    // the same kernels through dsa::Matrix (allocation of the result included)
+    size_type side = 1;
+    while ((side * 2) * (side * 2) <= n) side *= 2;
+    dsa::Matrix A(side, side), B(side, side);
+    double madd = gbps(3 * word * side * side, reps, [&]{ dsa::Matrix C = A + B; });
+    std::printf("  %-8s %-7s %8.2f GB/s  (Matrix %zux%zu, includes result allocation)\n", "A + B", "auto", madd, side, side);
+    return 0;
+}
@@ -0,0 +1,80 @@
+// bench_matrix_storage.cpp
+// construction and operator+ throughput of the contiguous row-major Matrix
+// against the previous Vector<Vector<int>> layout (one heap block per row)
+#include "matrix.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+using size_type = dsa::Matrix::size_type;
+
+// the storage dsa::Matrix used before: rows built with push_back, then copied in
+class NestedMatrix {
+    size_type rows{0};
+    size_type cols{0};
+    dsa::Vector<dsa::Vector<int>> data;
+
+public:
+    NestedMatrix(size_type r, size_type c) : rows(r), cols(c) {
+        for (size_type i = 0; i < rows; i++) {
+            dsa::Vector<int> row;
+            for (size_type j = 0; j < cols; j++) {
+                row.push_back(0);
+            }
+            data.push_back(row);
+        }
+    }
+
+    int& operator()(size_type i, size_type j) { return data.at(i).at(j); }
+
+    NestedMatrix operator+(NestedMatrix& other) {
+        NestedMatrix result(rows, cols);
+        for (size_type i = 0; i < rows; i++) {
+            for (size_type j = 0; j < cols; j++) {
+                result(i, j) = (*this)(i, j) + other(i, j);
+            }
+        }
+        return result;
+    }
+};
+
+template <typename F>
+double seconds(F work){
+    auto start = std::chrono::steady_clock::now();
+    work();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(stop - start).count();
+}
+
+template <typename M>
+void run(const char* name, size_type n, int reps){
+    double build = 1e300, add = 1e300;
+    long long sink = 0;
+    for (int r = 0; r < reps; r++) {
+        build = std::min(build, seconds([&]{ M m(n, n); sink += m(n - 1, n - 1); }));
+
+        M a(n, n), b(n, n);
+        for (size_type i = 0; i < n; i++) {
+            a(i, i) = 1;
+            b(i, n - 1 - i) = 2;
+        }
+        add = std::min(add, seconds([&]{ M c = a + b; sink += c(0, 0); }));
+    }
+    double elems = static_cast<double>(n) * n;
+    std::printf("%-16s %zux%zu  construct %8.2f ms (%6.2f ns/elem)   operator+ %8.2f ms (%6.2f ns/elem)  [%lld]\n",
+                name, n, n, build * 1e3, build * 1e9 / elems, add * 1e3, add * 1e9 / elems, sink);
+}
+
+} // namespace
+
+int main(int argc, char** argv){
+    size_type n = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 4096;
+    int reps = (argc > 2) ? std::atoi(argv[2]) : 3;
+
+    run<NestedMatrix>("nested rows", n, reps);
+    run<dsa::Matrix>("contiguous", n, reps);
+    return 0;
+}
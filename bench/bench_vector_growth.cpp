@@ -0,0 +1,84 @@
+// bench_vector_growth.cpp
+// time per push_back while a Vector grows from empty
+// compares the raw-storage growth path against the old new T[] strategy
+#include "vector.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace {
+
+// growth as dsa::Vector did it before: new T[cap] default-constructs every
+// slot, then the old elements are copy-assigned over them
+template <typename T>
+class LegacyVector {
+    std::size_t cap{0};
+    std::size_t sz{0};
+    T* data{nullptr};
+
+public:
+    ~LegacyVector(){ delete[] data; }
+
+    void push_back(const T& elem){
+        if (sz == cap) {
+            std::size_t new_cap = std::max<std::size_t>(1, 2 * cap);
+            T* new_array = new T[new_cap];
+            for (std::size_t k = 0; k < sz; k++) {
+                new_array[k] = data[k];
+            }
+            delete[] data;
+            data = new_array;
+            cap = new_cap;
+        }
+        data[sz] = elem;
+        sz++;
+    }
+
+    std::size_t size() const { return sz; }
+};
+
+template <typename Vec, typename T>
+double ns_per_push(int n, int reps, const T& value){
+    double best = 1e300;
+    for (int r = 0; r < reps; r++) {
+        auto start = std::chrono::steady_clock::now();
+        {
+            Vec v;
+            for (int i = 0; i < n; i++) {
+                v.push_back(value);
+            }
+            if (v.size() != static_cast<std::size_t>(n)) {
+                std::abort();
+            }
+        }
+        auto stop = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+        best = std::min(best, ns / n);
+    }
+    return best;
+}
+
+template <typename T>
+void run(const char* name, int n, int reps, const T& value){
+    double legacy = ns_per_push<LegacyVector<T>>(n, reps, value);
+    double raw = ns_per_push<dsa::Vector<T>>(n, reps, value);
+    std::printf("%-12s n=%-9d legacy %8.2f ns/push   raw %8.2f ns/push   speedup %.2fx\n",
+                name, n, legacy, raw, legacy / raw);
+}
+
+} // namespace
+
+int main(int argc, char** argv){
+    int n = (argc > 1) ? std::atoi(argv[1]) : 1000000;
+    int reps = (argc > 2) ? std::atoi(argv[2]) : 5;
+
+    run<int>("int", n, reps, 42);
+    run<double>("double", n, reps, 4.2);
+    run<std::string>("std::string", n, reps, std::string(48, 'x'));
+    run<dsa::Vector<int>>("Vector<int>", n / 10, reps, dsa::Vector<int>());
+    return 0;
+}
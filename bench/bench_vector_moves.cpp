@@ -0,0 +1,107 @@
+// bench_vector_moves.cpp
+// counts element copies vs moves on the insertion paths of dsa::Vector
+// using an instrumented element type that owns a heap buffer
+#include "vector.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+struct Counters {
+    long long copies{0};
+    long long moves{0};
+};
+
+Counters counters;
+
+// behaves like a small string: copying allocates, moving steals
+struct Tracked {
+    static const int kBytes = 64;
+    char* buf{nullptr};
+
+    Tracked() : buf(new char[kBytes]()) {}
+    Tracked(const Tracked& o) : buf(new char[kBytes]) {
+        std::memcpy(buf, o.buf, kBytes);
+        counters.copies++;
+    }
+    Tracked(Tracked&& o) noexcept : buf(o.buf) {
+        o.buf = nullptr;
+        counters.moves++;
+    }
+    Tracked& operator=(const Tracked& o){
+        if (this != &o) {
+            if (!buf) buf = new char[kBytes];
+            std::memcpy(buf, o.buf, kBytes);
+        }
+        counters.copies++;
+        return *this;
+    }
+    Tracked& operator=(Tracked&& o) noexcept {
+        if (this != &o) {
+            delete[] buf;
+            buf = o.buf;
+            o.buf = nullptr;
+        }
+        counters.moves++;
+        return *this;
+    }
+    ~Tracked(){ delete[] buf; }
+};
+
+template <typename F>
+void report(const char* name, int n, F work){
+    counters = Counters{};
+    auto start = std::chrono::steady_clock::now();
+    work();
+    auto stop = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+    std::printf("%-28s n=%-8d copies %10lld   moves %10lld   %8.2f ns/op\n",
+                name, n, counters.copies, counters.moves, ns / n);
+}
+
+} // namespace
+
+int main(int argc, char** argv){
+    int n = (argc > 1) ? std::atoi(argv[1]) : 200000;
+    int m = (argc > 2) ? std::atoi(argv[2]) : 5000; // middle inserts are O(n)
+
+    report("push_back(const T&)", n, [n]{
+        dsa::Vector<Tracked> v;
+        Tracked t;
+        for (int i = 0; i < n; i++) v.push_back(t);
+    });
+    report("push_back(T&&)", n, [n]{
+        dsa::Vector<Tracked> v;
+        for (int i = 0; i < n; i++) v.push_back(Tracked());
+    });
+    report("emplace_back()", n, [n]{
+        dsa::Vector<Tracked> v;
+        for (int i = 0; i < n; i++) v.emplace_back();
+    });
+    report("insert(front, const T&)", m, [m]{
+        dsa::Vector<Tracked> v;
+        Tracked t;
+        for (int i = 0; i < m; i++) v.insert(0, t);
+    });
+    report("emplace(begin())", m, [m]{
+        dsa::Vector<Tracked> v;
+        for (int i = 0; i < m; i++) v.emplace(v.begin());
+    });
+    report("erase(front)", m, [m]{
+        dsa::Vector<Tracked> v;
+        for (int i = 0; i < m; i++) v.emplace_back();
+        for (int i = 0; i < m; i++) v.erase(0);
+    });
+    report("Vector<Vector<int>> rows", n / 100, [n]{
+        dsa::Vector<dsa::Vector<int>> rows;
+        for (int i = 0; i < n / 100; i++) {
+            dsa::Vector<int> row;
+            for (int j = 0; j < 100; j++) row.push_back(j);
+            rows.push_back(std::move(row));
+        }
+    });
+    return 0;
+}
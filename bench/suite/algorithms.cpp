@@ -0,0 +1,77 @@
+// algorithms.cpp - standard algorithms over dsa::Vector and std::vector
+#include "bench.hpp"
+#include "vector.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+using dsa::bench::State;
+using dsa::bench::doNotOptimize;
+
+template <typename Vec>
+Vec shuffled(std::int64_t n){
+    std::mt19937 gen(42);
+    Vec v;
+    v.resize(n);
+    for (std::int64_t i = 0; i < n; i++) {
+        v[i] = static_cast<typename Vec::value_type>(gen());
+    }
+    return v;
+}
+
+template <typename Vec>
+void sort(State& state){
+    const std::int64_t n = state.range(0);
+    const Vec input = shuffled<Vec>(n);
+    Vec v;
+    for (auto _ : state) {
+        state.pauseTiming();
+        v = input;
+        state.resumeTiming();
+        std::sort(v.begin(), v.end());
+        doNotOptimize(v);
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+template <typename Vec>
+void copy(State& state){
+    const std::int64_t n = state.range(0);
+    const Vec input = shuffled<Vec>(n);
+    Vec out;
+    out.resize(n);
+    for (auto _ : state) {
+        std::copy(input.begin(), input.end(), out.begin());
+        doNotOptimize(out);
+    }
+    state.setBytesProcessed(state.iterations() * n * sizeof(typename Vec::value_type));
+}
+
+template <typename Vec>
+void lower_bound(State& state){
+    const std::int64_t n = state.range(0);
+    Vec v = shuffled<Vec>(n);
+    std::sort(v.begin(), v.end());
+    std::mt19937 gen(7);
+    for (auto _ : state) {
+        auto it = std::lower_bound(v.begin(), v.end(), static_cast<typename Vec::value_type>(gen()));
+        doNotOptimize(it);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+} // namespace
+
+DSA_BENCHMARK(sort<dsa::Vector<int>>)->range(1 << 10, 1 << 20);
+DSA_BENCHMARK(sort<std::vector<int>>)->range(1 << 10, 1 << 20);
+DSA_BENCHMARK(sort<dsa::Vector<double>>)->range(1 << 10, 1 << 20);
+DSA_BENCHMARK(sort<std::vector<double>>)->range(1 << 10, 1 << 20);
+DSA_BENCHMARK(copy<dsa::Vector<int>>)->range(1 << 10, 1 << 22);
+DSA_BENCHMARK(copy<std::vector<int>>)->range(1 << 10, 1 << 22);
+DSA_BENCHMARK(copy<dsa::Vector<double>>)->range(1 << 10, 1 << 22);
+DSA_BENCHMARK(copy<std::vector<double>>)->range(1 << 10, 1 << 22);
+DSA_BENCHMARK(lower_bound<dsa::Vector<int>>)->range(1 << 10, 1 << 22);
+DSA_BENCHMARK(lower_bound<std::vector<int>>)->range(1 << 10, 1 << 22);
@@ -0,0 +1,191 @@
+// allocator.cpp - the same Vector/Matrix workloads on the global heap,
+// a MonotonicArena and a PoolResource; heap_calls counts the blocks each
+// setup took from the global heap per iteration (the heap allocator's own
+// calls, arena and pool chunks). Memory the elements allocate themselves,
+// such as std::string buffers, is not counted.
+#include "bench.hpp"
+#include "matrix.hpp"
+#include "monotonic_arena.hpp"
+#include "pool_allocator.hpp"
+#include "vector.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace {
+
+using dsa::bench::State;
+using dsa::bench::doNotOptimize;
+
+// std::allocator that counts its allocate calls into *calls
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+    std::size_t* calls;
+
+    explicit CountingAllocator(std::size_t* c) : calls(c) {}
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>& other) : calls(other.calls) {}
+
+    T* allocate(std::size_t n){
+        ++*calls;
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T* p, std::size_t n){
+        std::allocator<T>().deallocate(p, n);
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const CountingAllocator<T>& a, const CountingAllocator<U>& b){ return a.calls == b.calls; }
+template <typename T, typename U>
+bool operator!=(const CountingAllocator<T>& a, const CountingAllocator<U>& b){ return a.calls != b.calls; }
+
+// where a workload's containers get their memory; endRequest() runs after
+// each request (iteration) once all of its containers are gone;
+// heapCalls() is the number of blocks taken from the global heap so far
+struct Heap {
+    std::size_t calls{0};
+    template <typename T> using allocator = CountingAllocator<T>;
+    template <typename T> allocator<T> make(){ return allocator<T>(&calls); }
+    void endRequest(){}
+    std::size_t heapCalls() const { return calls; }
+};
+
+struct Arena {
+    dsa::MonotonicArena arena;
+    template <typename T> using allocator = dsa::ArenaAllocator<T>;
+    template <typename T> allocator<T> make(){ return allocator<T>(arena); }
+    void endRequest(){ arena.reset(); }  // bulk free, keep the chunk for the next request
+    std::size_t heapCalls() const { return arena.upstreamAllocations(); }
+};
+
+struct Pool {
+    dsa::PoolResource pool;
+    template <typename T> using allocator = dsa::PoolAllocator<T>;
+    template <typename T> allocator<T> make(){ return allocator<T>(pool); }
+    void endRequest(){}
+    std::size_t heapCalls() const { return pool.upstreamAllocations(); }
+};
+
+template <typename S, typename T>
+using VectorOn = dsa::Vector<T, typename S::template allocator<T>>;
+
+template <typename S, typename T>
+using MatrixOn = dsa::BasicMatrix<T, typename S::template allocator<T>>;
+
+// heap_calls per iteration of setup, measured over the timed loop
+template <typename S>
+struct HeapCounter {
+    State& state;
+    const S& setup;
+    std::size_t start;
+    HeapCounter(State& st, const S& s) : state(st), setup(s), start(s.heapCalls()) {}
+    ~HeapCounter(){
+        state.counters["heap_calls"] =
+            static_cast<double>(setup.heapCalls() - start) / static_cast<double>(state.iterations());
+    }
+};
+
+// grow one vector from empty: every doubling is an allocation
+template <typename S>
+void grow(State& state){
+    const std::int64_t n = state.range(0);
+    S setup;
+    HeapCounter<S> count(state, setup);
+    for (auto _ : state) {
+        {
+            VectorOn<S, int> v(setup.template make<int>());
+            for (std::int64_t i = 0; i < n; i++) {
+                v.push_back(static_cast<int>(i));
+            }
+            doNotOptimize(v);
+        }
+        setup.endRequest();
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+// a request: n short-lived vectors of 1..64 elements, all dropped together
+template <typename S>
+void request(State& state){
+    const std::int64_t n = state.range(0);
+    S setup;
+    HeapCounter<S> count(state, setup);
+    for (auto _ : state) {
+        {
+            VectorOn<S, VectorOn<S, int>> all(setup.template make<VectorOn<S, int>>());
+            all.reserve(n);
+            for (std::int64_t k = 0; k < n; k++) {
+                all.emplace_back(setup.template make<int>());
+                for (std::int64_t i = 0; i < 1 + k % 64; i++) {
+                    all.back().push_back(static_cast<int>(i));
+                }
+            }
+            doNotOptimize(all);
+        }
+        setup.endRequest();
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+// vector of strings and a copy of it (the strings own heap blocks of their own)
+template <typename S>
+void strings(State& state){
+    const std::int64_t n = state.range(0);
+    const std::string s(40, 'x');
+    S setup;
+    HeapCounter<S> count(state, setup);
+    for (auto _ : state) {
+        {
+            VectorOn<S, std::string> v(setup.template make<std::string>());
+            for (std::int64_t i = 0; i < n; i++) {
+                v.push_back(s);
+            }
+            VectorOn<S, std::string> copy(v);
+            doNotOptimize(copy);
+        }
+        setup.endRequest();
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+// a request of n small matrix temporaries: c = a + b * 2 on 16x16 doubles
+template <typename S>
+void matrix_temporaries(State& state){
+    const std::int64_t n = state.range(0);
+    S setup;
+    using M = MatrixOn<S, double>;
+    HeapCounter<S> count(state, setup);
+    for (auto _ : state) {
+        {
+            M acc(16, 16, M::kDefaultRowAlign, setup.template make<double>());
+            for (std::int64_t k = 0; k < n; k++) {
+                M a(16, 16, M::kDefaultRowAlign, setup.template make<double>());
+                M b(16, 16, M::kDefaultRowAlign, setup.template make<double>());
+                a(0, 0) = static_cast<double>(k);
+                M c(a + b * 2.0, setup.template make<double>());
+                acc += c;
+            }
+            doNotOptimize(acc);
+        }
+        setup.endRequest();
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+} // namespace
+
+DSA_BENCHMARK(grow<Heap>)->range(1 << 6, 1 << 20);
+DSA_BENCHMARK(grow<Arena>)->range(1 << 6, 1 << 20);
+DSA_BENCHMARK(grow<Pool>)->range(1 << 6, 1 << 20);
+DSA_BENCHMARK(request<Heap>)->range(1 << 6, 1 << 14);
+DSA_BENCHMARK(request<Arena>)->range(1 << 6, 1 << 14);
+DSA_BENCHMARK(request<Pool>)->range(1 << 6, 1 << 14);
+DSA_BENCHMARK(strings<Heap>)->range(1 << 6, 1 << 16);
+DSA_BENCHMARK(strings<Arena>)->range(1 << 6, 1 << 16);
+DSA_BENCHMARK(strings<Pool>)->range(1 << 6, 1 << 16);
+DSA_BENCHMARK(matrix_temporaries<Heap>)->range(1 << 4, 1 << 10);
+DSA_BENCHMARK(matrix_temporaries<Arena>)->range(1 << 4, 1 << 10);
+DSA_BENCHMARK(matrix_temporaries<Pool>)->range(1 << 4, 1 << 10);
@@ -0,0 +1,187 @@
+//bench/suite/bench.hpp
+#pragma once
+
+// Minimal, dependency-free benchmark harness for dsa_bench, shaped like
+// Google Benchmark so results can be diffed by the same tooling:
+//
+//   template <typename Vec>
+//   void push_back(dsa::bench::State& state){
+//       for (auto _ : state) { ... uses state.range(0) ... }
+//       state.setItemsProcessed(state.iterations() * state.range(0));
+//   }
+//   DSA_BENCHMARK(push_back<dsa::Vector<int>>)->range(1 << 10, 1 << 20);
+//
+// Each registered (benchmark, argument) pair is run with a growing
+// iteration count until it takes at least --min_time seconds. Results go
+// to stdout and, with --json=FILE, to a Google-Benchmark-compatible JSON file.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define DSA_BENCH_UNUSED __attribute__((unused))
+#else
+#define DSA_BENCH_UNUSED
+#endif
+
+namespace dsa{
+namespace bench{
+
+using Clock = std::chrono::steady_clock;
+
+// keep value (and what it points to) alive so the optimizer cannot drop the work
+template <typename T>
+inline void doNotOptimize(const T& value){
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+// per-run handle passed to a benchmark body
+class State {
+    std::vector<std::int64_t> args;
+    std::size_t iters;
+    double elapsed{0};             // seconds timed so far
+    Clock::time_point started;
+    bool running{false};
+    std::int64_t items{0};
+    std::int64_t bytes{0};
+
+    void start(){
+        running = true;
+        started = Clock::now();
+    }
+
+    void stop(){
+        if (running) {
+            elapsed += std::chrono::duration<double>(Clock::now() - started).count();
+            running = false;
+        }
+    }
+
+public:
+    // counters reported next to the timing (e.g. allocation counts)
+    std::map<std::string, double> counters;
+
+    State(std::vector<std::int64_t> arguments, std::size_t iterations)
+        : args(std::move(arguments)), iters(iterations) {}
+
+    // i-th argument of this run
+    std::int64_t range(std::size_t i = 0) const { return i < args.size() ? args[i] : 0; }
+    std::size_t iterations() const { return iters; }
+
+    // exclude setup work inside the loop from the timing
+    void pauseTiming(){ stop(); }
+    void resumeTiming(){ start(); }
+
+    void setItemsProcessed(std::int64_t n){ items = n; }
+    void setBytesProcessed(std::int64_t n){ bytes = n; }
+
+    double seconds() const { return elapsed; }
+    std::int64_t itemsProcessed() const { return items; }
+    std::int64_t bytesProcessed() const { return bytes; }
+
+    // what for (auto _ : state) binds _ to; marked unused so the loop
+    // variable does not warn under -Wunused-variable
+    struct DSA_BENCH_UNUSED Value {};
+
+    // for (auto _ : state) runs the body iterations() times, timing the loop
+    struct Iterator {
+        State* state;
+        std::size_t left;
+
+        bool operator!=(const Iterator&) {
+            if (left == 0) {
+                state->stop();
+                return false;
+            }
+            return true;
+        }
+        void operator++(){ left--; }
+        Value operator*() const { return Value(); }
+    };
+
+    Iterator begin(){
+        start();
+        return Iterator{this, iters};
+    }
+
+    Iterator end(){
+        return Iterator{this, 0};
+    }
+};
+
+// a registered benchmark and the argument lists it runs with
+class Benchmark {
+    std::string benchName;
+    std::function<void(State&)> body;
+    std::vector<std::vector<std::int64_t>> argLists;
+
+public:
+    Benchmark(std::string name, std::function<void(State&)> fn)
+        : benchName(std::move(name)), body(std::move(fn)) {}
+
+    Benchmark* arg(std::int64_t a){
+        argLists.push_back({a});
+        return this;
+    }
+
+    Benchmark* args(std::vector<std::int64_t> a){
+        argLists.push_back(std::move(a));
+        return this;
+    }
+
+    // lo, lo*mult, ... up to and including hi
+    Benchmark* range(std::int64_t lo, std::int64_t hi, std::int64_t mult = 8){
+        for (std::int64_t a = lo; a < hi; a *= mult) {
+            arg(a);
+        }
+        return arg(hi);
+    }
+
+    // let fn add argument lists (Google Benchmark's Apply)
+    Benchmark* apply(void (*fn)(Benchmark*)){
+        fn(this);
+        return this;
+    }
+
+    const std::string& name() const { return benchName; }
+    const std::vector<std::vector<std::int64_t>>& argumentLists() const { return argLists; }
+    void run(State& state) const { body(state); }
+};
+
+// all benchmarks, in registration order
+inline std::vector<Benchmark*>& registry(){
+    static std::vector<Benchmark*> all;
+    return all;
+}
+
+inline Benchmark* registerBenchmark(const char* name, std::function<void(State&)> fn){
+    registry().push_back(new Benchmark(name, std::move(fn)));  // lives for the process
+    return registry().back();
+}
+
+// run everything matching the command line; returns the process exit code
+int runAll(int argc, char** argv);
+
+} // namespace bench
+} // namespace dsa
+
+#define DSA_BENCH_CONCAT2(a, b) a##b
+#define DSA_BENCH_CONCAT(a, b) DSA_BENCH_CONCAT2(a, b)
+
+// DSA_BENCHMARK(fn)->arg(...) registers fn under its spelled name;
+// variadic so template arguments with commas pass through; __COUNTER__ keeps
+// several registrations from one macro expansion (same __LINE__) distinct
+#define DSA_BENCHMARK(...) \
+    static ::dsa::bench::Benchmark* DSA_BENCH_CONCAT(dsa_bench_, __COUNTER__) = \
+        ::dsa::bench::registerBenchmark(#__VA_ARGS__, __VA_ARGS__)
@@ -0,0 +1,94 @@
+// concurrent.cpp - multi-producer append throughput: range(0) threads push
+// kItems longs in total into one shared container, ConcurrentVector against
+// a Vector behind a mutex (the old way). Threads are started per iteration,
+// outside the timed region, and released together.
+#include "bench.hpp"
+#include "concurrent_vector.hpp"
+#include "vector.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using dsa::bench::State;
+using dsa::bench::doNotOptimize;
+
+const std::int64_t kItems = 1 << 21;
+
+// run push(t, i) for i in [0, kItems / threads) on each of threads threads,
+// timing from the common start to the last join
+template <typename Push>
+void producers(State& state, Push push){
+    int threads = static_cast<int>(state.range(0));
+    std::int64_t per_thread = kItems / threads;
+    state.pauseTiming();
+    std::atomic<int> ready{0};
+    std::atomic<bool> go{false};
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; t++) {
+        pool.emplace_back([&, t]{
+            ready++;
+            while (!go.load()) {
+                std::this_thread::yield();
+            }
+            for (std::int64_t i = 0; i < per_thread; i++) {
+                push(t, i);
+            }
+        });
+    }
+    while (ready.load() != threads) {
+        std::this_thread::yield();
+    }
+    state.resumeTiming();
+    go = true;
+    for (std::thread& t : pool) {
+        t.join();
+    }
+}
+
+void concurrent_vector_push(State& state){
+    for (auto _ : state) {
+        state.pauseTiming();
+        dsa::ConcurrentVector<std::int64_t> v;
+        state.resumeTiming();
+        producers(state, [&](int t, std::int64_t i){ v.push_back(t + i); });
+        doNotOptimize(v[0]);
+        state.pauseTiming();   // freeing the segments is not appending
+        v.clear();
+        state.resumeTiming();
+    }
+    state.setItemsProcessed(static_cast<std::int64_t>(state.iterations()) * (kItems / state.range(0)) * state.range(0));
+}
+
+void mutex_vector_push(State& state){
+    for (auto _ : state) {
+        state.pauseTiming();
+        dsa::Vector<std::int64_t> v;
+        std::mutex lock;
+        state.resumeTiming();
+        producers(state, [&](int t, std::int64_t i){
+            std::lock_guard<std::mutex> guard(lock);
+            v.push_back(t + i);
+        });
+        doNotOptimize(v);
+        state.pauseTiming();
+        v.clear();
+        v.shrink_to_fit();
+        state.resumeTiming();
+    }
+    state.setItemsProcessed(static_cast<std::int64_t>(state.iterations()) * (kItems / state.range(0)) * state.range(0));
+}
+
+void threadCounts(dsa::bench::Benchmark* b){
+    for (std::int64_t t = 1; t <= 64; t *= 2) {
+        b->arg(t);
+    }
+}
+
+} // namespace
+
+DSA_BENCHMARK(concurrent_vector_push)->apply(threadCounts);
+DSA_BENCHMARK(mutex_vector_push)->apply(threadCounts);
@@ -0,0 +1,144 @@
+// growth.cpp - allocation churn and slack under each Vector GrowthPolicy
+#include "bench.hpp"
+#include "growth_policy.hpp"
+#include "vector.hpp"
+
+#include <memory>
+#include <random>
+
+namespace {
+
+using dsa::bench::State;
+using dsa::bench::doNotOptimize;
+
+std::size_t allocations = 0;
+
+// std::allocator that counts allocate calls
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+    CountingAllocator() = default;
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&) {}
+    T* allocate(std::size_t n){ allocations++; return std::allocator<T>().allocate(n); }
+    void deallocate(T* p, std::size_t n){ std::allocator<T>().deallocate(p, n); }
+    bool operator==(const CountingAllocator&) const { return true; }
+    bool operator!=(const CountingAllocator&) const { return false; }
+};
+
+using Default = dsa::DefaultGrowth;
+using Compact = dsa::CompactGrowth;
+using NoShrink = dsa::NoShrinkGrowth;
+using Lazy = dsa::GeometricGrowth<2, 1, 8>;             // shrink at 1/8 full
+using Capped = dsa::GeometricGrowth<2, 1, 4, 1 << 16>;  // at most 64K elements per step
+
+template <typename Policy>
+using VectorWith = dsa::Vector<int, CountingAllocator<int>, 0, Policy>;
+
+void report(State& state, std::size_t before){
+    state.counters["allocations"] = static_cast<double>(allocations - before) / static_cast<double>(state.iterations());
+}
+
+// bursts: fill to n, drain to empty, 16 times
+template <typename Policy>
+void burst(State& state){
+    const std::int64_t n = state.range(0);
+    std::size_t before = allocations;
+    for (auto _ : state) {
+        VectorWith<Policy> v;
+        for (int round = 0; round < 16; round++) {
+            for (std::int64_t i = 0; i < n; i++) {
+                v.push_back(static_cast<int>(i));
+            }
+            while (!v.empty()) {
+                v.pop_back();
+            }
+        }
+        doNotOptimize(v);
+    }
+    report(state, before);
+    state.setItemsProcessed(state.iterations() * 32 * n);
+}
+
+// size oscillating across the shrink threshold: the worst case for halving
+// at cap/4 and doubling at cap
+template <typename Policy>
+void oscillate(State& state){
+    const std::int64_t n = state.range(0);
+    std::size_t before = allocations;
+    for (auto _ : state) {
+        VectorWith<Policy> v;
+        v.resize(n);
+        v.shrink_to_fit();
+        for (std::int64_t i = 0; i < n - n / 4; i++) {
+            v.pop_back();
+        }
+        for (int round = 0; round < 64; round++) {
+            for (std::int64_t i = 0; i < n / 4 + 1; i++) {
+                v.push_back(static_cast<int>(i));
+            }
+            for (std::int64_t i = 0; i < n / 4 + 1; i++) {
+                v.pop_back();
+            }
+        }
+        doNotOptimize(v);
+    }
+    report(state, before);
+    state.setItemsProcessed(state.iterations() * 128 * (n / 4 + 1));
+}
+
+// random walk of the size around n/2
+template <typename Policy>
+void random_walk(State& state){
+    const std::int64_t n = state.range(0);
+    std::size_t before = allocations;
+    for (auto _ : state) {
+        std::mt19937 gen(1);
+        VectorWith<Policy> v;
+        v.resize(n / 2);
+        for (std::int64_t step = 0; step < 8 * n; step++) {
+            bool up = v.size() < static_cast<std::size_t>(n / 8) || (gen() & 1);
+            if (up) {
+                v.push_back(0);
+            } else {
+                v.pop_back();
+            }
+        }
+        doNotOptimize(v);
+    }
+    report(state, before);
+    state.setItemsProcessed(state.iterations() * 8 * n);
+}
+
+// grow to n once; slack = capacity / size at the end
+template <typename Policy>
+void grow_to(State& state){
+    const std::int64_t n = state.range(0);
+    std::size_t before = allocations;
+    double slack = 0;
+    for (auto _ : state) {
+        VectorWith<Policy> v;
+        for (std::int64_t i = 0; i < n; i++) {
+            v.push_back(static_cast<int>(i));
+        }
+        slack = static_cast<double>(v.capacity()) / static_cast<double>(v.size());
+        doNotOptimize(v);
+    }
+    report(state, before);
+    state.counters["slack"] = slack;
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+} // namespace
+
+#define DSA_GROWTH_BENCHMARKS(P)                                   \
+    DSA_BENCHMARK(burst<P>)->range(1 << 10, 1 << 16);              \
+    DSA_BENCHMARK(oscillate<P>)->range(1 << 10, 1 << 16);          \
+    DSA_BENCHMARK(random_walk<P>)->range(1 << 10, 1 << 16);        \
+    DSA_BENCHMARK(grow_to<P>)->arg(1000000)->arg(5000000)
+
+DSA_GROWTH_BENCHMARKS(Default);
+DSA_GROWTH_BENCHMARKS(Compact);
+DSA_GROWTH_BENCHMARKS(NoShrink);
+DSA_GROWTH_BENCHMARKS(Lazy);
+DSA_GROWTH_BENCHMARKS(Capped);
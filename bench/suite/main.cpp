@@ -0,0 +1,230 @@
+// main.cpp - dsa_bench driver
+//
+// usage: dsa_bench [--filter=REGEX] [--min_time=SECONDS] [--json=FILE] [--list]
+#include "bench.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace dsa{
+namespace bench{
+
+namespace {
+
+struct Result {
+    std::string name;
+    std::size_t iterations;
+    double ns_per_iter;
+    double items_per_second;
+    double bytes_per_second;
+    std::map<std::string, double> counters;
+};
+
+std::string escape(const std::string& s){
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+        }
+        out += c;
+    }
+    return out;
+}
+
+std::string runName(const Benchmark& b, const std::vector<std::int64_t>& args){
+    std::ostringstream name;
+    name << b.name();
+    for (std::int64_t a : args) {
+        name << '/' << a;
+    }
+    return name.str();
+}
+
+// grow the iteration count until one batch takes min_time
+Result measure(const Benchmark& b, const std::vector<std::int64_t>& args, double min_time){
+    std::size_t iters = 1;
+    for (;;) {
+        State state(args, iters);
+        b.run(state);
+        double t = state.seconds();
+        if (t >= min_time || iters >= 1000000000) {
+            Result r;
+            r.name = runName(b, args);
+            r.iterations = iters;
+            r.ns_per_iter = t * 1e9 / iters;
+            r.items_per_second = state.itemsProcessed() > 0 ? state.itemsProcessed() / t : 0;
+            r.bytes_per_second = state.bytesProcessed() > 0 ? state.bytesProcessed() / t : 0;
+            r.counters = state.counters;
+            return r;
+        }
+        // aim 40% past min_time, grow at most 10x per step
+        double scale = t > 0 ? 1.4 * min_time / t : 10.0;
+        std::size_t next = static_cast<std::size_t>(iters * std::min(10.0, std::max(scale, 1.5)));
+        iters = std::max(next, iters + 1);
+    }
+}
+
+void printResult(const Result& r){
+    std::printf("%-60s %14.1f ns %12zu", r.name.c_str(), r.ns_per_iter, r.iterations);
+    if (r.items_per_second > 0) {
+        std::printf("  items/s=%.4g", r.items_per_second);
+    }
+    if (r.bytes_per_second > 0) {
+        std::printf("  bytes/s=%.4g", r.bytes_per_second);
+    }
+    for (const auto& c : r.counters) {
+        std::printf("  %s=%.6g", c.first.c_str(), c.second);
+    }
+    std::printf("\n");
+}
+
+// JSON has no NaN or infinity: those are written as null
+struct JsonNumber {
+    double value;
+};
+
+std::ostream& operator<<(std::ostream& out, JsonNumber n){
+    if (!std::isfinite(n.value)) {
+        return out << "null";
+    }
+    return out << n.value;
+}
+
+void writeJson(std::ostream& out, const std::vector<Result>& results){
+    char date[64];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    out << "{\n  \"context\": {\n"
+        << "    \"date\": \"" << date << "\",\n"
+        << "    \"executable\": \"dsa_bench\",\n"
+        << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+#ifdef NDEBUG
+        << "    \"library_build_type\": \"release\"\n"
+#else
+        << "    \"library_build_type\": \"debug\"\n"
+#endif
+        << "  },\n  \"benchmarks\": [\n";
+    for (std::size_t k = 0; k < results.size(); k++) {
+        const Result& r = results[k];
+        out << "    {\n"
+            << "      \"name\": \"" << escape(r.name) << "\",\n"
+            << "      \"run_type\": \"iteration\",\n"
+            << "      \"iterations\": " << r.iterations << ",\n"
+            << "      \"real_time\": " << JsonNumber{r.ns_per_iter} << ",\n"
+            << "      \"cpu_time\": " << JsonNumber{r.ns_per_iter} << ",\n"
+            << "      \"time_unit\": \"ns\"";
+        if (r.items_per_second > 0) {
+            out << ",\n      \"items_per_second\": " << JsonNumber{r.items_per_second};
+        }
+        if (r.bytes_per_second > 0) {
+            out << ",\n      \"bytes_per_second\": " << JsonNumber{r.bytes_per_second};
+        }
+        for (const auto& c : r.counters) {
+            out << ",\n      \"" << escape(c.first) << "\": " << JsonNumber{c.second};
+        }
+        out << "\n    }" << (k + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+int usage(const char* argv0){
+    std::fprintf(stderr, "usage: %s [--filter=REGEX] [--min_time=SECONDS] [--json=FILE] [--list]\n", argv0);
+    return 2;
+}
+
+const char* flagValue(const char* arg, const char* flag){
+    std::size_t len = std::strlen(flag);
+    return std::strncmp(arg, flag, len) == 0 ? arg + len : nullptr;
+}
+
+} // namespace
+
+int runAll(int argc, char** argv){
+    std::string filter = ".*";
+    std::string json;
+    double min_time = 0.2;
+    bool list = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (const char* v = flagValue(argv[i], "--filter=")) {
+            filter = v;
+        } else if (const char* v = flagValue(argv[i], "--min_time=")) {
+            min_time = std::atof(v);
+        } else if (const char* v = flagValue(argv[i], "--json=")) {
+            json = v;
+        } else if (std::strcmp(argv[i], "--list") == 0) {
+            list = true;
+        } else {
+            return usage(argv[0]);
+        }
+    }
+
+    std::regex pattern;
+    try {
+        pattern.assign(filter);
+    } catch (const std::regex_error& e) {
+        std::fprintf(stderr, "dsa_bench: bad --filter regex: %s\n", e.what());
+        return usage(argv[0]);
+    }
+
+    // open the report up front so a bad path fails before the runs, not after
+    std::ofstream json_out;
+    if (!json.empty()) {
+        json_out.open(json);
+        if (!json_out) {
+            std::fprintf(stderr, "dsa_bench: cannot open %s for writing\n", json.c_str());
+            return 1;
+        }
+    }
+
+    std::vector<Result> results;
+    if (!list) {
+        std::printf("%-60s %17s %12s\n", "benchmark", "time/iter", "iterations");
+    }
+    for (const Benchmark* b : registry()) {
+        std::vector<std::vector<std::int64_t>> argLists = b->argumentLists();
+        if (argLists.empty()) {
+            argLists.push_back({});
+        }
+        for (const auto& args : argLists) {
+            std::string name = runName(*b, args);
+            if (!std::regex_search(name, pattern)) {
+                continue;
+            }
+            if (list) {
+                std::printf("%s\n", name.c_str());
+                continue;
+            }
+            results.push_back(measure(*b, args, min_time));
+            printResult(results.back());
+            std::fflush(stdout);
+        }
+    }
+
+    if (!json.empty()) {
+        writeJson(json_out, results);
+        json_out.flush();
+        if (!json_out) {
+            std::fprintf(stderr, "dsa_bench: failed writing %s\n", json.c_str());
+            return 1;
+        }
+    }
+    return 0;
+}
+
+} // namespace bench
+} // namespace dsa
+
+int main(int argc, char** argv){
+    return dsa::bench::runAll(argc, argv);
+}
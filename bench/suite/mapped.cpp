@@ -0,0 +1,110 @@
+// mapped.cpp - startup cost of a persisted dataset: reopening a
+// MappedVector file vs reading the same records and push_back-ing them
+// into a Vector. The files live on tmpfs (/dev/shm) when there is one, so
+// this measures the CPU side (page-cache hits), not the disk.
+#include "bench.hpp"
+#include "mapped_vector.hpp"
+#include "vector.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+using dsa::bench::State;
+using dsa::bench::doNotOptimize;
+
+struct Record {
+    std::uint64_t id;
+    double value;
+    std::uint32_t flags;
+    float weight;
+};
+
+// one MappedVector file per record count, written on first use and
+// removed at exit
+class Datasets {
+    std::map<std::int64_t, std::string> files;
+
+public:
+    ~Datasets(){
+        for (const auto& f : files) {
+            std::remove(f.second.c_str());
+        }
+    }
+
+    const std::string& get(std::int64_t n){
+        auto it = files.find(n);
+        if (it != files.end()) {
+            return it->second;
+        }
+        struct stat st;
+        std::string dir = ::stat("/dev/shm", &st) == 0 ? "/dev/shm" : "/tmp";
+        std::string path = dir + "/dsa_bench_" + std::to_string(::getpid()) + "_" + std::to_string(n);
+        std::remove(path.c_str());
+        {
+            dsa::MappedVector<Record> v(path);
+            v.reserve(static_cast<std::size_t>(n));
+            for (std::int64_t i = 0; i < n; i++) {
+                v.push_back(Record{static_cast<std::uint64_t>(i), i * 0.25, static_cast<std::uint32_t>(i & 7), 1.0f});
+            }
+        }
+        return files[n] = path;
+    }
+};
+
+Datasets datasets;
+
+// read the records with stdio and push_back each one
+void startup_read_push_back(State& state){
+    const std::string& path = datasets.get(state.range(0));
+    for (auto _ : state) {
+        std::FILE* f = std::fopen(path.c_str(), "rb");
+        std::fseek(f, 64, SEEK_SET);    // skip the MappedVector header
+        dsa::Vector<Record> v;
+        Record buf[1024];
+        std::size_t got;
+        while ((got = std::fread(buf, sizeof(Record), 1024, f)) > 0) {
+            for (std::size_t k = 0; k < got; k++) {
+                v.push_back(buf[k]);
+            }
+        }
+        std::fclose(f);
+        doNotOptimize(v);
+    }
+    state.setItemsProcessed(state.iterations() * state.range(0));
+}
+
+// map the file: ready to use without touching the records
+void startup_mapped_open(State& state){
+    const std::string& path = datasets.get(state.range(0));
+    for (auto _ : state) {
+        dsa::MappedVector<Record> v(path);
+        doNotOptimize(v.size());
+    }
+    state.setItemsProcessed(state.iterations() * state.range(0));
+}
+
+// map the file and read every record once (pages faulted in)
+void startup_mapped_open_scan(State& state){
+    const std::string& path = datasets.get(state.range(0));
+    for (auto _ : state) {
+        dsa::MappedVector<Record> v(path);
+        double sum = 0;
+        for (const Record& r : v) {
+            sum += r.value;
+        }
+        doNotOptimize(sum);
+    }
+    state.setItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+DSA_BENCHMARK(startup_read_push_back)->arg(1 << 16)->arg(1 << 20)->arg(1 << 22);
+DSA_BENCHMARK(startup_mapped_open)->arg(1 << 16)->arg(1 << 20)->arg(1 << 22);
+DSA_BENCHMARK(startup_mapped_open_scan)->arg(1 << 16)->arg(1 << 20)->arg(1 << 22);
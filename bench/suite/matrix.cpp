@@ -0,0 +1,151 @@
+// matrix.cpp - BasicMatrix construction, operator+, fused sums and products
+//
+// construct_* by size (up to 10000 x 10000): the zeroing constructor is one
+// calloc, so its pages are faulted in on first write; construct_touch
+// includes that cost. construct_nested is the old layout, rows built with
+// push_back and copied into a Vector of rows, for reference.
+#include "bench.hpp"
+#include "matrix.hpp"
+
+#include <vector>
+
+namespace {
+
+using dsa::bench::State;
+using dsa::bench::doNotOptimize;
+
+template <typename T>
+dsa::BasicMatrix<T> filled(std::int64_t n){
+    dsa::BasicMatrix<T> m(n, n);
+    for (std::int64_t i = 0; i < n; i++) {
+        T* r = m.row(i);
+        for (std::int64_t j = 0; j < n; j++) {
+            r[j] = static_cast<T>((i + j) % 7);
+        }
+    }
+    return m;
+}
+
+template <typename T>
+void construct(State& state){
+    const std::int64_t n = state.range(0);
+    for (auto _ : state) {
+        dsa::BasicMatrix<T> m(n, n);
+        doNotOptimize(m);
+    }
+    state.setBytesProcessed(state.iterations() * n * n * sizeof(T));
+}
+
+// a + b into a new matrix
+template <typename T>
+void add(State& state){
+    const std::int64_t n = state.range(0);
+    dsa::BasicMatrix<T> a = filled<T>(n), b = filled<T>(n);
+    for (auto _ : state) {
+        dsa::BasicMatrix<T> c = a + b;
+        doNotOptimize(c);
+    }
+    state.setItemsProcessed(state.iterations() * n * n);
+    state.setBytesProcessed(state.iterations() * 3 * n * n * sizeof(T));
+}
+
+// a + b + c + d, fused into one pass
+template <typename T>
+void add4(State& state){
+    const std::int64_t n = state.range(0);
+    dsa::BasicMatrix<T> a = filled<T>(n), b = filled<T>(n), c = filled<T>(n), d = filled<T>(n);
+    for (auto _ : state) {
+        dsa::BasicMatrix<T> r = a + b + c + d;
+        doNotOptimize(r);
+    }
+    state.setItemsProcessed(state.iterations() * n * n);
+    state.setBytesProcessed(state.iterations() * 5 * n * n * sizeof(T));
+}
+
+// a * b on the global thread pool; items are flops
+template <typename T>
+void multiply(State& state){
+    const std::int64_t n = state.range(0);
+    dsa::BasicMatrix<T> a = filled<T>(n), b = filled<T>(n);
+    for (auto _ : state) {
+        dsa::BasicMatrix<T> c = a * b;
+        doNotOptimize(c);
+    }
+    state.setItemsProcessed(state.iterations() * 2 * n * n * n);
+}
+
+// zero matrix, then every element written once (pays the page faults)
+template <typename T>
+void construct_touch(State& state){
+    const std::int64_t n = state.range(0);
+    for (auto _ : state) {
+        dsa::BasicMatrix<T> m(n, n);
+        for (std::int64_t i = 0; i < n; i++) {
+            std::fill(m.row(i), m.row(i) + n, T(1));
+        }
+        doNotOptimize(m);
+    }
+    state.setBytesProcessed(state.iterations() * n * n * sizeof(T));
+}
+
+template <typename T>
+void construct_filled(State& state){
+    const std::int64_t n = state.range(0);
+    for (auto _ : state) {
+        dsa::BasicMatrix<T> m = dsa::BasicMatrix<T>::filled(n, n, T(1));
+        doNotOptimize(m);
+    }
+    state.setBytesProcessed(state.iterations() * n * n * sizeof(T));
+}
+
+// packed copy out of a caller's row-major buffer
+template <typename T>
+void construct_from_buffer(State& state){
+    const std::int64_t n = state.range(0);
+    std::vector<T> src(static_cast<std::size_t>(n * n), T(1));
+    for (auto _ : state) {
+        dsa::BasicMatrix<T> m = dsa::BasicMatrix<T>::fromBuffer(n, n, src.data(), 0, 0);
+        doNotOptimize(m);
+    }
+    state.setBytesProcessed(state.iterations() * n * n * sizeof(T));
+}
+
+void construct_nested(State& state){
+    const std::int64_t n = state.range(0);
+    for (auto _ : state) {
+        dsa::Vector<dsa::Vector<int>> rows;
+        for (std::int64_t i = 0; i < n; i++) {
+            dsa::Vector<int> row;
+            for (std::int64_t j = 0; j < n; j++) {
+                row.push_back(0);
+            }
+            rows.push_back(row);
+        }
+        doNotOptimize(rows);
+    }
+    state.setBytesProcessed(state.iterations() * n * n * static_cast<std::int64_t>(sizeof(int)));
+}
+
+void constructionSizes(dsa::bench::Benchmark* b){
+    for (std::int64_t n : {256, 1024, 4096, 10000}) {
+        b->arg(n);
+    }
+}
+
+} // namespace
+
+DSA_BENCHMARK(construct<int>)->arg(4096)->arg(10000);   // beyond the common range below
+DSA_BENCHMARK(construct_touch<int>)->apply(constructionSizes);
+DSA_BENCHMARK(construct_filled<int>)->apply(constructionSizes);
+DSA_BENCHMARK(construct_from_buffer<int>)->apply(constructionSizes);
+DSA_BENCHMARK(construct_nested)->apply(constructionSizes);
+
+#define DSA_MATRIX_BENCHMARKS(T)                                   \
+    DSA_BENCHMARK(construct<T>)->range(64, 2048, 4);               \
+    DSA_BENCHMARK(add<T>)->range(64, 2048, 4);                     \
+    DSA_BENCHMARK(add4<T>)->range(64, 2048, 4);                    \
+    DSA_BENCHMARK(multiply<T>)->range(64, 1024, 4)
+
+DSA_MATRIX_BENCHMARKS(int);
+DSA_MATRIX_BENCHMARKS(float);
+DSA_MATRIX_BENCHMARKS(double);
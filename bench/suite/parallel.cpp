@@ -0,0 +1,150 @@
+// parallel.cpp - scaling of dsa::parallel over 1..N threads: args are
+// {elements, threads}; threads = 1 is a pool without workers (the caller
+// alone), and the serial_* rows are the plain serial algorithms for reference
+#include "bench.hpp"
+#include "parallel.hpp"
+#include "vector.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <thread>
+
+namespace {
+
+using dsa::bench::State;
+using dsa::bench::doNotOptimize;
+
+// one pool per thread count, kept for the whole run
+dsa::ThreadPool& poolWith(std::int64_t threads){
+    static std::map<std::int64_t, std::unique_ptr<dsa::ThreadPool>> pools;
+    std::unique_ptr<dsa::ThreadPool>& p = pools[threads];
+    if (!p) {
+        p.reset(new dsa::ThreadPool(static_cast<std::size_t>(threads > 1 ? threads - 1 : 0)));
+    }
+    return *p;
+}
+
+dsa::Vector<double> randomDoubles(std::int64_t n){
+    std::mt19937_64 gen(42);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    dsa::Vector<double> v;
+    v.reserve(static_cast<std::size_t>(n));
+    for (std::int64_t i = 0; i < n; i++) {
+        v.push_back(dist(gen));
+    }
+    return v;
+}
+
+void done(State& state){
+    state.setItemsProcessed(state.iterations() * state.range(0));
+    state.setBytesProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(sizeof(double)));
+}
+
+void parallel_for_each(State& state){
+    dsa::Vector<double> v = randomDoubles(state.range(0));
+    dsa::ThreadPool& pool = poolWith(state.range(1));
+    for (auto _ : state) {
+        dsa::parallel::for_each(v.begin(), v.end(), [](double& x){ x = x * 0.999 + 0.001; }, pool);
+    }
+    doNotOptimize(v);
+    done(state);
+}
+
+void parallel_transform(State& state){
+    dsa::Vector<double> v = randomDoubles(state.range(0));
+    dsa::Vector<double> out;
+    out.resize(v.size());
+    dsa::ThreadPool& pool = poolWith(state.range(1));
+    for (auto _ : state) {
+        dsa::parallel::transform(v.begin(), v.end(), out.begin(), [](double x){ return x * x + 1.0; }, pool);
+        doNotOptimize(out);
+    }
+    done(state);
+}
+
+template <dsa::parallel::Reduction Mode>
+void parallel_reduce(State& state){
+    dsa::Vector<double> v = randomDoubles(state.range(0));
+    dsa::ThreadPool& pool = poolWith(state.range(1));
+    for (auto _ : state) {
+        double s = dsa::parallel::reduce(v.begin(), v.end(), 0.0, std::plus<>(), Mode, pool);
+        doNotOptimize(s);
+    }
+    done(state);
+}
+
+void parallel_inclusive_scan(State& state){
+    dsa::Vector<double> v = randomDoubles(state.range(0));
+    dsa::Vector<double> out;
+    out.resize(v.size());
+    dsa::ThreadPool& pool = poolWith(state.range(1));
+    for (auto _ : state) {
+        dsa::parallel::inclusive_scan(v.begin(), v.end(), out.begin(), std::plus<>(), pool);
+        doNotOptimize(out);
+    }
+    done(state);
+}
+
+void parallel_sort(State& state){
+    dsa::Vector<double> input = randomDoubles(state.range(0));
+    dsa::ThreadPool& pool = poolWith(state.range(1));
+    for (auto _ : state) {
+        state.pauseTiming();
+        dsa::Vector<double> v(input);
+        state.resumeTiming();
+        dsa::parallel::sort(v.begin(), v.end(), std::less<>(), pool);
+        doNotOptimize(v);
+    }
+    done(state);
+}
+
+void serial_reduce(State& state){
+    dsa::Vector<double> v = randomDoubles(state.range(0));
+    for (auto _ : state) {
+        double s = std::accumulate(v.begin(), v.end(), 0.0);
+        doNotOptimize(s);
+    }
+    done(state);
+}
+
+void serial_sort(State& state){
+    dsa::Vector<double> input = randomDoubles(state.range(0));
+    for (auto _ : state) {
+        state.pauseTiming();
+        dsa::Vector<double> v(input);
+        state.resumeTiming();
+        std::sort(v.begin(), v.end());
+        doNotOptimize(v);
+    }
+    done(state);
+}
+
+const std::int64_t kLarge = 1 << 24;   // 16M doubles, 128 MiB
+const std::int64_t kSort = 1 << 22;
+
+// {n, 1}, {n, 2}, {n, 4}, ... up to the hardware threads (at least 4)
+void scaling(dsa::bench::Benchmark* b, std::int64_t n){
+    std::int64_t hw = std::max<std::int64_t>(4, std::thread::hardware_concurrency());
+    for (std::int64_t t = 1; t < hw; t *= 2) {
+        b->args({n, t});
+    }
+    b->args({n, hw});
+}
+
+void scalingLarge(dsa::bench::Benchmark* b){ scaling(b, kLarge); }
+void scalingSort(dsa::bench::Benchmark* b){ scaling(b, kSort); }
+
+} // namespace
+
+DSA_BENCHMARK(parallel_for_each)->apply(scalingLarge);
+DSA_BENCHMARK(parallel_transform)->apply(scalingLarge);
+DSA_BENCHMARK(parallel_reduce<dsa::parallel::Reduction::fast>)->apply(scalingLarge);
+DSA_BENCHMARK(parallel_reduce<dsa::parallel::Reduction::deterministic>)->apply(scalingLarge);
+DSA_BENCHMARK(parallel_inclusive_scan)->apply(scalingLarge);
+DSA_BENCHMARK(parallel_sort)->apply(scalingSort);
+DSA_BENCHMARK(serial_reduce)->arg(kLarge);
+DSA_BENCHMARK(serial_sort)->arg(kSort);
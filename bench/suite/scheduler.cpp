@@ -0,0 +1,141 @@
+// scheduler.cpp - ThreadPool overheads: the cost of spawning a task
+// (parallel_for with grain 1, and submit) as ns_per_task, and how evenly
+// fork/join with stealing spreads irregular work. args are {tasks, threads}
+// for spawning and {threads, grain} for irregular work; threads = 1 is a
+// pool without workers.
+//
+// efficiency = time spent in task bodies / (wall time * threads): 1.0 is a
+// perfect balance, lower means threads sat idle or paid for scheduling
+#include "bench.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <thread>
+
+namespace {
+
+using dsa::bench::State;
+using dsa::bench::doNotOptimize;
+using Clock = std::chrono::steady_clock;
+
+// one pool per thread count, kept for the whole run
+dsa::ThreadPool& poolWith(std::int64_t threads){
+    static std::map<std::int64_t, std::unique_ptr<dsa::ThreadPool>> pools;
+    std::unique_ptr<dsa::ThreadPool>& p = pools[threads];
+    if (!p) {
+        p.reset(new dsa::ThreadPool(static_cast<std::size_t>(threads > 1 ? threads - 1 : 0)));
+    }
+    return *p;
+}
+
+std::int64_t nanoseconds(Clock::duration d){
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+}
+
+void perTask(State& state, std::int64_t wall_ns, std::int64_t tasks){
+    state.setItemsProcessed(static_cast<std::int64_t>(state.iterations()) * tasks);
+    state.counters["ns_per_task"] = static_cast<double>(wall_ns) /
+                                    static_cast<double>(static_cast<std::int64_t>(state.iterations()) * tasks);
+}
+
+// fork/join down to single indices, empty bodies
+void spawn_parallel_for(State& state){
+    dsa::ThreadPool& pool = poolWith(state.range(1));
+    std::size_t tasks = static_cast<std::size_t>(state.range(0));
+    std::atomic<std::size_t> ran{0};
+    Clock::time_point start = Clock::now();
+    for (auto _ : state) {
+        pool.parallel_for(0, tasks, 1, [&](std::size_t){ ran.fetch_add(1, std::memory_order_relaxed); });
+    }
+    perTask(state, nanoseconds(Clock::now() - start), state.range(0));
+    doNotOptimize(ran);
+}
+
+// independent tasks from outside the pool, waited for by polling a counter
+void spawn_submit(State& state){
+    dsa::ThreadPool& pool = poolWith(state.range(1));
+    std::size_t tasks = static_cast<std::size_t>(state.range(0));
+    std::atomic<std::size_t> ran{0};
+    Clock::time_point start = Clock::now();
+    for (auto _ : state) {
+        ran = 0;
+        for (std::size_t t = 0; t < tasks; t++) {
+            pool.submit([&]{ ran.fetch_add(1, std::memory_order_relaxed); });
+        }
+        while (ran.load() != tasks) {
+            std::this_thread::yield();
+        }
+    }
+    perTask(state, nanoseconds(Clock::now() - start), state.range(0));
+}
+
+// work of item i: most items are light, every 32nd is 64 times heavier and
+// the heavy ones cluster in the first quarter, so equal index ranges are
+// far from equal work
+std::size_t costOf(std::size_t i, std::size_t n){
+    std::size_t heavy = i < n / 4 && i % 8 == 0 ? 64 : (i % 32 == 0 ? 64 : 1);
+    return heavy * 2000;
+}
+
+double spin(std::size_t steps){
+    double x = 1.0;
+    for (std::size_t s = 0; s < steps; s++) {
+        x = x * 1.0000001 + 1e-9;
+    }
+    return x;
+}
+
+void irregular_work(State& state){
+    const std::size_t n = 2048;
+    dsa::ThreadPool& pool = poolWith(state.range(0));
+    std::size_t grain = static_cast<std::size_t>(state.range(1));
+    std::atomic<std::int64_t> busy{0};
+    double sink = 0;
+    std::int64_t wall = 0;
+    for (auto _ : state) {
+        Clock::time_point start = Clock::now();
+        pool.parallel_for(0, n, grain, [&](std::size_t i){
+            Clock::time_point t0 = Clock::now();
+            double x = spin(costOf(i, n));
+            busy.fetch_add(nanoseconds(Clock::now() - t0), std::memory_order_relaxed);
+            if (x < 0) {
+                sink += x;   // never true; keeps spin alive
+            }
+        });
+        wall += nanoseconds(Clock::now() - start);
+    }
+    doNotOptimize(sink);
+    state.setItemsProcessed(static_cast<std::int64_t>(state.iterations() * n));
+    state.counters["efficiency"] = static_cast<double>(busy.load()) /
+                                   (static_cast<double>(wall) * static_cast<double>(pool.concurrency()));
+}
+
+std::int64_t hardwareThreads(){
+    return std::max<std::int64_t>(4, std::thread::hardware_concurrency());
+}
+
+void spawnArgs(dsa::bench::Benchmark* b){
+    for (std::int64_t tasks : {1000, 100000}) {
+        b->args({tasks, 1});
+        b->args({tasks, hardwareThreads()});
+    }
+}
+
+// grain 1 and 0 (the pool's default) against one static slice per thread
+void irregularArgs(dsa::bench::Benchmark* b){
+    std::int64_t hw = hardwareThreads();
+    for (std::int64_t grain : {std::int64_t{1}, std::int64_t{0}, 2048 / hw}) {
+        b->args({hw, grain});
+    }
+    b->args({1, 0});
+}
+
+} // namespace
+
+DSA_BENCHMARK(spawn_parallel_for)->apply(spawnArgs);
+DSA_BENCHMARK(spawn_submit)->apply(spawnArgs);
+DSA_BENCHMARK(irregular_work)->apply(irregularArgs);
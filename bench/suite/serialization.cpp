@@ -0,0 +1,179 @@
+// serialization.cpp - save/load throughput of a square double matrix of
+// range(0) MiB: the binary format (saveFile/loadFile, MappedArray) against
+// a text round-trip through iostreams. Files go to /tmp.
+#include "bench.hpp"
+#include "serialization.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <unistd.h>
+
+namespace {
+
+using dsa::bench::State;
+using dsa::bench::doNotOptimize;
+using Mat = dsa::BasicMatrix<double>;
+
+std::ptrdiff_t sideFor(std::int64_t mib){
+    return static_cast<std::ptrdiff_t>(std::sqrt(static_cast<double>(mib) * 1024 * 1024 / sizeof(double)));
+}
+
+std::string pathFor(const char* what, std::int64_t mib){
+    return "/tmp/dsa_bench_" + std::to_string(::getpid()) + "_" + what + "_" + std::to_string(mib);
+}
+
+// one filled matrix per size, plus its binary and text files, kept for
+// the whole run and removed at exit
+class Inputs {
+    std::map<std::int64_t, std::unique_ptr<Mat>> matrices;
+    std::map<std::int64_t, std::string> binary;
+    std::map<std::int64_t, std::string> text;
+
+public:
+    ~Inputs(){
+        for (const auto& f : binary) {
+            std::remove(f.second.c_str());
+        }
+        for (const auto& f : text) {
+            std::remove(f.second.c_str());
+        }
+    }
+
+    const Mat& matrix(std::int64_t mib){
+        std::unique_ptr<Mat>& m = matrices[mib];
+        if (!m) {
+            std::ptrdiff_t n = sideFor(mib);
+            m.reset(new Mat(n, n, 0));
+            for (std::ptrdiff_t i = 0; i < n; i++) {
+                double* r = m->row(static_cast<std::size_t>(i));
+                for (std::ptrdiff_t j = 0; j < n; j++) {
+                    r[j] = static_cast<double>(i) * 0.001 + static_cast<double>(j) / 3.0;
+                }
+            }
+        }
+        return *m;
+    }
+
+    const std::string& binaryFile(std::int64_t mib){
+        auto it = binary.find(mib);
+        if (it == binary.end()) {
+            std::string path = pathFor("bin", mib);
+            dsa::saveFile(path, matrix(mib));
+            it = binary.emplace(mib, path).first;
+        }
+        return it->second;
+    }
+
+    const std::string& textFile(std::int64_t mib);
+};
+
+// rows, cols, then the elements, whitespace separated, round-trip precision
+void saveText(const Mat& m, const std::string& path){
+    std::ofstream out(path);
+    out.precision(17);
+    out << m.getRows() << ' ' << m.getCols() << '\n';
+    for (std::size_t i = 0; i < m.getRows(); i++) {
+        for (std::size_t j = 0; j < m.getCols(); j++) {
+            out << m(i, j) << ' ';
+        }
+        out << '\n';
+    }
+}
+
+Mat loadText(const std::string& path){
+    std::ifstream in(path);
+    std::ptrdiff_t rows = 0, cols = 0;
+    in >> rows >> cols;
+    Mat m(rows, cols);
+    for (std::size_t i = 0; i < m.getRows(); i++) {
+        for (std::size_t j = 0; j < m.getCols(); j++) {
+            in >> m(i, j);
+        }
+    }
+    return m;
+}
+
+const std::string& Inputs::textFile(std::int64_t mib){
+    auto it = text.find(mib);
+    if (it == text.end()) {
+        std::string path = pathFor("txt", mib);
+        saveText(matrix(mib), path);
+        it = text.emplace(mib, path).first;
+    }
+    return it->second;
+}
+
+Inputs inputs;
+
+void bytesDone(State& state){
+    std::ptrdiff_t n = sideFor(state.range(0));
+    state.setBytesProcessed(static_cast<std::int64_t>(state.iterations()) * n * n *
+                            static_cast<std::int64_t>(sizeof(double)));
+}
+
+void save_binary(State& state){
+    const Mat& m = inputs.matrix(state.range(0));
+    std::string path = pathFor("save", state.range(0));
+    for (auto _ : state) {
+        dsa::saveFile(path, m);
+    }
+    std::remove(path.c_str());
+    bytesDone(state);
+}
+
+void load_binary(State& state){
+    const std::string& path = inputs.binaryFile(state.range(0));
+    for (auto _ : state) {
+        Mat m(0, 0);
+        dsa::loadFile(path, m);
+        doNotOptimize(m);
+    }
+    bytesDone(state);
+}
+
+// map, verify the checksum and read every element once
+void map_binary(State& state){
+    const std::string& path = inputs.binaryFile(state.range(0));
+    for (auto _ : state) {
+        dsa::MappedArray<double> view(path);
+        bool ok = view.verify();
+        double sum = 0;
+        for (double x : view) {
+            sum += x;
+        }
+        doNotOptimize(ok);
+        doNotOptimize(sum);
+    }
+    bytesDone(state);
+}
+
+void save_text(State& state){
+    const Mat& m = inputs.matrix(state.range(0));
+    std::string path = pathFor("savetxt", state.range(0));
+    for (auto _ : state) {
+        saveText(m, path);
+    }
+    std::remove(path.c_str());
+    bytesDone(state);
+}
+
+void load_text(State& state){
+    const std::string& path = inputs.textFile(state.range(0));
+    for (auto _ : state) {
+        Mat m = loadText(path);
+        doNotOptimize(m);
+    }
+    bytesDone(state);
+}
+
+} // namespace
+
+DSA_BENCHMARK(save_binary)->arg(64)->arg(1024);
+DSA_BENCHMARK(load_binary)->arg(64)->arg(1024);
+DSA_BENCHMARK(map_binary)->arg(64)->arg(1024);
+DSA_BENCHMARK(save_text)->arg(64)->arg(1024);
+DSA_BENCHMARK(load_text)->arg(64)->arg(1024);
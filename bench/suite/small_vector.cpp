@@ -0,0 +1,66 @@
+// small_vector.cpp - tiny collections: Vector vs SmallVector vs std::vector
+#include "bench.hpp"
+#include "small_vector.hpp"
+#include "vector.hpp"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+using dsa::bench::State;
+using dsa::bench::doNotOptimize;
+
+// n short-lived collections of 0..8 ints, each summed and dropped
+template <typename Vec>
+void tiny_collections(State& state){
+    const std::int64_t n = state.range(0);
+    for (auto _ : state) {
+        long sum = 0;
+        for (std::int64_t k = 0; k < n; k++) {
+            Vec v;
+            for (std::int64_t i = 0; i < k % 9; i++) {
+                v.push_back(static_cast<int>(i));
+            }
+            for (std::size_t i = 0; i < v.size(); i++) {
+                sum += v[i];
+            }
+        }
+        doNotOptimize(sum);
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+// adjacency lists: n nodes with about 3 neighbours each, built then walked
+template <typename Inner>
+void adjacency(State& state){
+    const std::int64_t n = state.range(0);
+    for (auto _ : state) {
+        dsa::Vector<Inner> graph;
+        graph.reserve(n);
+        for (std::int64_t u = 0; u < n; u++) {
+            graph.emplace_back();
+            for (std::int64_t d = 1; d <= 1 + u % 5; d++) {
+                graph.back().push_back(static_cast<int>((u + d * 7919) % n));
+            }
+        }
+        long sum = 0;
+        for (std::int64_t u = 0; u < n; u++) {
+            for (std::size_t i = 0; i < graph[u].size(); i++) {
+                sum += graph[u][i];
+            }
+        }
+        doNotOptimize(sum);
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+} // namespace
+
+DSA_BENCHMARK(tiny_collections<dsa::Vector<int>>)->range(1 << 8, 1 << 16);
+DSA_BENCHMARK(tiny_collections<dsa::SmallVector<int, 8>>)->range(1 << 8, 1 << 16);
+DSA_BENCHMARK(tiny_collections<std::vector<int>>)->range(1 << 8, 1 << 16);
+DSA_BENCHMARK(adjacency<dsa::Vector<int>>)->range(1 << 8, 1 << 16);
+DSA_BENCHMARK(adjacency<dsa::SmallVector<int, 4>>)->range(1 << 8, 1 << 16);
+DSA_BENCHMARK(adjacency<dsa::SmallVector<int, 8>>)->range(1 << 8, 1 << 16);
+DSA_BENCHMARK(adjacency<std::vector<int>>)->range(1 << 8, 1 << 16);
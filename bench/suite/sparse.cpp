@@ -0,0 +1,106 @@
+// sparse.cpp - SparseMatrix against dense BasicMatrix on an n x n double
+// matrix with density range(1) / 10000 (so 1 = 0.01%, 1000 = 10%): SpMV
+// throughput, dense mat-vec on the same matrix, and the cost of building
+// CSR from COO. The footprint of each form is reported in bytes.
+#include "bench.hpp"
+#include "sparse_matrix.hpp"
+
+#include <map>
+#include <memory>
+#include <random>
+#include <utility>
+
+namespace {
+
+using dsa::bench::State;
+using dsa::bench::doNotOptimize;
+using Sparse = dsa::SparseMatrix<double>;
+
+// COO with about n * n * density entries at random cells
+Sparse randomCoo(std::int64_t n, std::int64_t per10000){
+    std::mt19937_64 gen(static_cast<std::uint64_t>(n * 10007 + per10000));
+    std::uniform_int_distribution<std::int64_t> cell(0, n - 1);
+    std::uniform_real_distribution<double> value(0.5, 1.5);
+    std::int64_t nnz = std::max<std::int64_t>(1, n * n / 10000 * per10000);
+    Sparse m(n, n);
+    m.reserve(static_cast<std::size_t>(nnz));
+    for (std::int64_t k = 0; k < nnz; k++) {
+        m.insert(static_cast<std::size_t>(cell(gen)), static_cast<std::size_t>(cell(gen)), value(gen));
+    }
+    return m;
+}
+
+// one CSR matrix per {n, density}, kept for the whole run
+const Sparse& csrFor(std::int64_t n, std::int64_t per10000){
+    static std::map<std::pair<std::int64_t, std::int64_t>, std::unique_ptr<Sparse>> cache;
+    std::unique_ptr<Sparse>& m = cache[std::make_pair(n, per10000)];
+    if (!m) {
+        m.reset(new Sparse(randomCoo(n, per10000).toCSR()));
+    }
+    return *m;
+}
+
+dsa::Vector<double> ones(std::int64_t n){
+    dsa::Vector<double> x;
+    x.resize(static_cast<std::size_t>(n), 1.0);
+    return x;
+}
+
+void sparse_spmv(State& state){
+    const Sparse& a = csrFor(state.range(0), state.range(1));
+    dsa::Vector<double> x = ones(state.range(0));
+    for (auto _ : state) {
+        dsa::Vector<double> y = a * x;
+        doNotOptimize(y);
+    }
+    state.setItemsProcessed(static_cast<std::int64_t>(state.iterations() * a.nonZeros()));
+    state.setBytesProcessed(static_cast<std::int64_t>(state.iterations() * a.memoryBytes()));
+    state.counters["bytes"] = static_cast<double>(a.memoryBytes());
+    state.counters["nnz"] = static_cast<double>(a.nonZeros());
+}
+
+// y = A x over the dense form: every cell, zero or not
+void dense_matvec(State& state){
+    dsa::BasicMatrix<double> d = csrFor(state.range(0), state.range(1)).toDense();
+    dsa::Vector<double> x = ones(state.range(0));
+    dsa::Vector<double> y;
+    y.resize(d.getRows());
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < d.getRows(); i++) {
+            const double* r = d.row(i);
+            double sum = 0;
+            for (std::size_t j = 0; j < d.getCols(); j++) {
+                sum += r[j] * x[j];
+            }
+            y[i] = sum;
+        }
+        doNotOptimize(y);
+    }
+    std::int64_t bytes = static_cast<std::int64_t>(d.getRows() * d.getStride() * sizeof(double));
+    state.setItemsProcessed(static_cast<std::int64_t>(state.iterations() * d.getRows() * d.getCols()));
+    state.setBytesProcessed(static_cast<std::int64_t>(state.iterations()) * bytes);
+    state.counters["bytes"] = static_cast<double>(bytes);
+}
+
+// COO (already filled) -> CSR: two counting sorts and the duplicate merge
+void coo_to_csr(State& state){
+    Sparse coo = randomCoo(state.range(0), state.range(1));
+    for (auto _ : state) {
+        Sparse csr = coo.toCSR();
+        doNotOptimize(csr);
+    }
+    state.setItemsProcessed(static_cast<std::int64_t>(state.iterations() * coo.nonZeros()));
+}
+
+// 4096 x 4096 (128 MiB dense) at 0.01% .. 10%
+void densities(dsa::bench::Benchmark* b){
+    for (std::int64_t per10000 : {1, 10, 100, 1000}) {
+        b->args({4096, per10000});
+    }
+}
+
+} // namespace
+
+DSA_BENCHMARK(sparse_spmv)->apply(densities);
+DSA_BENCHMARK(dense_matvec)->apply(densities);
+DSA_BENCHMARK(coo_to_csr)->apply(densities);
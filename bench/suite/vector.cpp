@@ -0,0 +1,203 @@
+// vector.cpp - dsa::Vector against std::vector for int, double and std::string
+#include "bench.hpp"
+#include "vector.hpp"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+using dsa::bench::State;
+using dsa::bench::doNotOptimize;
+
+// element value for index i
+template <typename T> T make(std::int64_t i){ return static_cast<T>(i); }
+template <> std::string make<std::string>(std::int64_t i){ return std::string(24, static_cast<char>('a' + i % 26)); }
+
+// index-based insert/erase for both containers
+template <typename T>
+void insertAt(dsa::Vector<T>& v, std::size_t i, const T& x){ v.insert(i, x); }
+template <typename T>
+void insertAt(std::vector<T>& v, std::size_t i, const T& x){ v.insert(v.begin() + i, x); }
+template <typename T>
+void eraseAt(dsa::Vector<T>& v, std::size_t i){ v.erase(i); }
+template <typename T>
+void eraseAt(std::vector<T>& v, std::size_t i){ v.erase(v.begin() + i); }
+
+template <typename Vec>
+Vec filled(std::int64_t n){
+    Vec v;
+    for (std::int64_t i = 0; i < n; i++) {
+        v.push_back(make<typename Vec::value_type>(i));
+    }
+    return v;
+}
+
+// grow from empty with push_back
+template <typename Vec>
+void push_back(State& state){
+    using T = typename Vec::value_type;
+    const std::int64_t n = state.range(0);
+    const T x = make<T>(7);
+    for (auto _ : state) {
+        Vec v;
+        for (std::int64_t i = 0; i < n; i++) {
+            v.push_back(x);
+        }
+        doNotOptimize(v);
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+// reserve once, then push_back
+template <typename Vec>
+void reserve_fill(State& state){
+    using T = typename Vec::value_type;
+    const std::int64_t n = state.range(0);
+    const T x = make<T>(7);
+    for (auto _ : state) {
+        Vec v;
+        v.reserve(n);
+        for (std::int64_t i = 0; i < n; i++) {
+            v.push_back(x);
+        }
+        doNotOptimize(v);
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+// insert one element in the middle of n and erase it again
+template <typename Vec>
+void insert_erase_middle(State& state){
+    using T = typename Vec::value_type;
+    const std::int64_t n = state.range(0);
+    Vec v = filled<Vec>(n);
+    const T x = make<T>(3);
+    for (auto _ : state) {
+        insertAt(v, n / 2, x);
+        eraseAt(v, n / 2);
+        doNotOptimize(v);
+    }
+    state.setItemsProcessed(state.iterations() * 2);
+}
+
+// erase every element from the front (O(n^2) shifting)
+template <typename Vec>
+void erase_front(State& state){
+    const std::int64_t n = state.range(0);
+    for (auto _ : state) {
+        state.pauseTiming();
+        Vec v = filled<Vec>(n);
+        state.resumeTiming();
+        for (std::int64_t i = 0; i < n; i++) {
+            eraseAt(v, 0);
+        }
+        doNotOptimize(v);
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+// pop everything; dsa::Vector shrinks on the way down, std::vector does not
+template <typename Vec>
+void pop_back_all(State& state){
+    const std::int64_t n = state.range(0);
+    for (auto _ : state) {
+        state.pauseTiming();
+        Vec v = filled<Vec>(n);
+        state.resumeTiming();
+        for (std::int64_t i = 0; i < n; i++) {
+            v.pop_back();
+        }
+        doNotOptimize(v);
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+// over-reserve, fill, shrink_to_fit
+template <typename Vec>
+void shrink_to_fit(State& state){
+    using T = typename Vec::value_type;
+    const std::int64_t n = state.range(0);
+    const T x = make<T>(7);
+    for (auto _ : state) {
+        Vec v;
+        v.reserve(2 * n);
+        for (std::int64_t i = 0; i < n; i++) {
+            v.push_back(x);
+        }
+        v.shrink_to_fit();
+        doNotOptimize(v);
+    }
+    state.setItemsProcessed(state.iterations() * n);
+}
+
+// index-based range insert for both containers
+template <typename T, typename It>
+void insertRange(dsa::Vector<T>& v, std::size_t i, It first, It last){ v.insert(i, first, last); }
+template <typename T, typename It>
+void insertRange(std::vector<T>& v, std::size_t i, It first, It last){ v.insert(v.begin() + i, first, last); }
+
+// insert range(1) elements in the middle of a range(0)-element vector at once
+template <typename Vec>
+void range_insert_middle(State& state){
+    using T = typename Vec::value_type;
+    const std::int64_t n = state.range(0), k = state.range(1);
+    const Vec base = filled<Vec>(n);
+    const Vec block = filled<Vec>(k);
+    Vec v;
+    for (auto _ : state) {
+        state.pauseTiming();
+        v = base;
+        state.resumeTiming();
+        insertRange(v, n / 2, &block[0], &block[0] + k);
+        doNotOptimize(v);
+    }
+    state.setItemsProcessed(state.iterations() * k);
+    state.setBytesProcessed(state.iterations() * (n / 2) * static_cast<std::int64_t>(sizeof(T)));
+}
+
+// the same insert done one element at a time (O(k * n))
+template <typename Vec>
+void single_inserts_middle(State& state){
+    const std::int64_t n = state.range(0), k = state.range(1);
+    const Vec base = filled<Vec>(n);
+    const Vec block = filled<Vec>(k);
+    Vec v;
+    for (auto _ : state) {
+        state.pauseTiming();
+        v = base;
+        state.resumeTiming();
+        for (std::int64_t j = 0; j < k; j++) {
+            insertAt(v, n / 2 + j, block[j]);
+        }
+        doNotOptimize(v);
+    }
+    state.setItemsProcessed(state.iterations() * k);
+}
+
+} // namespace
+
+DSA_BENCHMARK(range_insert_middle<dsa::Vector<int>>)->args({10000000, 10000})->args({1000000, 10000});
+DSA_BENCHMARK(range_insert_middle<std::vector<int>>)->args({10000000, 10000})->args({1000000, 10000});
+DSA_BENCHMARK(range_insert_middle<dsa::Vector<std::string>>)->args({1000000, 10000});
+DSA_BENCHMARK(range_insert_middle<std::vector<std::string>>)->args({1000000, 10000});
+DSA_BENCHMARK(single_inserts_middle<dsa::Vector<int>>)->args({1000000, 1000});
+DSA_BENCHMARK(single_inserts_middle<std::vector<int>>)->args({1000000, 1000});
+
+#define DSA_VECTOR_BENCHMARKS(T)                                                         \
+    DSA_BENCHMARK(push_back<dsa::Vector<T>>)->range(1 << 6, 1 << 20);                    \
+    DSA_BENCHMARK(push_back<std::vector<T>>)->range(1 << 6, 1 << 20);                    \
+    DSA_BENCHMARK(reserve_fill<dsa::Vector<T>>)->range(1 << 6, 1 << 20);                 \
+    DSA_BENCHMARK(reserve_fill<std::vector<T>>)->range(1 << 6, 1 << 20);                 \
+    DSA_BENCHMARK(insert_erase_middle<dsa::Vector<T>>)->range(1 << 6, 1 << 18);          \
+    DSA_BENCHMARK(insert_erase_middle<std::vector<T>>)->range(1 << 6, 1 << 18);          \
+    DSA_BENCHMARK(erase_front<dsa::Vector<T>>)->range(1 << 6, 1 << 12);                  \
+    DSA_BENCHMARK(erase_front<std::vector<T>>)->range(1 << 6, 1 << 12);                  \
+    DSA_BENCHMARK(pop_back_all<dsa::Vector<T>>)->range(1 << 6, 1 << 18);                 \
+    DSA_BENCHMARK(pop_back_all<std::vector<T>>)->range(1 << 6, 1 << 18);                 \
+    DSA_BENCHMARK(shrink_to_fit<dsa::Vector<T>>)->range(1 << 6, 1 << 18);                \
+    DSA_BENCHMARK(shrink_to_fit<std::vector<T>>)->range(1 << 6, 1 << 18)
+
+DSA_VECTOR_BENCHMARKS(int);
+DSA_VECTOR_BENCHMARKS(double);
+DSA_VECTOR_BENCHMARKS(std::string);
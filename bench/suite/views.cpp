@@ -0,0 +1,169 @@
+// views.cpp - block-wise algorithms on an n x n double matrix, once over
+// zero-copy views (matrix_view.hpp) and once the old way, copying every
+// sub-block (or the transposed operand) into a fresh matrix first.
+//
+// block_sum_*: per-block sums over range(1) x range(1) blocks
+// blocked_gemm_*: C = A * B as C(I, J) += A(I, P) * B(P, J) over range(1) blocks
+// transposed_gemm_*: A^T * B
+#include "bench.hpp"
+#include "matrix.hpp"
+
+#include <algorithm>
+
+namespace {
+
+using dsa::bench::State;
+using dsa::bench::doNotOptimize;
+using Dense = dsa::BasicMatrix<double>;
+
+Dense filled(std::int64_t n){
+    Dense m(n, n);
+    for (std::int64_t i = 0; i < n; i++) {
+        double* r = m.row(i);
+        for (std::int64_t j = 0; j < n; j++) {
+            r[j] = static_cast<double>((i * 3 + j) % 11) - 5;
+        }
+    }
+    return m;
+}
+
+// the r x c block at (i, j) copied out, as slicing worked before views
+Dense copyBlock(const Dense& m, std::size_t i, std::size_t j, std::size_t r, std::size_t c){
+    return Dense::fromBuffer(r, c, m.row(i) + j, m.getStride());
+}
+
+template <typename M>
+double sumOf(const M& block){
+    double sum = 0;
+    for (std::size_t i = 0; i < block.getRows(); i++) {
+        for (std::size_t j = 0; j < block.getCols(); j++) {
+            sum += block.unchecked(i, j);
+        }
+    }
+    return sum;
+}
+
+void block_sum_view(State& state){
+    const std::size_t n = state.range(0), b = state.range(1);
+    Dense m = filled(n);
+    for (auto _ : state) {
+        double total = 0;
+        for (std::size_t i = 0; i < n; i += b) {
+            for (std::size_t j = 0; j < n; j += b) {
+                total += sumOf(m.view().block(i, j, std::min(b, n - i), std::min(b, n - j)));
+            }
+        }
+        doNotOptimize(total);
+    }
+    state.setItemsProcessed(static_cast<std::int64_t>(state.iterations() * n * n));
+}
+
+void block_sum_copy(State& state){
+    const std::size_t n = state.range(0), b = state.range(1);
+    Dense m = filled(n);
+    for (auto _ : state) {
+        double total = 0;
+        for (std::size_t i = 0; i < n; i += b) {
+            for (std::size_t j = 0; j < n; j += b) {
+                total += sumOf(copyBlock(m, i, j, std::min(b, n - i), std::min(b, n - j)));
+            }
+        }
+        doNotOptimize(total);
+    }
+    state.setItemsProcessed(static_cast<std::int64_t>(state.iterations() * n * n));
+}
+
+// C(I, J) += A(I, P) * B(P, J) straight on the operands' storage
+void blocked_gemm_view(State& state){
+    const std::size_t n = state.range(0), b = state.range(1);
+    Dense A = filled(n), B = filled(n);
+    for (auto _ : state) {
+        Dense C(n, n);
+        for (std::size_t i = 0; i < n; i += b) {
+            for (std::size_t j = 0; j < n; j += b) {
+                for (std::size_t p = 0; p < n; p += b) {
+                    std::size_t r = std::min(b, n - i), c = std::min(b, n - j), k = std::min(b, n - p);
+                    dsa::multiplyAdd(C.block(i, j, r, c), A.view().block(i, p, r, k),
+                                     B.view().block(p, j, k, c), dsa::execution::seq);
+                }
+            }
+        }
+        doNotOptimize(C);
+    }
+    state.setItemsProcessed(static_cast<std::int64_t>(state.iterations() * n * n * n));
+}
+
+// the same with both operand blocks copied out and the product added back
+void blocked_gemm_copy(State& state){
+    const std::size_t n = state.range(0), b = state.range(1);
+    Dense A = filled(n), B = filled(n);
+    for (auto _ : state) {
+        Dense C(n, n);
+        for (std::size_t i = 0; i < n; i += b) {
+            for (std::size_t j = 0; j < n; j += b) {
+                for (std::size_t p = 0; p < n; p += b) {
+                    std::size_t r = std::min(b, n - i), c = std::min(b, n - j), k = std::min(b, n - p);
+                    Dense a = copyBlock(A, i, p, r, k), bb = copyBlock(B, p, j, k, c);
+                    Dense prod = a.multiply(bb, dsa::execution::seq);
+                    for (std::size_t x = 0; x < r; x++) {
+                        double* dst = C.row(i + x) + j;
+                        const double* src = prod.row(x);
+                        for (std::size_t y = 0; y < c; y++) {
+                            dst[y] += src[y];
+                        }
+                    }
+                }
+            }
+        }
+        doNotOptimize(C);
+    }
+    state.setItemsProcessed(static_cast<std::int64_t>(state.iterations() * n * n * n));
+}
+
+// A^T * B with the transposed operand as a view: the gemm packing reads it in place
+void transposed_gemm_view(State& state){
+    const std::int64_t n = state.range(0);
+    Dense A = filled(n), B = filled(n);
+    for (auto _ : state) {
+        Dense C = dsa::multiply(A.transposed(), B.view(), dsa::execution::seq);
+        doNotOptimize(C);
+    }
+    state.setItemsProcessed(state.iterations() * n * n * n);
+}
+
+void transposed_gemm_copy(State& state){
+    const std::int64_t n = state.range(0);
+    Dense A = filled(n), B = filled(n);
+    for (auto _ : state) {
+        Dense At(n, n);
+        for (std::int64_t i = 0; i < n; i++) {
+            for (std::int64_t j = 0; j < n; j++) {
+                At.unchecked(j, i) = A.unchecked(i, j);
+            }
+        }
+        Dense C = At.multiply(B, dsa::execution::seq);
+        doNotOptimize(C);
+    }
+    state.setItemsProcessed(state.iterations() * n * n * n);
+}
+
+void blockSizes(dsa::bench::Benchmark* b){
+    for (std::int64_t block : {16, 64, 256}) {
+        b->args({1024, block});
+    }
+}
+
+void gemmBlocks(dsa::bench::Benchmark* b){
+    for (std::int64_t block : {32, 64, 128}) {
+        b->args({512, block});
+    }
+}
+
+} // namespace
+
+DSA_BENCHMARK(block_sum_view)->apply(blockSizes);
+DSA_BENCHMARK(block_sum_copy)->apply(blockSizes);
+DSA_BENCHMARK(blocked_gemm_view)->apply(gemmBlocks);
+DSA_BENCHMARK(blocked_gemm_copy)->apply(gemmBlocks);
+DSA_BENCHMARK(transposed_gemm_view)->arg(256)->arg(512);
+DSA_BENCHMARK(transposed_gemm_copy)->arg(256)->arg(512);
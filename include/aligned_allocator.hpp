@@ -0,0 +1,132 @@
+//include/aligned_allocator.hpp
+#pragma once
+
+// std::allocator_traits-compatible allocator whose blocks start on an
+// Align-byte boundary (a power of two; alignof(T) if that is larger).
+// BasicMatrix uses it so padded rows really begin on cache-line boundaries.
+//
+// allocate_zeroed(n) returns a block that reads as all zero bytes. It is
+// calloc underneath, so large blocks come straight from fresh OS pages:
+// they are zero already, nothing is written, and each page is only
+// faulted in when first touched. Vector uses it to value-initialize
+// arithmetic elements in bulk.
+//
+// Blocks are over-allocated from malloc/calloc by alignment bytes plus a
+// pointer; the pointer to the raw block is kept just below the aligned one
+// so deallocate can hand it back. (_aligned_malloc on Windows, where
+// allocate_zeroed is allocate plus memset.)
+
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uintptr_t
+#include <cstdlib>      // std::malloc, std::calloc, std::free
+#include <cstring>      // std::memcpy, std::memset
+#include <limits>       // std::numeric_limits
+#include <new>          // std::bad_alloc
+#include <type_traits>  // std::true_type
+
+#ifdef _WIN32
+#include <malloc.h>     // _aligned_malloc, _aligned_free
+#endif
+
+namespace dsa{
+
+template <typename T, std::size_t Align>
+class AlignedAllocator {
+    static_assert(Align != 0 && (Align & (Align - 1)) == 0, "Align must be a power of two");
+
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Align>;
+    };
+
+    static constexpr std::size_t alignment = Align > alignof(T) ? Align : alignof(T);
+
+    AlignedAllocator() = default;
+
+    template <typename U, std::size_t A>
+    AlignedAllocator(const AlignedAllocator<U, A>&) noexcept {}
+
+private:
+    // extra bytes per block: room to align plus the raw pointer
+    static constexpr std::size_t kSlack = alignment + sizeof(void*);
+
+    // bytes for n T's (at least one); throw std::bad_alloc if it overflows
+    static std::size_t bytesFor(std::size_t n){
+        if (n == 0) {
+            n = 1;
+        }
+        if (n > (std::numeric_limits<std::size_t>::max() - alignment - sizeof(void*)) / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        return n * sizeof(T);
+    }
+
+#ifndef _WIN32
+    // first aligned address in raw past the header; raw stored below it
+    static T* carve(void* raw){
+        if (raw == nullptr) {
+            throw std::bad_alloc();
+        }
+        std::uintptr_t a = (reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*) + alignment - 1) &
+                           ~static_cast<std::uintptr_t>(alignment - 1);
+        std::memcpy(reinterpret_cast<void*>(a - sizeof(void*)), &raw, sizeof(void*));
+        return reinterpret_cast<T*>(a);
+    }
+#endif
+
+public:
+    // uninitialized storage for n T's
+    // throw std::bad_alloc on failure
+    T* allocate(std::size_t n){
+        std::size_t bytes = bytesFor(n);
+#ifdef _WIN32
+        void* p = _aligned_malloc(bytes, alignment);
+        if (p == nullptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(p);
+#else
+        return carve(std::malloc(bytes + kSlack));
+#endif
+    }
+
+    // storage for n T's whose bytes are all zero (see the top of the file)
+    // throw std::bad_alloc on failure
+    T* allocate_zeroed(std::size_t n){
+#ifdef _WIN32
+        T* p = allocate(n);
+        std::memset(static_cast<void*>(p), 0, bytesFor(n));
+        return p;
+#else
+        return carve(std::calloc(1, bytesFor(n) + kSlack));
+#endif
+    }
+
+    void deallocate(T* p, std::size_t){
+#ifdef _WIN32
+        _aligned_free(p);
+#else
+        if (p != nullptr) {
+            void* raw;
+            std::memcpy(&raw, reinterpret_cast<char*>(p) - sizeof(void*), sizeof(void*));
+            std::free(raw);
+        }
+#endif
+    }
+};
+
+template <typename T, std::size_t A, typename U, std::size_t B>
+bool operator==(const AlignedAllocator<T, A>&, const AlignedAllocator<U, B>&){
+    return true;
+}
+
+template <typename T, std::size_t A, typename U, std::size_t B>
+bool operator!=(const AlignedAllocator<T, A>&, const AlignedAllocator<U, B>&){
+    return false;
+}
+
+} // namespace dsa
@@ -0,0 +1,383 @@
+//include/concurrent_vector.hpp
+#pragma once
+
+// ConcurrentVector<T>: an append-only vector that many threads can push to
+// at once, without a lock, while others read. Elements never move: storage
+// is a table of segments of doubling power-of-two size (kFirstSegment,
+// 2*kFirstSegment, 4*kFirstSegment, ...), allocated as the
+// size reaches them and kept until the vector dies. So push_back is one
+// compare-and-swap on the size plus the construction, and references, pointers
+// and iterators stay valid for the vector's lifetime.
+//
+//   dsa::ConcurrentVector<Event> log;
+//   // any number of threads:
+//   std::size_t i = log.push_back(e);   // i is e's index for good
+//
+// Safe from any thread at any time: push_back, emplace_back, grow_by,
+// reserve, size, capacity, and operator[] / at on an element the reader
+// knows to be constructed: one whose index it got from the pusher, or any
+// index below size() once the pushers are joined. size() counts claimed
+// slots, which includes elements still being constructed. clear(), moves
+// and destruction need the vector to themselves.
+//
+// If constructing an element throws, its slot stays claimed but empty (a
+// hole): it counts in size() but is never destroyed, and must not be read.
+// Allocator must be safe to call from several threads (std::allocator is).
+
+#include <algorithm>    // std::min
+#include <atomic>       // std::atomic
+#include <cstddef>      // std::size_t, std::ptrdiff_t
+#include <iterator>     // std::random_access_iterator_tag
+#include <limits>       // std::numeric_limits
+#include <memory>       // std::allocator, std::allocator_traits
+#include <mutex>        // std::mutex
+#include <stdexcept>    // std::out_of_range, std::length_error
+#include <type_traits>  // std::conditional
+#include <utility>      // std::forward, std::move, std::pair
+
+#include "vector.hpp"
+
+namespace dsa{
+
+namespace detail{
+
+// floor(log2(x)) for x > 0
+inline std::size_t floorLog2(std::size_t x){
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<std::size_t>(sizeof(unsigned long long) * 8 - 1 -
+                                    static_cast<std::size_t>(__builtin_clzll(x)));
+#else
+    std::size_t r = 0;
+    while (x >>= 1) {
+        r++;
+    }
+    return r;
+#endif
+}
+
+} // namespace detail
+
+template <typename T, typename Allocator = std::allocator<T>>
+class ConcurrentVector : private detail::AllocatorHolder<Allocator> {
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+
+private:
+    using holder = detail::AllocatorHolder<Allocator>;
+    using traits = std::allocator_traits<Allocator>;
+    using holder::alloc;
+
+    // segment k holds kFirstSegment << k elements; the fixed table of
+    // kSegments covers the whole size_type range, so it never reallocates
+    static constexpr size_type kFirstBits = 4;
+    static constexpr size_type kFirstSegment = size_type{1} << kFirstBits;
+    static constexpr size_type kSegments = sizeof(size_type) * 8 - kFirstBits;
+
+    std::atomic<T*> segments[kSegments];
+    std::atomic<size_type> sz{0};
+
+    // slots whose construction threw, as [first, last) ranges
+    std::mutex holesLock;
+    dsa::Vector<std::pair<size_type, size_type>> holes;
+
+    // segment k covers indices [kFirstSegment * (2^k - 1), kFirstSegment * (2^(k+1) - 1))
+    // with j = i + kFirstSegment: k = log2(j) - kFirstBits, offset = j - 2^log2(j)
+    static size_type segmentOf(size_type i){
+        return detail::floorLog2(i + kFirstSegment) - kFirstBits;
+    }
+
+    static size_type segmentSize(size_type k){
+        return kFirstSegment << k;
+    }
+
+    static size_type segmentBase(size_type k){
+        return kFirstSegment * ((size_type{1} << k) - 1);
+    }
+
+    T* slot(size_type i) const {
+        size_type j = i + kFirstSegment;
+        size_type top = detail::floorLog2(j);
+        return segments[top - kFirstBits].load(std::memory_order_acquire) + (j - (size_type{1} << top));
+    }
+
+    // segment k, allocating it if nobody has yet
+    // racing threads each allocate; the first CAS wins, the others free theirs
+    T* ensureSegment(size_type k){
+        T* seg = segments[k].load(std::memory_order_acquire);
+        if (seg) {
+            return seg;
+        }
+        T* fresh = traits::allocate(alloc(), segmentSize(k));
+        if (segments[k].compare_exchange_strong(seg, fresh, std::memory_order_acq_rel)) {
+            return fresh;
+        }
+        traits::deallocate(alloc(), fresh, segmentSize(k));
+        return seg;
+    }
+
+    // claim n slots; throw std::length_error past max_size
+    // the bound is checked before the new size is published, so a refused
+    // claim leaves sz alone (a fetch_add would leave unconstructed slots)
+    size_type claim(size_type n){
+        size_type first = sz.load(std::memory_order_relaxed);
+        do {
+            if (first > max_size() || n > max_size() - first) {
+                throw std::length_error("ConcurrentVector exceeds max_size");
+            }
+        } while (!sz.compare_exchange_weak(first, first + n, std::memory_order_relaxed));
+        return first;
+    }
+
+    void markHoles(size_type first, size_type last){
+        std::lock_guard<std::mutex> guard(holesLock);
+        holes.push_back(std::make_pair(first, last));
+    }
+
+    // construct the element at claimed slot i; a hole if that throws
+    template <typename... Args>
+    T* constructAt(size_type i, Args&&... args){
+        try {
+            ensureSegment(segmentOf(i));
+            T* p = slot(i);
+            traits::construct(alloc(), p, std::forward<Args>(args)...);
+            return p;
+        } catch (...) {
+            markHoles(i, i + 1);
+            throw;
+        }
+    }
+
+    bool isHole(size_type i) const {
+        for (size_type h = 0; h < holes.size(); h++) {
+            if (i >= holes[h].first && i < holes[h].second) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // destroy the elements and free the segments
+    void release(){
+        size_type n = sz.load();
+        for (size_type k = 0; k < kSegments; k++) {
+            T* seg = segments[k].load();
+            if (!seg) {
+                continue;
+            }
+            size_type base = segmentBase(k);
+            size_type live = n > base ? std::min(n - base, segmentSize(k)) : 0;
+            for (size_type o = 0; o < live; o++) {
+                if (holes.empty() || !isHole(base + o)) {
+                    traits::destroy(alloc(), seg + o);
+                }
+            }
+            traits::deallocate(alloc(), seg, segmentSize(k));
+            segments[k].store(nullptr);
+        }
+        sz.store(0);
+        holes.clear();
+    }
+
+    // random access by index; stays valid as the vector grows
+    template <bool Const>
+    class Iterator {
+        friend class ConcurrentVector;
+        using Owner = typename std::conditional<Const, const ConcurrentVector, ConcurrentVector>::type;
+
+        Owner* owner;
+        size_type i;
+
+        Iterator(Owner* o, size_type index) : owner(o), i(index) {}
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename std::conditional<Const, const T*, T*>::type;
+        using reference = typename std::conditional<Const, const T&, T&>::type;
+
+        Iterator() : owner(nullptr), i(0) {}
+
+        // iterator -> const_iterator
+        template <bool C = Const, typename = typename std::enable_if<C>::type>
+        Iterator(const Iterator<false>& other) : owner(other.owner), i(other.i) {}
+
+        reference operator*() const { return (*owner)[i]; }
+        pointer operator->() const { return &(*owner)[i]; }
+        reference operator[](difference_type n) const { return (*owner)[i + n]; }
+
+        Iterator& operator++(){ i++; return *this; }
+        Iterator operator++(int){ Iterator old = *this; i++; return old; }
+        Iterator& operator--(){ i--; return *this; }
+        Iterator operator--(int){ Iterator old = *this; i--; return old; }
+        Iterator& operator+=(difference_type n){ i += n; return *this; }
+        Iterator& operator-=(difference_type n){ i -= n; return *this; }
+
+        friend Iterator operator+(Iterator it, difference_type n){ return it += n; }
+        friend Iterator operator+(difference_type n, Iterator it){ return it += n; }
+        friend Iterator operator-(Iterator it, difference_type n){ return it -= n; }
+        friend difference_type operator-(Iterator a, Iterator b){
+            return static_cast<difference_type>(a.i) - static_cast<difference_type>(b.i);
+        }
+
+        bool operator==(Iterator rhs) const { return i == rhs.i; }
+        bool operator!=(Iterator rhs) const { return i != rhs.i; }
+        bool operator<(Iterator rhs) const { return i < rhs.i; }
+        bool operator>(Iterator rhs) const { return i > rhs.i; }
+        bool operator<=(Iterator rhs) const { return i <= rhs.i; }
+        bool operator>=(Iterator rhs) const { return i >= rhs.i; }
+
+        friend class Iterator<!Const>;
+    };
+
+public:
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    ConcurrentVector() : ConcurrentVector(Allocator()) {}
+
+    explicit ConcurrentVector(const Allocator& a) : holder(a) {
+        for (size_type k = 0; k < kSegments; k++) {
+            segments[k].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    // segments are owned by exactly one vector
+    ConcurrentVector(const ConcurrentVector&) = delete;
+    ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+
+    // takes other's segments; not safe while other is in use
+    ConcurrentVector(ConcurrentVector&& other) noexcept : holder(std::move(other.alloc())) {
+        for (size_type k = 0; k < kSegments; k++) {
+            segments[k].store(other.segments[k].load(), std::memory_order_relaxed);
+            other.segments[k].store(nullptr, std::memory_order_relaxed);
+        }
+        sz.store(other.sz.exchange(0));
+        holes.swap(other.holes);
+    }
+
+    ~ConcurrentVector(){
+        release();
+    }
+
+    //claimed slots, constructed or in construction
+    //O(1)
+    size_type size() const {
+        return sz.load(std::memory_order_acquire);
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    //elements that fit in the segments allocated so far
+    size_type capacity() const {
+        size_type k = 0;
+        while (k < kSegments && segments[k].load(std::memory_order_acquire)) {
+            k++;
+        }
+        return segmentBase(k);
+    }
+
+    static constexpr size_type max_size() {
+        return static_cast<size_type>(std::numeric_limits<difference_type>::max()) / sizeof(T);
+    }
+
+    allocator_type get_allocator() const {
+        return alloc();
+    }
+
+    //element at index (unchecked); two shifts and a load to find its segment
+    //O(1)
+    T& operator[](size_type i){
+        return *slot(i);
+    }
+
+    const T& operator[](size_type i) const {
+        return *slot(i);
+    }
+
+    //throw std::out_of_range("Invalid Index") if i >= size()
+    T& at(size_type i){
+        if (i >= size()) {
+            throw std::out_of_range("Invalid Index");
+        }
+        return *slot(i);
+    }
+
+    const T& at(size_type i) const {
+        if (i >= size()) {
+            throw std::out_of_range("Invalid Index");
+        }
+        return *slot(i);
+    }
+
+    //i = claim(1); allocate i's segment if needed; construct at i
+    //return i, the element's index for the vector's lifetime
+    //lock-free apart from the allocator; O(1)
+    size_type push_back(const T& elem){
+        size_type i = claim(1);
+        constructAt(i, elem);
+        return i;
+    }
+
+    size_type push_back(T&& elem){
+        size_type i = claim(1);
+        constructAt(i, std::move(elem));
+        return i;
+    }
+
+    //construct in place at the end; the reference stays valid
+    template <typename... Args>
+    T& emplace_back(Args&&... args){
+        return *constructAt(claim(1), std::forward<Args>(args)...);
+    }
+
+    //append n copies of value in one claim, so they get adjacent indices
+    //return the index of the first
+    size_type grow_by(size_type n, const T& value = T()){
+        size_type first = claim(n);
+        size_type i = first;
+        try {
+            for (; i < first + n; i++) {
+                constructAt(i, value);
+            }
+        } catch (...) {
+            markHoles(i + 1, first + n);   // constructAt marked i itself
+            throw;
+        }
+        return first;
+    }
+
+    //allocate the segments for the first n elements now (size unchanged)
+    void reserve(size_type n){
+        if (n > max_size()) {
+            throw std::length_error("ConcurrentVector exceeds max_size");
+        }
+        if (n == 0) {
+            return;
+        }
+        for (size_type k = 0; k <= segmentOf(n - 1); k++) {
+            ensureSegment(k);
+        }
+    }
+
+    //destroy everything and free the segments; not thread-safe
+    void clear(){
+        release();
+    }
+
+    iterator begin(){ return iterator(this, 0); }
+    iterator end(){ return iterator(this, size()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+};
+
+} // namespace dsa
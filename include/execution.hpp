@@ -0,0 +1,77 @@
+//include/execution.hpp
+#pragma once
+
+// Execution policies for the dsa::parallel algorithms and
+// BasicMatrix::multiply, in the spirit of std::execution:
+//
+//   dsa::parallel::sort(dsa::execution::seq, v.begin(), v.end());
+//   dsa::parallel::reduce(dsa::execution::par, v.begin(), v.end(), 0.0);
+//   m.multiply(other, dsa::execution::par.on(pool).withGrain(1));
+//
+// seq runs on the calling thread alone. par runs on a ThreadPool (the
+// global one unless on() names another); withGrain sets the fewest elements
+// (or matrix tiles) one task gets, 0 = the algorithm's own default.
+
+#include <cstddef>      // std::size_t
+#include <type_traits>  // std::enable_if, std::true_type, std::decay
+
+#include "thread_pool.hpp"
+
+namespace dsa{
+namespace execution{
+
+struct sequenced_policy {
+    ThreadPool& getPool() const {
+        return ThreadPool::inlinePool();
+    }
+
+    std::size_t getGrain() const {
+        return 0;
+    }
+};
+
+struct parallel_policy {
+    ThreadPool* pool{nullptr};   // nullptr = ThreadPool::global()
+    std::size_t grain{0};
+
+    ThreadPool& getPool() const {
+        return pool ? *pool : ThreadPool::global();
+    }
+
+    std::size_t getGrain() const {
+        return grain;
+    }
+
+    // the same policy on another pool
+    parallel_policy on(ThreadPool& p) const {
+        parallel_policy result = *this;
+        result.pool = &p;
+        return result;
+    }
+
+    // the same policy with at least g elements per task
+    parallel_policy withGrain(std::size_t g) const {
+        parallel_policy result = *this;
+        result.grain = g;
+        return result;
+    }
+};
+
+constexpr sequenced_policy seq{};
+constexpr parallel_policy par{};
+
+template <typename T>
+struct IsExecutionPolicy : std::false_type {};
+
+template <>
+struct IsExecutionPolicy<sequenced_policy> : std::true_type {};
+
+template <>
+struct IsExecutionPolicy<parallel_policy> : std::true_type {};
+
+// enable_if helper for overloads taking a policy
+template <typename P, typename R = void>
+using EnableIfPolicy = typename std::enable_if<IsExecutionPolicy<typename std::decay<P>::type>::value, R>::type;
+
+} // namespace execution
+} // namespace dsa
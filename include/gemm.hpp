@@ -0,0 +1,316 @@
+//include/gemm.hpp
+#pragma once
+
+// Dense matrix multiplication C += A * B on row-major buffers of any
+// arithmetic element type T.
+//
+// The product is split into MC x NC tiles of C; each tile is one task on a
+// ThreadPool. Inside a tile the k dimension is walked in KC slices: the A
+// slice is packed into MR-row micro-panels and the B slice into NR-column
+// micro-panels so the micro-kernel streams both from L1/L2 with unit stride.
+// The micro-kernel keeps an MR x NR block of C in registers. int32, float and
+// double have AVX2 (FMA for the floating point types) micro-kernels picked at
+// runtime; every other T uses a portable kernel that accumulates in
+// kernels::accumulator_t<T> (8/16-bit integers widen to uint32).
+//
+// A and B may be read with any row and column step, so a transposed operand
+// (a view with column step = its stride, see matrix_view.hpp) costs nothing
+// extra: packing already copies every element once.
+
+#include "kernels.hpp"      // Isa detection, accumulator_t, DSA_KERNELS_X86
+#include "thread_pool.hpp"
+#include "vector.hpp"
+
+#include <algorithm>  // std::min
+#include <cstddef>    // std::size_t
+
+namespace dsa{
+namespace gemm{
+
+using size_type = std::size_t;
+
+// register block (MR x NR accumulators) and cache blocks for T;
+// a row of the register block is one 64-byte line (two AVX2 registers)
+template <typename T>
+struct Blocking {
+    static constexpr size_type MR = sizeof(T) > 8 ? 4 : 6;   // rows of C per micro-kernel
+    static constexpr size_type NR = sizeof(T) >= 4 ? 64 / sizeof(T) : 16; // cols of C per micro-kernel
+    static constexpr size_type KC = sizeof(T) > 8 ? 128 : 256; // k slice: MR x KC of A stays in L1
+    static constexpr size_type MC = 16 * MR;                  // rows of A packed per slice (L2)
+    static constexpr size_type NC = 512;                      // cols of B packed per slice
+};
+
+template <typename T> constexpr size_type Blocking<T>::MR;
+template <typename T> constexpr size_type Blocking<T>::NR;
+template <typename T> constexpr size_type Blocking<T>::KC;
+template <typename T> constexpr size_type Blocking<T>::MC;
+template <typename T> constexpr size_type Blocking<T>::NC;
+
+template <typename T>
+inline T narrow(kernels::accumulator_t<T> v){
+    return static_cast<T>(v);
+}
+
+// reference triple loop: C += A * B
+template <typename T>
+inline void naive(size_type m, size_type n, size_type k,
+                  const T* A, size_type lda, const T* B, size_type ldb,
+                  T* C, size_type ldc){
+    using Acc = kernels::accumulator_t<T>;
+    for (size_type i = 0; i < m; i++) {
+        for (size_type j = 0; j < n; j++) {
+            Acc sum = static_cast<Acc>(C[i * ldc + j]);
+            for (size_type p = 0; p < k; p++) {
+                sum += static_cast<Acc>(A[i * lda + p]) * static_cast<Acc>(B[p * ldb + j]);
+            }
+            C[i * ldc + j] = narrow<T>(sum);
+        }
+    }
+}
+
+namespace detail{
+
+    // A[0..mc) x [0..kc) -> panels of MR rows, each stored p-major: out[p*MR + r]
+    // element (i, p) is A[i*rsa + p*csa]; rows past mc are zero so the kernel
+    // never branches on edges
+    template <typename T>
+    inline void packA(size_type mc, size_type kc, const T* A, size_type rsa, size_type csa, T* out){
+        const size_type MR = Blocking<T>::MR;
+        for (size_type i = 0; i < mc; i += MR) {
+            size_type rows = std::min(MR, mc - i);
+            for (size_type p = 0; p < kc; p++) {
+                for (size_type r = 0; r < MR; r++) {
+                    *out++ = (r < rows) ? A[(i + r) * rsa + p * csa] : T();
+                }
+            }
+        }
+    }
+
+    // B[0..kc) x [0..nc) -> panels of NR cols, each stored p-major: out[p*NR + c]
+    // element (p, j) is B[p*rsb + j*csb]
+    template <typename T>
+    inline void packB(size_type kc, size_type nc, const T* B, size_type rsb, size_type csb, T* out){
+        const size_type NR = Blocking<T>::NR;
+        for (size_type j = 0; j < nc; j += NR) {
+            size_type cols = std::min(NR, nc - j);
+            for (size_type p = 0; p < kc; p++) {
+                const T* src = B + p * rsb + j * csb;
+                if (csb == 1) {
+                    for (size_type c = 0; c < NR; c++) {
+                        *out++ = (c < cols) ? src[c] : T();
+                    }
+                } else {
+                    for (size_type c = 0; c < NR; c++) {
+                        *out++ = (c < cols) ? src[c * csb] : T();
+                    }
+                }
+            }
+        }
+    }
+
+    // acc (MR x NR) is added into the rows x cols corner of C
+    template <typename T, typename Acc>
+    inline void store(const Acc* acc, size_type rows, size_type cols, T* C, size_type ldc){
+        const size_type NR = Blocking<T>::NR;
+        for (size_type r = 0; r < rows; r++) {
+            for (size_type c = 0; c < cols; c++) {
+                C[r * ldc + c] = narrow<T>(static_cast<kernels::accumulator_t<T>>(C[r * ldc + c]) +
+                                           static_cast<kernels::accumulator_t<T>>(acc[r * NR + c]));
+            }
+        }
+    }
+
+    // portable micro-kernel: C[rows x cols] += a_panel * b_panel over kc
+    template <typename T>
+    inline void microPortable(size_type kc, const T* a, const T* b,
+                              T* C, size_type ldc, size_type rows, size_type cols){
+        using Acc = kernels::accumulator_t<T>;
+        const size_type MR = Blocking<T>::MR, NR = Blocking<T>::NR;
+        Acc acc[Blocking<T>::MR * Blocking<T>::NR] = {};
+        for (size_type p = 0; p < kc; p++) {
+            for (size_type r = 0; r < MR; r++) {
+                Acc ar = static_cast<Acc>(a[p * MR + r]);
+                for (size_type c = 0; c < NR; c++) {
+                    acc[r * NR + c] += ar * static_cast<Acc>(b[p * NR + c]);
+                }
+            }
+        }
+        store(acc, rows, cols, C, ldc);
+    }
+
+#if DSA_KERNELS_X86
+    #define DSA_AVX2 __attribute__((target("avx2,fma")))
+
+    // int32: 6 x 16 block held in 12 ymm accumulators
+    DSA_AVX2 inline void microAvx2(size_type kc, const int* a, const int* b,
+                                   int* C, size_type ldc, size_type rows, size_type cols){
+        const size_type MR = Blocking<int>::MR, NR = Blocking<int>::NR;
+        __m256i c[6][2];
+        for (int r = 0; r < 6; r++) {
+            c[r][0] = _mm256_setzero_si256();
+            c[r][1] = _mm256_setzero_si256();
+        }
+        for (size_type p = 0; p < kc; p++) {
+            __m256i b0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + p * NR));
+            __m256i b1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + p * NR + 8));
+            const int* ap = a + p * MR;
+            #pragma GCC unroll 6
+            for (int r = 0; r < 6; r++) {
+                __m256i ar = _mm256_set1_epi32(ap[r]);
+                c[r][0] = _mm256_add_epi32(c[r][0], _mm256_mullo_epi32(ar, b0));
+                c[r][1] = _mm256_add_epi32(c[r][1], _mm256_mullo_epi32(ar, b1));
+            }
+        }
+        alignas(32) int acc[6 * 16];
+        for (int r = 0; r < 6; r++) {
+            _mm256_store_si256(reinterpret_cast<__m256i*>(acc + r * 16), c[r][0]);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(acc + r * 16 + 8), c[r][1]);
+        }
+        store(acc, rows, cols, C, ldc);
+    }
+
+    // float: 6 x 16 block, fused multiply-add
+    DSA_AVX2 inline void microAvx2(size_type kc, const float* a, const float* b,
+                                   float* C, size_type ldc, size_type rows, size_type cols){
+        const size_type MR = Blocking<float>::MR, NR = Blocking<float>::NR;
+        __m256 c[6][2];
+        for (int r = 0; r < 6; r++) {
+            c[r][0] = _mm256_setzero_ps();
+            c[r][1] = _mm256_setzero_ps();
+        }
+        for (size_type p = 0; p < kc; p++) {
+            __m256 b0 = _mm256_loadu_ps(b + p * NR);
+            __m256 b1 = _mm256_loadu_ps(b + p * NR + 8);
+            const float* ap = a + p * MR;
+            #pragma GCC unroll 6
+            for (int r = 0; r < 6; r++) {
+                __m256 ar = _mm256_broadcast_ss(ap + r);
+                c[r][0] = _mm256_fmadd_ps(ar, b0, c[r][0]);
+                c[r][1] = _mm256_fmadd_ps(ar, b1, c[r][1]);
+            }
+        }
+        alignas(32) float acc[6 * 16];
+        for (int r = 0; r < 6; r++) {
+            _mm256_store_ps(acc + r * 16, c[r][0]);
+            _mm256_store_ps(acc + r * 16 + 8, c[r][1]);
+        }
+        store(acc, rows, cols, C, ldc);
+    }
+
+    // double: 6 x 8 block, fused multiply-add
+    DSA_AVX2 inline void microAvx2(size_type kc, const double* a, const double* b,
+                                   double* C, size_type ldc, size_type rows, size_type cols){
+        const size_type MR = Blocking<double>::MR, NR = Blocking<double>::NR;
+        __m256d c[6][2];
+        for (int r = 0; r < 6; r++) {
+            c[r][0] = _mm256_setzero_pd();
+            c[r][1] = _mm256_setzero_pd();
+        }
+        for (size_type p = 0; p < kc; p++) {
+            __m256d b0 = _mm256_loadu_pd(b + p * NR);
+            __m256d b1 = _mm256_loadu_pd(b + p * NR + 4);
+            const double* ap = a + p * MR;
+            #pragma GCC unroll 6
+            for (int r = 0; r < 6; r++) {
+                __m256d ar = _mm256_broadcast_sd(ap + r);
+                c[r][0] = _mm256_fmadd_pd(ar, b0, c[r][0]);
+                c[r][1] = _mm256_fmadd_pd(ar, b1, c[r][1]);
+            }
+        }
+        alignas(32) double acc[6 * 8];
+        for (int r = 0; r < 6; r++) {
+            _mm256_store_pd(acc + r * 8, c[r][0]);
+            _mm256_store_pd(acc + r * 8 + 4, c[r][1]);
+        }
+        store(acc, rows, cols, C, ldc);
+    }
+
+    #undef DSA_AVX2
+#endif
+
+    template <typename T>
+    using MicroKernel = void (*)(size_type, const T*, const T*, T*, size_type, size_type, size_type);
+
+    // portable unless T has a SIMD micro-kernel and the CPU can run it
+    template <typename T>
+    struct MicroKernelFor {
+        static MicroKernel<T> get(){ return microPortable<T>; }
+    };
+
+#if DSA_KERNELS_X86
+    template <typename T>
+    struct MicroKernelAvx2 {
+        static MicroKernel<T> get(){
+            if (kernels::detectIsa() == kernels::Isa::AVX2) {
+                return static_cast<MicroKernel<T>>(microAvx2);
+            }
+            return microPortable<T>;
+        }
+    };
+    template <> struct MicroKernelFor<int>    : MicroKernelAvx2<int> {};
+    template <> struct MicroKernelFor<float>  : MicroKernelAvx2<float> {};
+    template <> struct MicroKernelFor<double> : MicroKernelAvx2<double> {};
+#endif
+
+    // one MC x NC tile of C, all of k
+    template <typename T>
+    inline void tile(size_type mc, size_type nc, size_type k,
+                     const T* A, size_type rsa, size_type csa, const T* B, size_type rsb, size_type csb,
+                     T* C, size_type ldc, MicroKernel<T> kernel){
+        using B_ = Blocking<T>;
+        // per-thread packing buffers, reused across tiles
+        static thread_local dsa::Vector<T> packedA, packedB;
+        packedA.resize(((B_::MC + B_::MR - 1) / B_::MR) * B_::MR * B_::KC);
+        packedB.resize(((B_::NC + B_::NR - 1) / B_::NR) * B_::NR * B_::KC);
+
+        for (size_type pc = 0; pc < k; pc += B_::KC) {
+            size_type kc = std::min(B_::KC, k - pc);
+            packA(mc, kc, A + pc * csa, rsa, csa, &packedA[0]);
+            packB(kc, nc, B + pc * rsb, rsb, csb, &packedB[0]);
+
+            for (size_type jr = 0; jr < nc; jr += B_::NR) {
+                const T* bp = &packedB[0] + (jr / B_::NR) * B_::NR * kc;
+                for (size_type ir = 0; ir < mc; ir += B_::MR) {
+                    const T* ap = &packedA[0] + (ir / B_::MR) * B_::MR * kc;
+                    kernel(kc, ap, bp, C + ir * ldc + jr, ldc,
+                           std::min(B_::MR, mc - ir), std::min(B_::NR, nc - jr));
+                }
+            }
+        }
+    }
+
+} // namespace detail
+
+// C (m x n) += A (m x k) * B (k x n), tiles of C spread over pool,
+// grain tiles per task (0 = the pool's default)
+// A(i, p) = A[i*rsa + p*csa], B(p, j) = B[p*rsb + j*csb], C is row-major
+template <typename T>
+inline void multiply(size_type m, size_type n, size_type k,
+                     const T* A, size_type rsa, size_type csa, const T* B, size_type rsb, size_type csb,
+                     T* C, size_type ldc, ThreadPool& pool, size_type grain = 0){
+    if (m == 0 || n == 0 || k == 0) {
+        return;
+    }
+    const size_type MC = Blocking<T>::MC, NC = Blocking<T>::NC;
+    const detail::MicroKernel<T> kernel = detail::MicroKernelFor<T>::get();
+    const size_type tiles_m = (m + MC - 1) / MC;
+    const size_type tiles_n = (n + NC - 1) / NC;
+
+    pool.parallel_for(0, tiles_m * tiles_n, grain, [&](size_type t){
+        size_type i = (t / tiles_n) * MC;
+        size_type j = (t % tiles_n) * NC;
+        detail::tile(std::min(MC, m - i), std::min(NC, n - j), k,
+                     A + i * rsa, rsa, csa, B + j * csb, rsb, csb, C + i * ldc + j, ldc, kernel);
+    });
+}
+
+// row-major A and B: lda / ldb elements between row starts
+template <typename T>
+inline void multiply(size_type m, size_type n, size_type k,
+                     const T* A, size_type lda, const T* B, size_type ldb,
+                     T* C, size_type ldc, ThreadPool& pool, size_type grain = 0){
+    multiply<T>(m, n, k, A, lda, 1, B, ldb, 1, C, ldc, pool, grain);
+}
+
+} // namespace gemm
+} // namespace dsa
@@ -0,0 +1,62 @@
+//include/growth_policy.hpp
+#pragma once
+
+// Growth/shrink policies for dsa::Vector (its fourth template parameter).
+//
+// A policy is a type with two static functions:
+//   size_type grow(size_type cap, size_type max)
+//     -> capacity to move to when full (> cap, <= max; cap < max on entry)
+//   size_type shrink(size_type sz, size_type cap)
+//     -> capacity after an erase/pop_back left sz elements (cap = keep)
+//
+// GeometricGrowth covers the usual knobs: growth factor Num/Den, shrink to
+// half once sz <= cap / ShrinkBelow (0 = never shrink on its own; the gap
+// between the two is the hysteresis), and MaxStep, an upper bound on the
+// elements added by one growth (0 = unbounded) so huge vectors stop
+// overshooting by gigabytes.
+
+#include <cstddef>  // std::size_t
+
+namespace dsa{
+
+template <std::size_t Num = 2, std::size_t Den = 1, std::size_t ShrinkBelow = 4, std::size_t MaxStep = 0>
+struct GeometricGrowth {
+    static_assert(Den > 0 && Num > Den, "growth factor Num/Den must be > 1");
+    static_assert(ShrinkBelow == 0 || ShrinkBelow > 2,
+                  "ShrinkBelow must leave room after halving (> 2), or be 0 to never shrink");
+
+    using size_type = std::size_t;
+
+    //grown = cap * Num / Den, saturating at max
+    //at least cap + 1, at most cap + MaxStep
+    static size_type grow(size_type cap, size_type max){
+        size_type grown = cap <= max / Num ? cap * Num / Den : max;
+        if (grown <= cap) {
+            grown = cap + 1;
+        }
+        if (MaxStep != 0 && grown - cap > MaxStep) {
+            grown = cap + MaxStep;
+        }
+        return grown < max ? grown : max;
+    }
+
+    //if sz <= cap / ShrinkBelow: max(1, cap / 2)
+    //else cap
+    static size_type shrink(size_type sz, size_type cap){
+        if (ShrinkBelow == 0 || cap == 0 || sz > cap / ShrinkBelow) {
+            return cap;
+        }
+        return cap / 2 > 1 ? cap / 2 : 1;
+    }
+};
+
+// double when full, halve at a quarter full (the original behaviour)
+using DefaultGrowth = GeometricGrowth<>;
+
+// 1.5x: less slack, and freed blocks can be reused by later growth
+using CompactGrowth = GeometricGrowth<3, 2>;
+
+// double when full, only shrink_to_fit() gives memory back
+using NoShrinkGrowth = GeometricGrowth<2, 1, 0>;
+
+} // namespace dsa
@@ -0,0 +1,521 @@
+//include/kernels.hpp
+#pragma once
+
+// Element-wise kernels used by dsa::BasicMatrix<T>.
+// Every kernel exists as a portable scalar loop for any T. int32, float and
+// double also have SSE2 and AVX2 intrinsics (AVX2 + FMA for float/double).
+// The fastest version the CPU supports is picked once at runtime
+// (CPUID via __builtin_cpu_supports), so the library builds without -mavx2.
+
+#include <cmath>        // std::fma
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::int8_t, std::int16_t, ...
+#include <type_traits>  // std::make_unsigned, std::conditional
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define DSA_KERNELS_X86 1
+#include <immintrin.h>
+#else
+#define DSA_KERNELS_X86 0
+#endif
+
+namespace dsa{
+namespace kernels{
+
+using size_type = std::size_t;
+
+// instruction sets a kernel can be built for, slowest first
+// (AVX2 here means AVX2 + FMA, which every AVX2 CPU in practice has)
+enum class Isa { Scalar, SSE2, AVX2 };
+
+// type the scalar kernels compute in: signed integers use their unsigned
+// counterpart so overflow wraps like the SIMD lanes instead of being UB
+template <typename T>
+using wrapping_t = typename std::conditional<std::is_integral<T>::value && std::is_signed<T>::value,
+                                             std::make_unsigned<T>, std::common_type<T>>::type::type;
+
+// type scalar products are formed in: integers narrower than int would
+// promote to (signed) int, so they multiply in unsigned int instead
+template <typename T>
+using product_t = typename std::conditional<std::is_integral<T>::value && (sizeof(T) < sizeof(unsigned int)),
+                                            unsigned int, wrapping_t<T>>::type;
+
+// type dot products accumulate in before narrowing back to T:
+// 8/16-bit integers widen to uint32 so products do not promote to int,
+// every integer wraps in an unsigned type (the low bits, which is all the
+// narrowing keeps, come out the same), floating point and complex stay as is
+template <typename T> struct Accumulator { using type = wrapping_t<T>; };
+template <> struct Accumulator<std::int8_t>   { using type = std::uint32_t; };
+template <> struct Accumulator<std::int16_t>  { using type = std::uint32_t; };
+template <> struct Accumulator<std::uint8_t>  { using type = std::uint32_t; };
+template <> struct Accumulator<std::uint16_t> { using type = std::uint32_t; };
+
+template <typename T>
+using accumulator_t = typename Accumulator<T>::type;
+
+// Scalar reference versions for any element type.
+namespace scalar{
+
+    template <typename T>
+    inline T op_add(T a, T b){ return static_cast<T>(static_cast<wrapping_t<T>>(a) + static_cast<wrapping_t<T>>(b)); }
+    template <typename T>
+    inline T op_sub(T a, T b){ return static_cast<T>(static_cast<wrapping_t<T>>(a) - static_cast<wrapping_t<T>>(b)); }
+    template <typename T>
+    inline T op_mul(T a, T b){ return static_cast<T>(static_cast<product_t<T>>(a) * static_cast<product_t<T>>(b)); }
+
+    // out[k] = a[k] + b[k]
+    template <typename T>
+    inline void add(const T* a, const T* b, T* out, size_type n){
+        for (size_type k = 0; k < n; k++) {
+            out[k] = op_add(a[k], b[k]);
+        }
+    }
+
+    // out[k] = a[k] - b[k]
+    template <typename T>
+    inline void sub(const T* a, const T* b, T* out, size_type n){
+        for (size_type k = 0; k < n; k++) {
+            out[k] = op_sub(a[k], b[k]);
+        }
+    }
+
+    // out[k] = a[k] * b[k]  (Hadamard product)
+    template <typename T>
+    inline void mul(const T* a, const T* b, T* out, size_type n){
+        for (size_type k = 0; k < n; k++) {
+            out[k] = op_mul(a[k], b[k]);
+        }
+    }
+
+    // out[k] = s * a[k]
+    template <typename T>
+    inline void scale(const T* a, T s, T* out, size_type n){
+        for (size_type k = 0; k < n; k++) {
+            out[k] = op_mul(s, a[k]);
+        }
+    }
+
+    // y[k] = alpha * x[k] + y[k]
+    template <typename T>
+    inline void axpy(T alpha, const T* x, T* y, size_type n){
+        for (size_type k = 0; k < n; k++) {
+            y[k] = op_add(op_mul(alpha, x[k]), y[k]);
+        }
+    }
+
+} // namespace scalar
+
+#if DSA_KERNELS_X86
+
+namespace sse2{
+
+    #define DSA_SSE2 __attribute__((target("sse2")))
+
+    // SSE2 has no 32-bit mullo: multiply even and odd lanes as 64-bit
+    // products and keep the low halves
+    DSA_SSE2 inline __m128i mullo(__m128i a, __m128i b){
+        __m128i even = _mm_mul_epu32(a, b);
+        __m128i odd  = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+        return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                                  _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+    }
+
+    DSA_SSE2 inline __m128i load(const int* p){ return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    DSA_SSE2 inline void store(int* p, __m128i v){ _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+
+    DSA_SSE2 inline void add(const int* a, const int* b, int* out, size_type n){
+        size_type k = 0;
+        for (; k + 4 <= n; k += 4) {
+            store(out + k, _mm_add_epi32(load(a + k), load(b + k)));
+        }
+        scalar::add(a + k, b + k, out + k, n - k);
+    }
+
+    DSA_SSE2 inline void sub(const int* a, const int* b, int* out, size_type n){
+        size_type k = 0;
+        for (; k + 4 <= n; k += 4) {
+            store(out + k, _mm_sub_epi32(load(a + k), load(b + k)));
+        }
+        scalar::sub(a + k, b + k, out + k, n - k);
+    }
+
+    DSA_SSE2 inline void mul(const int* a, const int* b, int* out, size_type n){
+        size_type k = 0;
+        for (; k + 4 <= n; k += 4) {
+            store(out + k, mullo(load(a + k), load(b + k)));
+        }
+        scalar::mul(a + k, b + k, out + k, n - k);
+    }
+
+    DSA_SSE2 inline void scale(const int* a, int s, int* out, size_type n){
+        const __m128i vs = _mm_set1_epi32(s);
+        size_type k = 0;
+        for (; k + 4 <= n; k += 4) {
+            store(out + k, mullo(load(a + k), vs));
+        }
+        scalar::scale(a + k, s, out + k, n - k);
+    }
+
+    DSA_SSE2 inline void axpy(int alpha, const int* x, int* y, size_type n){
+        const __m128i va = _mm_set1_epi32(alpha);
+        size_type k = 0;
+        for (; k + 4 <= n; k += 4) {
+            store(y + k, _mm_add_epi32(mullo(load(x + k), va), load(y + k)));
+        }
+        scalar::axpy(alpha, x + k, y + k, n - k);
+    }
+
+    DSA_SSE2 inline __m128 load(const float* p){ return _mm_loadu_ps(p); }
+    DSA_SSE2 inline void store(float* p, __m128 v){ _mm_storeu_ps(p, v); }
+    DSA_SSE2 inline __m128d load(const double* p){ return _mm_loadu_pd(p); }
+    DSA_SSE2 inline void store(double* p, __m128d v){ _mm_storeu_pd(p, v); }
+
+    // float: 4 lanes; no FMA, so axpy rounds the product like the scalar loop
+    DSA_SSE2 inline void add(const float* a, const float* b, float* out, size_type n){
+        size_type k = 0;
+        for (; k + 4 <= n; k += 4) {
+            store(out + k, _mm_add_ps(load(a + k), load(b + k)));
+        }
+        scalar::add(a + k, b + k, out + k, n - k);
+    }
+
+    DSA_SSE2 inline void sub(const float* a, const float* b, float* out, size_type n){
+        size_type k = 0;
+        for (; k + 4 <= n; k += 4) {
+            store(out + k, _mm_sub_ps(load(a + k), load(b + k)));
+        }
+        scalar::sub(a + k, b + k, out + k, n - k);
+    }
+
+    DSA_SSE2 inline void mul(const float* a, const float* b, float* out, size_type n){
+        size_type k = 0;
+        for (; k + 4 <= n; k += 4) {
+            store(out + k, _mm_mul_ps(load(a + k), load(b + k)));
+        }
+        scalar::mul(a + k, b + k, out + k, n - k);
+    }
+
+    DSA_SSE2 inline void scale(const float* a, float s, float* out, size_type n){
+        const __m128 vs = _mm_set1_ps(s);
+        size_type k = 0;
+        for (; k + 4 <= n; k += 4) {
+            store(out + k, _mm_mul_ps(vs, load(a + k)));
+        }
+        scalar::scale(a + k, s, out + k, n - k);
+    }
+
+    DSA_SSE2 inline void axpy(float alpha, const float* x, float* y, size_type n){
+        const __m128 va = _mm_set1_ps(alpha);
+        size_type k = 0;
+        for (; k + 4 <= n; k += 4) {
+            store(y + k, _mm_add_ps(_mm_mul_ps(va, load(x + k)), load(y + k)));
+        }
+        scalar::axpy(alpha, x + k, y + k, n - k);
+    }
+
+    // double: 2 lanes
+    DSA_SSE2 inline void add(const double* a, const double* b, double* out, size_type n){
+        size_type k = 0;
+        for (; k + 2 <= n; k += 2) {
+            store(out + k, _mm_add_pd(load(a + k), load(b + k)));
+        }
+        scalar::add(a + k, b + k, out + k, n - k);
+    }
+
+    DSA_SSE2 inline void sub(const double* a, const double* b, double* out, size_type n){
+        size_type k = 0;
+        for (; k + 2 <= n; k += 2) {
+            store(out + k, _mm_sub_pd(load(a + k), load(b + k)));
+        }
+        scalar::sub(a + k, b + k, out + k, n - k);
+    }
+
+    DSA_SSE2 inline void mul(const double* a, const double* b, double* out, size_type n){
+        size_type k = 0;
+        for (; k + 2 <= n; k += 2) {
+            store(out + k, _mm_mul_pd(load(a + k), load(b + k)));
+        }
+        scalar::mul(a + k, b + k, out + k, n - k);
+    }
+
+    DSA_SSE2 inline void scale(const double* a, double s, double* out, size_type n){
+        const __m128d vs = _mm_set1_pd(s);
+        size_type k = 0;
+        for (; k + 2 <= n; k += 2) {
+            store(out + k, _mm_mul_pd(vs, load(a + k)));
+        }
+        scalar::scale(a + k, s, out + k, n - k);
+    }
+
+    DSA_SSE2 inline void axpy(double alpha, const double* x, double* y, size_type n){
+        const __m128d va = _mm_set1_pd(alpha);
+        size_type k = 0;
+        for (; k + 2 <= n; k += 2) {
+            store(y + k, _mm_add_pd(_mm_mul_pd(va, load(x + k)), load(y + k)));
+        }
+        scalar::axpy(alpha, x + k, y + k, n - k);
+    }
+
+    #undef DSA_SSE2
+
+} // namespace sse2
+
+namespace avx2{
+
+    #define DSA_AVX2 __attribute__((target("avx2,fma")))
+
+    DSA_AVX2 inline __m256i load(const int* p){ return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    DSA_AVX2 inline void store(int* p, __m256i v){ _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    DSA_AVX2 inline __m256 load(const float* p){ return _mm256_loadu_ps(p); }
+    DSA_AVX2 inline void store(float* p, __m256 v){ _mm256_storeu_ps(p, v); }
+    DSA_AVX2 inline __m256d load(const double* p){ return _mm256_loadu_pd(p); }
+    DSA_AVX2 inline void store(double* p, __m256d v){ _mm256_storeu_pd(p, v); }
+
+    // axpy tail for float/double: fused like the vector body, so every
+    // element of a row rounds the same way whatever its position
+    template <typename T>
+    DSA_AVX2 inline void fusedAxpy(T alpha, const T* x, T* y, size_type n){
+        for (size_type k = 0; k < n; k++) {
+            y[k] = std::fma(alpha, x[k], y[k]);
+        }
+    }
+
+    // int32: 8 lanes
+    DSA_AVX2 inline void add(const int* a, const int* b, int* out, size_type n){
+        size_type k = 0;
+        for (; k + 8 <= n; k += 8) {
+            store(out + k, _mm256_add_epi32(load(a + k), load(b + k)));
+        }
+        scalar::add(a + k, b + k, out + k, n - k);
+    }
+
+    DSA_AVX2 inline void sub(const int* a, const int* b, int* out, size_type n){
+        size_type k = 0;
+        for (; k + 8 <= n; k += 8) {
+            store(out + k, _mm256_sub_epi32(load(a + k), load(b + k)));
+        }
+        scalar::sub(a + k, b + k, out + k, n - k);
+    }
+
+    DSA_AVX2 inline void mul(const int* a, const int* b, int* out, size_type n){
+        size_type k = 0;
+        for (; k + 8 <= n; k += 8) {
+            store(out + k, _mm256_mullo_epi32(load(a + k), load(b + k)));
+        }
+        scalar::mul(a + k, b + k, out + k, n - k);
+    }
+
+    DSA_AVX2 inline void scale(const int* a, int s, int* out, size_type n){
+        const __m256i vs = _mm256_set1_epi32(s);
+        size_type k = 0;
+        for (; k + 8 <= n; k += 8) {
+            store(out + k, _mm256_mullo_epi32(load(a + k), vs));
+        }
+        scalar::scale(a + k, s, out + k, n - k);
+    }
+
+    DSA_AVX2 inline void axpy(int alpha, const int* x, int* y, size_type n){
+        const __m256i va = _mm256_set1_epi32(alpha);
+        size_type k = 0;
+        for (; k + 8 <= n; k += 8) {
+            store(y + k, _mm256_add_epi32(_mm256_mullo_epi32(load(x + k), va), load(y + k)));
+        }
+        scalar::axpy(alpha, x + k, y + k, n - k);
+    }
+
+    // float: 8 lanes, axpy is a single fused multiply-add
+    DSA_AVX2 inline void add(const float* a, const float* b, float* out, size_type n){
+        size_type k = 0;
+        for (; k + 8 <= n; k += 8) {
+            store(out + k, _mm256_add_ps(load(a + k), load(b + k)));
+        }
+        scalar::add(a + k, b + k, out + k, n - k);
+    }
+
+    DSA_AVX2 inline void sub(const float* a, const float* b, float* out, size_type n){
+        size_type k = 0;
+        for (; k + 8 <= n; k += 8) {
+            store(out + k, _mm256_sub_ps(load(a + k), load(b + k)));
+        }
+        scalar::sub(a + k, b + k, out + k, n - k);
+    }
+
+    DSA_AVX2 inline void mul(const float* a, const float* b, float* out, size_type n){
+        size_type k = 0;
+        for (; k + 8 <= n; k += 8) {
+            store(out + k, _mm256_mul_ps(load(a + k), load(b + k)));
+        }
+        scalar::mul(a + k, b + k, out + k, n - k);
+    }
+
+    DSA_AVX2 inline void scale(const float* a, float s, float* out, size_type n){
+        const __m256 vs = _mm256_set1_ps(s);
+        size_type k = 0;
+        for (; k + 8 <= n; k += 8) {
+            store(out + k, _mm256_mul_ps(load(a + k), vs));
+        }
+        scalar::scale(a + k, s, out + k, n - k);
+    }
+
+    DSA_AVX2 inline void axpy(float alpha, const float* x, float* y, size_type n){
+        const __m256 va = _mm256_set1_ps(alpha);
+        size_type k = 0;
+        for (; k + 8 <= n; k += 8) {
+            store(y + k, _mm256_fmadd_ps(va, load(x + k), load(y + k)));
+        }
+        fusedAxpy(alpha, x + k, y + k, n - k);
+    }
+
+    // double: 4 lanes
+    DSA_AVX2 inline void add(const double* a, const double* b, double* out, size_type n){
+        size_type k = 0;
+        for (; k + 4 <= n; k += 4) {
+            store(out + k, _mm256_add_pd(load(a + k), load(b + k)));
+        }
+        scalar::add(a + k, b + k, out + k, n - k);
+    }
+
+    DSA_AVX2 inline void sub(const double* a, const double* b, double* out, size_type n){
+        size_type k = 0;
+        for (; k + 4 <= n; k += 4) {
+            store(out + k, _mm256_sub_pd(load(a + k), load(b + k)));
+        }
+        scalar::sub(a + k, b + k, out + k, n - k);
+    }
+
+    DSA_AVX2 inline void mul(const double* a, const double* b, double* out, size_type n){
+        size_type k = 0;
+        for (; k + 4 <= n; k += 4) {
+            store(out + k, _mm256_mul_pd(load(a + k), load(b + k)));
+        }
+        scalar::mul(a + k, b + k, out + k, n - k);
+    }
+
+    DSA_AVX2 inline void scale(const double* a, double s, double* out, size_type n){
+        const __m256d vs = _mm256_set1_pd(s);
+        size_type k = 0;
+        for (; k + 4 <= n; k += 4) {
+            store(out + k, _mm256_mul_pd(load(a + k), vs));
+        }
+        scalar::scale(a + k, s, out + k, n - k);
+    }
+
+    DSA_AVX2 inline void axpy(double alpha, const double* x, double* y, size_type n){
+        const __m256d va = _mm256_set1_pd(alpha);
+        size_type k = 0;
+        for (; k + 4 <= n; k += 4) {
+            store(y + k, _mm256_fmadd_pd(va, load(x + k), load(y + k)));
+        }
+        fusedAxpy(alpha, x + k, y + k, n - k);
+    }
+
+    #undef DSA_AVX2
+
+} // namespace avx2
+
+#endif // DSA_KERNELS_X86
+
+// true if this CPU (and build) can run kernels for isa
+inline bool supported(Isa isa){
+    switch (isa) {
+    case Isa::Scalar:
+        return true;
+#if DSA_KERNELS_X86
+    case Isa::SSE2:
+        return __builtin_cpu_supports("sse2");
+    case Isa::AVX2:
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+    default:
+        return false;
+    }
+}
+
+// best instruction set available, detected once
+inline Isa detectIsa(){
+    static const Isa best = supported(Isa::AVX2) ? Isa::AVX2
+                          : supported(Isa::SSE2) ? Isa::SSE2
+                          : Isa::Scalar;
+    return best;
+}
+
+inline const char* isaName(Isa isa){
+    switch (isa) {
+    case Isa::SSE2: return "sse2";
+    case Isa::AVX2: return "avx2";
+    default:        return "scalar";
+    }
+}
+
+// one entry per kernel for a given element type and instruction set
+template <typename T>
+struct Table {
+    void (*add)(const T*, const T*, T*, size_type);
+    void (*sub)(const T*, const T*, T*, size_type);
+    void (*mul)(const T*, const T*, T*, size_type);
+    void (*scale)(const T*, T, T*, size_type);
+    void (*axpy)(T, const T*, T*, size_type);
+};
+
+// kernels for isa; anything without a SIMD version for T gets the scalar loops
+template <typename T>
+inline Table<T> table(Isa){
+    return Table<T>{scalar::add<T>, scalar::sub<T>, scalar::mul<T>, scalar::scale<T>, scalar::axpy<T>};
+}
+
+#if DSA_KERNELS_X86
+template <>
+inline Table<int> table<int>(Isa isa){
+    if (isa == Isa::AVX2) {
+        return Table<int>{avx2::add, avx2::sub, avx2::mul, avx2::scale, avx2::axpy};
+    }
+    if (isa == Isa::SSE2) {
+        return Table<int>{sse2::add, sse2::sub, sse2::mul, sse2::scale, sse2::axpy};
+    }
+    return Table<int>{scalar::add<int>, scalar::sub<int>, scalar::mul<int>, scalar::scale<int>, scalar::axpy<int>};
+}
+
+template <>
+inline Table<float> table<float>(Isa isa){
+    if (isa == Isa::AVX2) {
+        return Table<float>{avx2::add, avx2::sub, avx2::mul, avx2::scale, avx2::axpy};
+    }
+    if (isa == Isa::SSE2) {
+        return Table<float>{sse2::add, sse2::sub, sse2::mul, sse2::scale, sse2::axpy};
+    }
+    return Table<float>{scalar::add<float>, scalar::sub<float>, scalar::mul<float>, scalar::scale<float>, scalar::axpy<float>};
+}
+
+template <>
+inline Table<double> table<double>(Isa isa){
+    if (isa == Isa::AVX2) {
+        return Table<double>{avx2::add, avx2::sub, avx2::mul, avx2::scale, avx2::axpy};
+    }
+    if (isa == Isa::SSE2) {
+        return Table<double>{sse2::add, sse2::sub, sse2::mul, sse2::scale, sse2::axpy};
+    }
+    return Table<double>{scalar::add<double>, scalar::sub<double>, scalar::mul<double>, scalar::scale<double>, scalar::axpy<double>};
+}
+#endif
+
+// kernels for the running CPU
+template <typename T>
+inline const Table<T>& active(){
+    static const Table<T> t = table<T>(detectIsa());
+    return t;
+}
+
+// dispatched entry points
+template <typename T>
+inline void add(const T* a, const T* b, T* out, size_type n){ active<T>().add(a, b, out, n); }
+template <typename T>
+inline void sub(const T* a, const T* b, T* out, size_type n){ active<T>().sub(a, b, out, n); }
+template <typename T>
+inline void mul(const T* a, const T* b, T* out, size_type n){ active<T>().mul(a, b, out, n); }
+template <typename T>
+inline void scale(const T* a, T s, T* out, size_type n){ active<T>().scale(a, s, out, n); }
+template <typename T>
+inline void axpy(T alpha, const T* x, T* y, size_type n){ active<T>().axpy(alpha, x, y, n); }
+
+} // namespace kernels
+} // namespace dsa
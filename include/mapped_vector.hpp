@@ -0,0 +1,388 @@
+//include/mapped_vector.hpp
+#pragma once
+
+// MappedVector<T>: a Vector of trivially copyable records whose storage is a
+// memory-mapped file. The elements live in the page cache rather than the
+// heap, so a dataset can be larger than RAM. Reopening the file maps it
+// again, which is O(1): nothing is read or parsed until it is touched.
+//
+//   dsa::MappedVector<Record> v("records.dsa");   // opens or creates
+//   v.push_back(r);                               // grows the file
+//   ...                                           // next run: same contents
+//
+// File layout: a 64-byte header (magic, element size and alignment, size),
+// then capacity() elements. Growth extends the file with ftruncate and
+// moves the mapping with mremap (munmap + mmap where mremap is missing).
+// The size in the header is updated on every change; sync() flushes the
+// pages to disk (the kernel does so anyway, eventually and at munmap).
+//
+// POSIX only. System call failures throw std::system_error; a file that is
+// not a MappedVector of this T throws std::runtime_error.
+
+#if !(defined(__unix__) || defined(__APPLE__))
+#error "mapped_vector.hpp needs POSIX mmap"
+#endif
+
+#include <algorithm>    // std::max, std::copy_backward
+#include <cerrno>       // errno
+#include <cstddef>      // std::size_t, std::ptrdiff_t
+#include <cstdint>      // std::uint32_t, std::uint64_t
+#include <cstring>      // std::memcpy, std::memmove, std::memcmp
+#include <limits>       // std::numeric_limits
+#include <stdexcept>    // std::out_of_range, std::length_error, std::runtime_error
+#include <string>       // std::string
+#include <system_error> // std::system_error
+#include <type_traits>  // std::is_trivially_copyable
+#include <utility>      // std::swap
+
+#include <fcntl.h>      // open
+#include <sys/mman.h>   // mmap, mremap, munmap, msync
+#include <sys/stat.h>   // fstat
+#include <unistd.h>     // ftruncate, close, sysconf
+
+#include "growth_policy.hpp"
+
+namespace dsa{
+
+template <typename T, typename GrowthPolicy = DefaultGrowth>
+class MappedVector {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "MappedVector stores raw bytes; T must be trivially copyable");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using iterator = T*;                // contiguous, random access
+    using const_iterator = const T*;
+
+private:
+    // first 64 bytes of the file
+    struct Header {
+        char magic[8];
+        std::uint32_t elementSize;
+        std::uint32_t elementAlign;
+        std::uint64_t size;             // live elements
+        char reserved[40];
+    };
+    static_assert(sizeof(Header) == 64, "header must stay 64 bytes");
+    static_assert(alignof(T) <= sizeof(Header), "elements must be aligned by the header size");
+
+    static constexpr char kMagic[8] = {'D', 'S', 'A', 'M', 'V', 'E', 'C', '1'};
+
+    std::string filePath;
+    int fd{-1};
+    unsigned char* base{nullptr};   // mapping of the whole file
+    size_type cap{0};
+    size_type sz{0};
+
+    [[noreturn]] static void fail(const char* what){
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    static size_type bytesFor(size_type n){
+        return sizeof(Header) + n * sizeof(T);
+    }
+
+    Header* header() const { return reinterpret_cast<Header*>(base); }
+    T* elements() const { return reinterpret_cast<T*>(base + sizeof(Header)); }
+
+    // the size on disk follows sz
+    void setSize(size_type n){
+        sz = n;
+        header()->size = n;
+    }
+
+    // smallest capacity worth a mapping: one page of elements
+    static size_type minCapacity(){
+        size_type page = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+        return std::max<size_type>(1, (page - sizeof(Header)) / sizeof(T));
+    }
+
+    // resize the file and the mapping to new_cap elements
+    void remap(size_type new_cap){
+        if (new_cap > max_size()) {
+            throw std::length_error("MappedVector capacity exceeds max_size");
+        }
+        size_type old_bytes = bytesFor(cap);
+        size_type new_bytes = bytesFor(new_cap);
+        // grow the file before the mapping, shrink it after
+        if (new_bytes > old_bytes && ::ftruncate(fd, static_cast<off_t>(new_bytes)) != 0) {
+            fail("MappedVector: ftruncate");
+        }
+#ifdef MREMAP_MAYMOVE
+        void* p = ::mremap(base, old_bytes, new_bytes, MREMAP_MAYMOVE);
+        if (p == MAP_FAILED) {
+            fail("MappedVector: mremap");
+        }
+#else
+        void* p = ::mmap(nullptr, new_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            fail("MappedVector: mmap");
+        }
+        ::munmap(base, old_bytes);
+#endif
+        base = static_cast<unsigned char*>(p);
+        if (new_bytes < old_bytes && ::ftruncate(fd, static_cast<off_t>(new_bytes)) != 0) {
+            fail("MappedVector: ftruncate");
+        }
+        cap = new_cap;
+    }
+
+    // capacity to grow to when full (at least a page)
+    size_type grown_capacity() const {
+        if (cap >= max_size()) {
+            throw std::length_error("MappedVector at max_size");
+        }
+        return std::max(GrowthPolicy::grow(cap, max_size()), minCapacity());
+    }
+
+    void close(){
+        if (base != nullptr) {
+            ::munmap(base, bytesFor(cap));
+            base = nullptr;
+        }
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+
+    // map an existing file and check its header
+    void openExisting(size_type file_bytes){
+        if (file_bytes < sizeof(Header) || (file_bytes - sizeof(Header)) % sizeof(T) != 0) {
+            throw std::runtime_error("MappedVector: " + filePath + " is not a MappedVector file");
+        }
+        void* p = ::mmap(nullptr, file_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            fail("MappedVector: mmap");
+        }
+        base = static_cast<unsigned char*>(p);
+        cap = (file_bytes - sizeof(Header)) / sizeof(T);
+        const Header* h = header();
+        if (std::memcmp(h->magic, kMagic, sizeof(kMagic)) != 0 || h->elementSize != sizeof(T) ||
+            h->elementAlign != alignof(T) || h->size > cap) {
+            throw std::runtime_error("MappedVector: " + filePath + " does not hold this element type");
+        }
+        sz = static_cast<size_type>(h->size);
+    }
+
+    // write a header for an empty vector into a new file
+    void create(){
+        if (::ftruncate(fd, static_cast<off_t>(bytesFor(0))) != 0) {
+            fail("MappedVector: ftruncate");
+        }
+        void* p = ::mmap(nullptr, bytesFor(0), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            fail("MappedVector: mmap");
+        }
+        base = static_cast<unsigned char*>(p);
+        Header h{};
+        std::memcpy(h.magic, kMagic, sizeof(kMagic));
+        h.elementSize = sizeof(T);
+        h.elementAlign = alignof(T);
+        std::memcpy(base, &h, sizeof(h));
+        cap = 0;
+        sz = 0;
+    }
+
+public:
+    // open path, creating an empty vector there if the file is missing or empty
+    //   throw std::system_error if it cannot be opened or mapped
+    //   throw std::runtime_error if it holds something else
+    // O(1): the contents are paged in on first access
+    explicit MappedVector(std::string path) : filePath(std::move(path)) {
+        fd = ::open(filePath.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd < 0) {
+            fail("MappedVector: open");
+        }
+        try {
+            struct stat st;
+            if (::fstat(fd, &st) != 0) {
+                fail("MappedVector: fstat");
+            }
+            if (st.st_size == 0) {
+                create();
+            } else {
+                openExisting(static_cast<size_type>(st.st_size));
+            }
+        } catch (...) {
+            close();
+            throw;
+        }
+    }
+
+    // one owner per mapping
+    MappedVector(const MappedVector&) = delete;
+    MappedVector& operator=(const MappedVector&) = delete;
+
+    MappedVector(MappedVector&& other) noexcept
+        : filePath(std::move(other.filePath)), fd(other.fd), base(other.base), cap(other.cap), sz(other.sz) {
+        other.fd = -1;
+        other.base = nullptr;
+        other.cap = 0;
+        other.sz = 0;
+    }
+
+    MappedVector& operator=(MappedVector&& other) noexcept {
+        if (this != &other) {
+            close();
+            filePath = std::move(other.filePath);
+            std::swap(fd, other.fd);
+            std::swap(base, other.base);
+            std::swap(cap, other.cap);
+            std::swap(sz, other.sz);
+        }
+        return *this;
+    }
+
+    // unmap and close; the file keeps the contents
+    ~MappedVector(){
+        close();
+    }
+
+    const std::string& path() const { return filePath; }
+
+    size_type capacity() const { return cap; }
+    size_type size() const { return sz; }
+    bool empty() const { return sz == 0; }
+
+    // the file offset has to fit in off_t as well as the address space
+    static constexpr size_type max_size() {
+        return (static_cast<size_type>(std::numeric_limits<difference_type>::max()) - sizeof(Header)) / sizeof(T);
+    }
+
+    T* data() { return elements(); }
+    const T* data() const { return elements(); }
+
+    //return data[i] // no bounds check
+    T& operator[](size_type i) { return elements()[i]; }
+    const T& operator[](size_type i) const { return elements()[i]; }
+
+    //throw std::out_of_range("Invalid Index") if i >= sz
+    T& at(size_type i){
+        if (i >= sz) {
+            throw std::out_of_range("Invalid Index");
+        }
+        return elements()[i];
+    }
+
+    const T& at(size_type i) const {
+        if (i >= sz) {
+            throw std::out_of_range("Invalid Index");
+        }
+        return elements()[i];
+    }
+
+    T& front() { return elements()[0]; }
+    const T& front() const { return elements()[0]; }
+    T& back() { return elements()[sz - 1]; }
+    const T& back() const { return elements()[sz - 1]; }
+
+    iterator begin() { return elements(); }
+    iterator end() { return elements() + sz; }
+    const_iterator begin() const { return elements(); }
+    const_iterator end() const { return elements() + sz; }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    // insert at end
+    //   if sz==cap: grow the file per GrowthPolicy (at least a page)
+    //   data[sz] = elem; sz++
+    // Amortized O(1); worst-case one mremap (no copy when the kernel can
+    // extend the mapping in place)
+    void push_back(const T& elem){
+        if (sz == cap) {
+            T copy(elem);   // elem may live in the mapping that is about to move
+            remap(grown_capacity());
+            elements()[sz] = copy;
+        } else {
+            elements()[sz] = elem;
+        }
+        setSize(sz + 1);
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args){
+        push_back(T{std::forward<Args>(args)...});
+        return back();
+    }
+
+    // remove from end; capacity is kept (use shrink_to_fit)
+    //   throw std::out_of_range if empty (before the header is touched)
+    void pop_back(){
+        if (sz == 0) {
+            throw std::out_of_range("pop_back on empty MappedVector");
+        }
+        setSize(sz - 1);
+    }
+
+    // insert at index: one memmove of the tail
+    //   throw std::out_of_range("Invalid Index") if i > sz
+    void insert(size_type i, const T& elem){
+        if (i > sz) {
+            throw std::out_of_range("Invalid Index");
+        }
+        T copy(elem);
+        if (sz == cap) {
+            remap(grown_capacity());
+        }
+        std::memmove(static_cast<void*>(elements() + i + 1), static_cast<const void*>(elements() + i),
+                     sizeof(T) * (sz - i));
+        elements()[i] = copy;
+        setSize(sz + 1);
+    }
+
+    // remove at index: one memmove of the tail
+    //   throw std::out_of_range("Invalid Index") if i >= sz
+    void erase(size_type i){
+        if (i >= sz) {
+            throw std::out_of_range("Invalid Index");
+        }
+        std::memmove(static_cast<void*>(elements() + i), static_cast<const void*>(elements() + i + 1),
+                     sizeof(T) * (sz - i - 1));
+        setSize(sz - 1);
+    }
+
+    // size 0; the file keeps its capacity
+    void clear(){
+        setSize(0);
+    }
+
+    // capacity >= minimum (extends the file)
+    void reserve(size_type minimum){
+        if (cap < minimum) {
+            remap(minimum);
+        }
+    }
+
+    // set the size to n; new elements are copies of value
+    void resize(size_type n, const T& value = T()){
+        if (n > sz) {
+            T fill(value);
+            reserve(n);
+            std::fill(elements() + sz, elements() + n, fill);
+        }
+        setSize(n);
+    }
+
+    // truncate the file to the live elements
+    void shrink_to_fit(){
+        if (cap > sz) {
+            remap(sz);
+        }
+    }
+
+    // flush dirty pages to the file and wait for the write
+    //   throw std::system_error if msync fails
+    void sync(){
+        if (::msync(base, bytesFor(cap), MS_SYNC) != 0) {
+            fail("MappedVector: msync");
+        }
+    }
+};
+
+template <typename T, typename GrowthPolicy>
+constexpr char MappedVector<T, GrowthPolicy>::kMagic[8];
+
+} // namespace dsa
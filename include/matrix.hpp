@@ -2,70 +2,414 @@
 #pragma once
 
 #include "vector.hpp"
-#include <stdexcept>  // std::out_of_range
+#include "aligned_allocator.hpp"
+#include "kernels.hpp"
+#include "gemm.hpp"
+#include "matrix_expr.hpp"
+#include "matrix_view.hpp"
+#include "execution.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>    // std::copy, std::fill, std::min
+#include <cstring>      // std::memcmp
+#include <stdexcept>    // std::out_of_range, std::invalid_argument, std::length_error
+#include <type_traits>  // std::is_same, std::is_trivially_copyable
 
 namespace dsa{
 
-class Matrix {
+// Dense row-major matrix of T (int, int64_t, float, double, std::complex, ...).
+// Element-wise kernels and the multiplication micro-kernel are picked per T
+// at compile time (see kernels.hpp and gemm.hpp).
+// The buffer comes from Allocator (cache-line aligned by default; see
+// monotonic_arena.hpp and pool_allocator.hpp for request-scoped storage).
+template <typename T, typename Allocator = AlignedAllocator<T, 64>>
+class BasicMatrix : public expr::Expr<BasicMatrix<T, Allocator>> {
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = typename dsa::Vector<T>::size_type;
+    using difference_type = typename dsa::Vector<T>::difference_type;
+    using Matrix = BasicMatrix;  // shorter name for this type inside the class
+
+    // rows are padded to a multiple of this many bytes by default (one cache line)
+    static constexpr size_type kDefaultRowAlign = 64;
+
 private:
-    int rows{0};
-    int cols{0};
-    dsa::Vector<dsa::Vector<int>> data;
+    size_type rows{0};
+    size_type cols{0};
+    size_type stride{0};    // elements per row including padding (>= cols)
+    // rows * stride elements, row-major, padding kept at T(); with the default
+    // allocator the block starts on a 64-byte boundary so padded rows are line-aligned
+    dsa::Vector<T, Allocator> data;
+
+    // cols rounded up to a whole number of align_bytes chunks
+    static size_type paddedStride(size_type c, size_type align_bytes){
+        if (align_bytes % sizeof(T) != 0) {
+            throw std::invalid_argument("row alignment must be a multiple of the element size");
+        }
+        size_type step = std::max<size_type>(1, align_bytes / sizeof(T));
+        return (c + step - 1) / step * step;
+    }
+
+    // evaluate x (same shape as *this) chunk by chunk straight into data;
+    // each chunk is fully read before it is written, so x may read *this
+    // element for element (a = b + a)
+    template <typename E>
+    void assign(const E& x){
+        const size_type step = expr::Chunk<T>::value;
+        for (size_type i = 0; i < rows; i++) {
+            T* dst = row(i);
+            for (size_type j = 0; j < cols; j += step) {
+                size_type n = std::min(step, cols - j);
+                const T* src = x.chunk(i, j, n, dst + j);
+                if (src != dst + j) {
+                    std::copy(src, src + n, dst + j);
+                }
+            }
+        }
+    }
+
+    void check(size_type i, size_type j) const {
+        if (i >= rows || j >= cols) {
+            throw std::out_of_range("Invalid Index");
+        }
+    }
+
+    void requireSameShape(const Matrix& other) const {
+        if (rows != other.rows || cols != other.cols) {
+            throw std::out_of_range("dimensions must match"); //must match dimensions for element-wise ops
+        }
+    }
 
 public:
     /*
-    if r < 0 OR c < 0 
+    if r < 0 OR c < 0
         throw std::out_of_range("Negative dimensions");
     rows = r
     cols = c
-    for i from 0 to rows-1
-        declare row vector of ints
-        for j from 0 to cols-1
-            append 0 to row  // initialize each element with 0
-        append row to data
+    stride = cols rounded up to a multiple of row_align bytes
+    resize data to rows*stride T()  // one allocation for the whole matrix
+    for arithmetic T with the default allocator that allocation is calloc:
+    fresh pages are zero already and nothing is written until first touch
     */
-    Matrix(int r, int c){
+    // dimensions are taken signed so negative arguments can be rejected
+    // row_align = 0 packs rows with no padding
+    BasicMatrix(difference_type r, difference_type c, size_type row_align = kDefaultRowAlign,
+                const Allocator& alloc = Allocator()) : data(alloc) {
         // ToDo
         if (r < 0 || c < 0) {
             throw std::out_of_range("Negative dimensions");
         }
-        rows = r;
-        cols = c;
+        rows = static_cast<size_type>(r);
+        cols = static_cast<size_type>(c);
+        stride = paddedStride(cols, row_align);
+
+        if (stride != 0 && rows > dsa::Vector<T>::max_size() / stride) {
+            throw std::length_error("Matrix too large");
+        }
+        data.resize(rows * stride, T());
+    }
+
+    // r x c matrix with every element = value (padding stays T())
+    // (a named constructor: BasicMatrix(r, c, x) already means row_align = x)
+    static BasicMatrix filled(difference_type r, difference_type c, const T& value,
+                              size_type row_align = kDefaultRowAlign, const Allocator& alloc = Allocator()) {
+        BasicMatrix m(r, c, row_align, alloc);
+        const T zero = T();
+        bool same_as_zero = std::is_trivially_copyable<T>::value ? std::memcmp(&value, &zero, sizeof(T)) == 0
+                                                                 : value == zero;   // -0.0 still gets written
+        if (!same_as_zero) {
+            for (size_type i = 0; i < m.rows; i++) {
+                std::fill(m.row(i), m.row(i) + m.cols, value);
+            }
+        }
+        return m;
+    }
 
-        for(int i = 0; i < rows; i++) {
-            dsa::Vector<int> row; // new row each i
-            for (int j = 0; j < cols; j++) {
-                row.push_back(0);
+    // r x c matrix copied from row-major src, src_stride elements between
+    // row starts (0 = c, densely packed)
+    //   throw std::invalid_argument if src_stride is nonzero and < c
+    // packed source into packed rows is one copy; otherwise row by row
+    static BasicMatrix fromBuffer(difference_type r, difference_type c, const T* src, size_type src_stride = 0,
+                                  size_type row_align = kDefaultRowAlign, const Allocator& alloc = Allocator()) {
+        if (r < 0 || c < 0) {
+            throw std::out_of_range("Negative dimensions");
+        }
+        size_type rs = static_cast<size_type>(r), cs = static_cast<size_type>(c);
+        if (src_stride == 0) {
+            src_stride = cs;
+        } else if (src_stride < cs) {
+            throw std::invalid_argument("source stride shorter than a row");
+        }
+        BasicMatrix m(0, 0, row_align, alloc);
+        size_type stride = paddedStride(cs, row_align);
+        if (stride != 0 && rs > dsa::Vector<T>::max_size() / stride) {
+            throw std::length_error("Matrix too large");
+        }
+        m.rows = rs;
+        m.cols = cs;
+        m.stride = stride;
+        if (stride == cs && src_stride == cs) {
+            m.data.assign(src, src + rs * cs);
+        } else {
+            m.data.resize(rs * stride, T());
+            for (size_type i = 0; i < rs; i++) {
+                std::copy(src + i * src_stride, src + i * src_stride + cs, m.row(i));
             }
-            data.push_back(row);
         }
+        return m;
     }
 
-    //data.at(i).at(j)
-    int& operator()(int i, int j) {
+    //if i >= rows OR j >= cols throw std::out_of_range
+    //data[i*stride + j]
+    T& operator()(size_type i, size_type j) {
         // ToDo
-        return data.at(i).at(j);
+        check(i, j);
+        return data[i * stride + j];
+    }
+
+    const T& operator()(size_type i, size_type j) const {
+        check(i, j);
+        return data[i * stride + j];
+    }
+
+    //data[i*stride + j] // no bounds check, for kernels that own their loop bounds
+    T& unchecked(size_type i, size_type j) {
+        return data[i * stride + j];
     }
 
+    const T& unchecked(size_type i, size_type j) const {
+        return data[i * stride + j];
+    }
+
+    //pointer to the first of the cols contiguous elements of row i (unchecked)
+    //row(i) + getStride() is the start of row i+1
+    T* row(size_type i) {
+        return data.empty() ? nullptr : &data[i * stride];
+    }
+
+    const T* row(size_type i) const {
+        return data.empty() ? nullptr : &data[i * stride];
+    }
+
+    // Views (see matrix_view.hpp): O(1), share this matrix's storage and are
+    // invalidated when it reallocates. The const overloads give read-only views.
+    using View = BasicMatrixView<T>;
+    using ConstView = BasicMatrixView<const T>;
+
+    View view() { return View(row(0), rows, cols, stride); }
+    ConstView view() const { return ConstView(row(0), rows, cols, stride); }
+
+    // rows [i, i+r), columns [j, j+c)
+    // throw std::out_of_range if the block does not fit
+    View block(size_type i, size_type j, size_type r, size_type c) { return view().block(i, j, r, c); }
+    ConstView block(size_type i, size_type j, size_type r, size_type c) const { return view().block(i, j, r, c); }
+
+    View rowView(size_type i) { return view().rowView(i); }
+    ConstView rowView(size_type i) const { return view().rowView(i); }
+
+    View colView(size_type j) { return view().colView(j); }
+    ConstView colView(size_type j) const { return view().colView(j); }
+
+    // cols x rows view, (i, j) -> (*this)(j, i); Matrix(m.transposed()) copies it out
+    View transposed() { return view().transpose(); }
+    ConstView transposed() const { return view().transpose(); }
+
+    // Element-wise arithmetic (+, -, hadamard, scalar *) is lazy: see
+    // matrix_expr.hpp. a + b + c is evaluated in one pass when assigned.
     // throw std::out_of_range("dimensions must match")
     // result(i, j) = (*this)(i, j) + other(i, j)
-    Matrix operator+(Matrix& other) {
-        if (rows != other.rows || cols != other.cols) {
-            throw std::out_of_range("dimensions must match"); //must match dimensions for matrix addition
+
+    // evaluate an element-wise expression into a new matrix
+    template <typename E>
+    BasicMatrix(const expr::Expr<E>& e, const Allocator& alloc = Allocator()) : data(alloc) {
+        static_assert(std::is_same<typename E::value_type, T>::value, "expression element type must match");
+        const E& x = e.self();
+        rows = x.getRows();
+        cols = x.getCols();
+        stride = paddedStride(cols, kDefaultRowAlign);
+        data.resize(rows * stride, T());
+        assign(x);
+    }
+
+    BasicMatrix(const BasicMatrix&) = default;
+    BasicMatrix(BasicMatrix&&) = default;
+    BasicMatrix& operator=(const BasicMatrix&) = default;
+    BasicMatrix& operator=(BasicMatrix&&) = default;
+
+    // (*this) = e, in place when the shapes match; e may read *this element
+    // for element, anything else reading this storage (m = m.transposed(),
+    // a shifted block) is evaluated into a temporary first
+    template <typename E>
+    BasicMatrix& operator=(const expr::Expr<E>& e) {
+        const E& x = e.self();
+        if (x.getRows() == rows && x.getCols() == cols) {
+            if (x.overlaps(footprint())) {
+                assign(BasicMatrix(e, data.get_allocator()));
+            } else {
+                assign(x);
+            }
+        } else {
+            *this = BasicMatrix(e, data.get_allocator());
+        }
+        return *this;
+    }
+
+    // expression leaf: row i, columns [j, j+n) are already in memory
+    const T* chunk(size_type i, size_type j, size_type, T*) const {
+        return row(i) + j;
+    }
+
+    // rows * stride elements from row(0)
+    expr::Footprint<T> footprint() const {
+        const T* base = row(0);
+        return expr::Footprint<T>{base, stride, false, base, base ? base + rows * stride : base};
+    }
+
+    bool overlaps(const expr::Footprint<T>& dest) const {
+        return dest.conflicts(footprint());
+    }
+
+    // element-wise (Hadamard) product, lazy
+    template <typename E>
+    expr::Binary<BasicMatrix, E, expr::MulOp> hadamard(const expr::Expr<E>& other) const {
+        return expr::Binary<BasicMatrix, E, expr::MulOp>(*this, other.self());
+    }
+
+    // matrix product, run on the global thread pool
+    // throw std::out_of_range("dimensions must match") if cols != other.rows
+    Matrix operator*(const Matrix& other) const {
+        return multiply(other, ThreadPool::global());
+    }
+
+    // result (rows x other.cols) = (*this) * other
+    // cache-blocked, SIMD micro-kernel, tiles of the result spread over pool
+    Matrix multiply(const Matrix& other, ThreadPool& pool) const {
+        return multiply(other, execution::par.on(pool));
+    }
+
+    // multiply under an execution policy: seq on the caller alone, par on
+    // its pool with its grain counted in result tiles
+    template <typename Policy>
+    execution::EnableIfPolicy<Policy, Matrix> multiply(const Matrix& other, const Policy& policy) const {
+        if (cols != other.rows) {
+            throw std::out_of_range("dimensions must match"); //inner dimensions for multiplication
         }
-        Matrix result(rows, cols); //alloc new matrix for sum
+        Matrix result(static_cast<difference_type>(rows), static_cast<difference_type>(other.cols),
+                      kDefaultRowAlign, data.get_allocator());
+        gemm::multiply<T>(rows, other.cols, cols, row(0), stride, other.row(0), other.stride,
+                       result.row(0), result.stride, policy.getPool(), policy.getGrain());
+        return result;
+    }
+
+    Matrix& operator+=(const Matrix& other) {
+        return axpy(T(1), other);
+    }
+
+    Matrix& operator-=(const Matrix& other) {
+        return axpy(T(-1), other);
+    }
+
+    // (*this) += e, fused into one pass
+    template <typename E>
+    Matrix& operator+=(const expr::Expr<E>& e) {
+        return *this = *this + e;
+    }
+
+    template <typename E>
+    Matrix& operator-=(const expr::Expr<E>& e) {
+        return *this = *this - e;
+    }
+
+    Matrix& operator*=(const T& s) {
+        kernels::scale<T>(row(0), s, row(0), rows * stride);
+        return *this;
+    }
 
-        for (int i = 0; i < rows; i++) {
-            for (int j = 0; j < cols; j++) {
-                result(i, j) = (*this)(i, j) + other(i, j);
+    // (*this)(i, j) += alpha * x(i, j)
+    Matrix& axpy(const T& alpha, const Matrix& x) {
+        requireSameShape(x);
+        if (stride == x.stride) {
+            kernels::axpy<T>(alpha, x.row(0), row(0), rows * stride);
+        } else {
+            for (size_type i = 0; i < rows; i++) {
+                kernels::axpy<T>(alpha, x.row(i), row(i), cols);
             }
         }
-        return result; // think why - ans for chaining
+        return *this;
     }
 
-    int getRows() const { return rows; } //accessors for tests
-    int getCols() const { return cols; }
+    size_type getRows() const { return rows; } //accessors for tests
+    size_type getCols() const { return cols; }
+    size_type getStride() const { return stride; } //elements between row starts
+    Allocator getAllocator() const { return data.get_allocator(); }
 
 };
 
-}
\ No newline at end of file
+template <typename T, typename Allocator>
+constexpr typename BasicMatrix<T, Allocator>::size_type BasicMatrix<T, Allocator>::kDefaultRowAlign;
+
+// the original int matrix
+using Matrix = BasicMatrix<int>;
+
+/*
+if a.cols != b.rows OR c.shape != (a.rows, b.cols)
+    throw std::out_of_range("dimensions must match")
+c += a * b through the gemm kernel, each operand read with its own row and
+column step, so sub-blocks and transposed views are multiplied in place.
+A transposed c is computed as c^T += b^T * a^T.
+An operand sharing storage with c is copied out first (tiles of c are
+written while others still pack from a and b).
+*/
+template <typename T, typename A, typename B, typename Policy>
+execution::EnableIfPolicy<Policy> multiplyAdd(BasicMatrixView<T> c, const BasicMatrixView<A>& a,
+                                              const BasicMatrixView<B>& b, const Policy& policy){
+    using V = typename BasicMatrixView<T>::value_type;
+    static_assert(!std::is_const<T>::value, "cannot write through a view of const elements");
+    static_assert(std::is_same<typename BasicMatrixView<A>::value_type, V>::value &&
+                  std::is_same<typename BasicMatrixView<B>::value_type, V>::value, "element types must match");
+    if (a.getCols() != b.getRows() || c.getRows() != a.getRows() || c.getCols() != b.getCols()) {
+        throw std::out_of_range("dimensions must match");
+    }
+    if (c.footprint().intersects(a.footprint())) {
+        multiplyAdd(c, BasicMatrix<V>(a).view(), b, policy);
+        return;
+    }
+    if (c.footprint().intersects(b.footprint())) {
+        multiplyAdd(c, a, BasicMatrix<V>(b).view(), policy);
+        return;
+    }
+    if (c.isTransposed()) {
+        multiplyAdd(c.transpose(), b.transpose(), a.transpose(), policy);
+        return;
+    }
+    gemm::multiply<V>(a.getRows(), b.getCols(), a.getCols(),
+                      a.getData(), a.rowStep(), a.colStep(), b.getData(), b.rowStep(), b.colStep(),
+                      c.getData(), c.getStride(), policy.getPool(), policy.getGrain());
+}
+
+// c += a * b on the global thread pool
+template <typename T, typename A, typename B>
+void multiplyAdd(BasicMatrixView<T> c, const BasicMatrixView<A>& a, const BasicMatrixView<B>& b){
+    multiplyAdd(c, a, b, execution::par);
+}
+
+// a * b into a new matrix
+template <typename A, typename B, typename Policy>
+execution::EnableIfPolicy<Policy, BasicMatrix<typename BasicMatrixView<A>::value_type>>
+multiply(const BasicMatrixView<A>& a, const BasicMatrixView<B>& b, const Policy& policy){
+    using V = typename BasicMatrixView<A>::value_type;
+    if (a.getCols() != b.getRows()) {
+        throw std::out_of_range("dimensions must match");
+    }
+    using Diff = typename BasicMatrix<V>::difference_type;
+    BasicMatrix<V> result(static_cast<Diff>(a.getRows()), static_cast<Diff>(b.getCols()));
+    multiplyAdd(result.view(), a, b, policy);
+    return result;
+}
+
+template <typename A, typename B>
+BasicMatrix<typename BasicMatrixView<A>::value_type> operator*(const BasicMatrixView<A>& a, const BasicMatrixView<B>& b){
+    return multiply(a, b, execution::par);
+}
+
+}
@@ -0,0 +1,193 @@
+//include/matrix_expr.hpp
+#pragma once
+
+// Lazy element-wise expressions over dsa::BasicMatrix.
+//
+// a + b + c + d builds a tree of small nodes instead of three temporaries.
+// Assigning the tree to a matrix walks the destination once, a chunk of a
+// row at a time: each node produces its chunk with the SIMD kernels from
+// kernels.hpp into a small stack buffer, so every operand is read once and
+// the result is written once no matter how many terms there are.
+
+#include "kernels.hpp"
+
+#include <cstddef>      // std::size_t
+#include <functional>   // std::less
+#include <stdexcept>    // std::out_of_range
+#include <type_traits>  // std::conditional
+
+namespace dsa{
+
+template <typename T, typename Allocator> class BasicMatrix;
+
+namespace expr{
+
+using size_type = std::size_t;
+
+// elements of a row evaluated per step; small enough that the scratch buffers
+// of a deep expression stay in L1
+template <typename T>
+struct Chunk {
+    static constexpr size_type value = (2048 / sizeof(T)) > 16 ? (2048 / sizeof(T)) : 16;
+};
+
+// the storage a leaf walks: element (i, j) at base[i*stride + j], or at
+// base[j*stride + i] when transposed, all of it inside [lo, hi)
+template <typename T>
+struct Footprint {
+    const T* base;
+    size_type stride;
+    bool transposed;
+    const T* lo;
+    const T* hi;
+
+    bool intersects(const Footprint& other) const {
+        std::less<const T*> before;
+        return before(lo, hi) && before(other.lo, other.hi) && before(lo, other.hi) && before(other.lo, hi);
+    }
+
+    // reading other while writing this is only safe if they share no storage
+    // or walk it the same way, element for element
+    bool conflicts(const Footprint& other) const {
+        return intersects(other) &&
+               !(base == other.base && stride == other.stride && transposed == other.transposed);
+    }
+};
+
+// CRTP base of everything that can appear in an expression.
+// A node E provides:
+//   value_type, getRows(), getCols()
+//   const T* chunk(i, j, n, T* out) const
+//     -> pointer to elements (i, j) .. (i, j + n) of the expression; the node
+//        may write them into out (n <= Chunk<T>::value) and return out, but
+//        only after it has read every operand for that chunk, since out may
+//        be the destination row
+//   bool overlaps(const Footprint<T>& dest) const
+//     -> does evaluating read dest's storage other than element for element?
+//        (then the destination goes through a temporary)
+template <typename E>
+struct Expr {
+    const E& self() const { return static_cast<const E&>(*this); }
+};
+
+// matrices are held by reference, nested expressions (temporaries) by value
+template <typename E>
+struct Operand {
+    using type = E;
+};
+
+template <typename T, typename Allocator>
+struct Operand<BasicMatrix<T, Allocator>> {
+    using type = const BasicMatrix<T, Allocator>&;
+};
+
+struct AddOp {
+    template <typename T>
+    static void apply(const T* a, const T* b, T* out, size_type n){ kernels::add<T>(a, b, out, n); }
+};
+
+struct SubOp {
+    template <typename T>
+    static void apply(const T* a, const T* b, T* out, size_type n){ kernels::sub<T>(a, b, out, n); }
+};
+
+// element-wise (Hadamard) product
+struct MulOp {
+    template <typename T>
+    static void apply(const T* a, const T* b, T* out, size_type n){ kernels::mul<T>(a, b, out, n); }
+};
+
+// lhs op rhs, element-wise
+template <typename L, typename R, typename Op>
+class Binary : public Expr<Binary<L, R, Op>> {
+    typename Operand<L>::type lhs;
+    typename Operand<R>::type rhs;
+
+public:
+    using value_type = typename L::value_type;
+
+    // throw std::out_of_range("dimensions must match")
+    Binary(const L& l, const R& r) : lhs(l), rhs(r) {
+        if (l.getRows() != r.getRows() || l.getCols() != r.getCols()) {
+            throw std::out_of_range("dimensions must match");
+        }
+    }
+
+    size_type getRows() const { return lhs.getRows(); }
+    size_type getCols() const { return lhs.getCols(); }
+
+    // both operands build their chunks in scratch of their own; out is only
+    // written once both are read, so either side may read the destination
+    // (y = 2 * x + y)
+    const value_type* chunk(size_type i, size_type j, size_type n, value_type* out) const {
+        alignas(64) value_type lscratch[Chunk<value_type>::value];
+        alignas(64) value_type rscratch[Chunk<value_type>::value];
+        const value_type* a = lhs.chunk(i, j, n, lscratch);
+        const value_type* b = rhs.chunk(i, j, n, rscratch);
+        Op::apply(a, b, out, n);
+        return out;
+    }
+
+    bool overlaps(const Footprint<value_type>& dest) const {
+        return lhs.overlaps(dest) || rhs.overlaps(dest);
+    }
+};
+
+// s * e
+template <typename E>
+class Scale : public Expr<Scale<E>> {
+public:
+    using value_type = typename E::value_type;
+
+private:
+    typename Operand<E>::type e;
+    value_type s;
+
+public:
+    Scale(const E& expr, const value_type& scalar) : e(expr), s(scalar) {}
+
+    size_type getRows() const { return e.getRows(); }
+    size_type getCols() const { return e.getCols(); }
+
+    const value_type* chunk(size_type i, size_type j, size_type n, value_type* out) const {
+        kernels::scale<value_type>(e.chunk(i, j, n, out), s, out, n);
+        return out;
+    }
+
+    bool overlaps(const Footprint<value_type>& dest) const {
+        return e.overlaps(dest);
+    }
+};
+
+} // namespace expr
+
+// a + b
+template <typename L, typename R>
+expr::Binary<L, R, expr::AddOp> operator+(const expr::Expr<L>& a, const expr::Expr<R>& b){
+    return expr::Binary<L, R, expr::AddOp>(a.self(), b.self());
+}
+
+// a - b
+template <typename L, typename R>
+expr::Binary<L, R, expr::SubOp> operator-(const expr::Expr<L>& a, const expr::Expr<R>& b){
+    return expr::Binary<L, R, expr::SubOp>(a.self(), b.self());
+}
+
+// element-wise product a .* b
+template <typename L, typename R>
+expr::Binary<L, R, expr::MulOp> hadamard(const expr::Expr<L>& a, const expr::Expr<R>& b){
+    return expr::Binary<L, R, expr::MulOp>(a.self(), b.self());
+}
+
+// e * s and s * e (matrix * matrix is the matrix product, see BasicMatrix)
+template <typename E>
+expr::Scale<E> operator*(const expr::Expr<E>& e, const typename E::value_type& s){
+    return expr::Scale<E>(e.self(), s);
+}
+
+template <typename E>
+expr::Scale<E> operator*(const typename E::value_type& s, const expr::Expr<E>& e){
+    return expr::Scale<E>(e.self(), s);
+}
+
+} // namespace dsa
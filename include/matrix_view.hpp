@@ -0,0 +1,266 @@
+//include/matrix_view.hpp
+#pragma once
+
+// Non-owning views into the storage of a dsa::BasicMatrix (or any strided
+// row-major buffer).
+//
+// A view is a pointer, a shape, the stride of the underlying rows and a
+// transpose flag, so a sub-block, a single row or column, or the transpose
+// of a matrix is made in O(1) without copying:
+//
+//   dsa::MatrixView top_left = m.block(0, 0, 64, 64);
+//   dsa::ConstMatrixView t = m.transposed();
+//   dsa::Matrix c = a.block(0, 0, 8, 8) + b.transposed().block(0, 0, 8, 8);
+//
+// Views are expression leaves (matrix_expr.hpp), so they mix freely with
+// matrices in lazy element-wise expressions, and they go straight into the
+// gemm kernel (multiply / multiplyAdd in matrix.hpp) whether transposed or not.
+//
+// BasicMatrixView<T> writes through to the matrix; BasicMatrixView<const T>
+// only reads. Copying a view copies the handle; assigning to a mutable view
+// writes elements, like assigning to the block of the matrix it refers to.
+// A source that reads the destination's storage other than element for
+// element (m = m.transposed(), a block shifted onto itself) is staged in a
+// temporary first. A view is invalidated by anything that reallocates the matrix.
+
+#include "kernels.hpp"
+#include "matrix_expr.hpp"
+#include "vector.hpp"
+
+#include <algorithm>    // std::copy, std::fill, std::min, std::swap
+#include <cstddef>      // std::size_t, std::ptrdiff_t
+#include <stdexcept>    // std::out_of_range
+#include <type_traits>  // std::remove_const, std::is_const, std::enable_if
+
+namespace dsa{
+
+// element (i, j) is base[i*stride + j], or base[j*stride + i] when transposed
+template <typename T>
+class BasicMatrixView : public expr::Expr<BasicMatrixView<T>> {
+public:
+    using value_type = typename std::remove_const<T>::type;
+    using element_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+private:
+    T* base{nullptr};
+    size_type rows{0};
+    size_type cols{0};
+    size_type stride{0};       // elements between starts of the stored rows
+    bool transposed{false};    // stored rows are the columns of the view
+
+    size_type offset(size_type i, size_type j) const {
+        return transposed ? j * stride + i : i * stride + j;
+    }
+
+    void check(size_type i, size_type j) const {
+        if (i >= rows || j >= cols) {
+            throw std::out_of_range("Invalid Index");
+        }
+    }
+
+    template <typename E>
+    void requireSameShape(const E& x) const {
+        if (rows != x.getRows() || cols != x.getCols()) {
+            throw std::out_of_range("dimensions must match");
+        }
+    }
+
+public:
+    BasicMatrixView() = default;
+
+    // r x c view of buffer p whose rows start stride elements apart
+    BasicMatrixView(T* p, size_type r, size_type c, size_type row_stride, bool transpose = false)
+        : base(p), rows(r), cols(c), stride(row_stride), transposed(transpose) {}
+
+    // a mutable view converts to a read-only one
+    template <typename U, typename = typename std::enable_if<std::is_same<const U, T>::value>::type>
+    BasicMatrixView(const BasicMatrixView<U>& other)
+        : base(other.getData()), rows(other.getRows()), cols(other.getCols()),
+          stride(other.getStride()), transposed(other.isTransposed()) {}
+
+    BasicMatrixView(const BasicMatrixView&) = default;
+
+    // copy the elements of other (same shape) into this view
+    BasicMatrixView& operator=(const BasicMatrixView& other) {
+        return assign(other);
+    }
+
+    // evaluate an element-wise expression into this view
+    template <typename E>
+    BasicMatrixView& operator=(const expr::Expr<E>& e) {
+        return assign(e);
+    }
+
+    /*
+    if x.shape != shape throw std::out_of_range
+    if x reads this storage other than element for element
+        evaluate x into a packed temporary, then copy that in
+    for each row i, chunk [j, j+n):
+        not transposed: the row of the view is contiguous, evaluate into it
+        transposed: evaluate into a scratch chunk, scatter down column i of storage
+    */
+    template <typename E>
+    BasicMatrixView& assign(const expr::Expr<E>& e) {
+        static_assert(!std::is_const<T>::value, "cannot write through a view of const elements");
+        static_assert(std::is_same<typename E::value_type, value_type>::value, "expression element type must match");
+        const E& x = e.self();
+        requireSameShape(x);
+        if (rows == 0 || cols == 0) {
+            return *this;
+        }
+        if (x.overlaps(footprint())) {
+            dsa::Vector<value_type> staged;
+            staged.resize(rows * cols);
+            BasicMatrixView<value_type>(&staged[0], rows, cols, cols).assign(x);
+            return assign(BasicMatrixView<const value_type>(&staged[0], rows, cols, cols));
+        }
+        const size_type step = expr::Chunk<value_type>::value;
+        alignas(64) value_type scratch[expr::Chunk<value_type>::value];
+        for (size_type i = 0; i < rows; i++) {
+            for (size_type j = 0; j < cols; j += step) {
+                size_type n = std::min(step, cols - j);
+                if (!transposed) {
+                    T* dst = base + i * stride + j;
+                    const value_type* src = x.chunk(i, j, n, dst);
+                    if (src != dst) {
+                        std::copy(src, src + n, dst);
+                    }
+                } else {
+                    const value_type* src = x.chunk(i, j, n, scratch);
+                    for (size_type k = 0; k < n; k++) {
+                        base[(j + k) * stride + i] = src[k];
+                    }
+                }
+            }
+        }
+        return *this;
+    }
+
+    // every element = value
+    BasicMatrixView& fill(const value_type& value) {
+        for (size_type s = 0; s < storedRows(); s++) {
+            std::fill(base + s * stride, base + s * stride + storedCols(), value);
+        }
+        return *this;
+    }
+
+    BasicMatrixView& operator*=(const value_type& s) {
+        for (size_type r = 0; r < storedRows(); r++) {
+            kernels::scale<value_type>(base + r * stride, s, base + r * stride, storedCols());
+        }
+        return *this;
+    }
+
+    // (*this) += e, fused into one pass
+    template <typename E>
+    BasicMatrixView& operator+=(const expr::Expr<E>& e) {
+        return assign(*this + e.self());
+    }
+
+    template <typename E>
+    BasicMatrixView& operator-=(const expr::Expr<E>& e) {
+        return assign(*this - e.self());
+    }
+
+    // (*this)(i, j) += alpha * x(i, j); the SIMD kernel row by row when both
+    // views store their rows the same way round and x is not a shifted part
+    // of this storage
+    template <typename U>
+    BasicMatrixView& axpy(const value_type& alpha, const BasicMatrixView<U>& x) {
+        static_assert(!std::is_const<T>::value, "cannot write through a view of const elements");
+        requireSameShape(x);
+        if (transposed != x.isTransposed() || x.overlaps(footprint())) {
+            return assign(*this + x * alpha);
+        }
+        for (size_type r = 0; r < storedRows(); r++) {
+            kernels::axpy<value_type>(alpha, x.getData() + r * x.getStride(), base + r * stride, storedCols());
+        }
+        return *this;
+    }
+
+    //if i >= rows OR j >= cols throw std::out_of_range
+    T& operator()(size_type i, size_type j) const {
+        check(i, j);
+        return base[offset(i, j)];
+    }
+
+    // no bounds check
+    T& unchecked(size_type i, size_type j) const {
+        return base[offset(i, j)];
+    }
+
+    /*
+    if i + r > rows OR j + c > cols throw std::out_of_range
+    view of rows [i, i+r) and columns [j, j+c): same storage, same stride,
+    start moved to element (i, j)
+    */
+    BasicMatrixView block(size_type i, size_type j, size_type r, size_type c) const {
+        if (r > rows || i > rows - r || c > cols || j > cols - c) {
+            throw std::out_of_range("block outside the matrix");
+        }
+        T* start = (r == 0 || c == 0) ? base : base + offset(i, j);
+        return BasicMatrixView(start, r, c, stride, transposed);
+    }
+
+    // 1 x cols view of row i
+    BasicMatrixView rowView(size_type i) const {
+        return block(i, 0, 1, cols);
+    }
+
+    // rows x 1 view of column j
+    BasicMatrixView colView(size_type j) const {
+        return block(0, j, rows, 1);
+    }
+
+    // cols x rows, element (i, j) = (*this)(j, i)
+    BasicMatrixView transpose() const {
+        return BasicMatrixView(base, cols, rows, stride, !transposed);
+    }
+
+    // expression leaf: untransposed rows are in memory, transposed rows are
+    // gathered down a column of storage into out
+    const value_type* chunk(size_type i, size_type j, size_type n, value_type* out) const {
+        if (!transposed) {
+            return base + i * stride + j;
+        }
+        const T* src = base + j * stride + i;
+        for (size_type k = 0; k < n; k++) {
+            out[k] = src[k * stride];
+        }
+        return out;
+    }
+
+    // storedRows() rows of storedCols() elements from base
+    expr::Footprint<value_type> footprint() const {
+        const T* end = (rows == 0 || cols == 0) ? base : base + (storedRows() - 1) * stride + storedCols();
+        return expr::Footprint<value_type>{base, stride, transposed, base, end};
+    }
+
+    bool overlaps(const expr::Footprint<value_type>& dest) const {
+        return dest.conflicts(footprint());
+    }
+
+    size_type getRows() const { return rows; }
+    size_type getCols() const { return cols; }
+    size_type getStride() const { return stride; }    //elements between stored rows
+    bool isTransposed() const { return transposed; }
+    T* getData() const { return base; }               //element (0, 0)
+
+    // layout of the storage the view walks: rows of storedCols() elements
+    size_type storedRows() const { return transposed ? cols : rows; }
+    size_type storedCols() const { return transposed ? rows : cols; }
+
+    // steps between (i, j) and (i + 1, j) / (i, j + 1)
+    size_type rowStep() const { return transposed ? 1 : stride; }
+    size_type colStep() const { return transposed ? stride : 1; }
+};
+
+// views into the original int matrix
+using MatrixView = BasicMatrixView<int>;
+using ConstMatrixView = BasicMatrixView<const int>;
+
+}
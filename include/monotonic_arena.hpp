@@ -0,0 +1,177 @@
+//include/monotonic_arena.hpp
+#pragma once
+
+// Bump-pointer arena for request-scoped work: allocation is a pointer
+// increment, individual frees are no-ops, and everything is returned at
+// once with release() (or rewound with reset() to reuse the memory).
+//
+//   dsa::MonotonicArena arena;
+//   dsa::Vector<int, dsa::ArenaAllocator<int>> v(arena);
+//   dsa::BasicMatrix<double, dsa::ArenaAllocator<double>> m(64, 64, 64, arena);
+//   ...
+//   arena.release();   // after v and m are gone
+
+#include <cstddef>      // std::size_t, std::max_align_t
+#include <limits>       // std::numeric_limits
+#include <new>          // ::operator new, std::bad_alloc
+#include <stdexcept>    // std::invalid_argument
+
+namespace dsa{
+
+class MonotonicArena {
+public:
+    using size_type = std::size_t;
+
+    static constexpr size_type kDefaultChunk = 64 * 1024;
+
+private:
+    // header at the front of every chunk taken from the global heap
+    struct Chunk {
+        Chunk* next;
+        size_type bytes;    // whole chunk including this header
+    };
+
+    Chunk* chunks{nullptr};         // most recent first
+    unsigned char* cursor{nullptr}; // next free byte in the current chunk
+    unsigned char* limit{nullptr};  // end of the current chunk
+    unsigned char* initial{nullptr};    // caller-owned first buffer, if any
+    size_type initialBytes{0};
+    size_type nextChunk;            // size of the next chunk to request
+    size_type used{0};              // bytes handed out since the last release/reset
+    size_type upstream{0};          // chunks requested from the global heap
+
+    static size_type alignUp(size_type n, size_type align){
+        return (n + align - 1) & ~(align - 1);
+    }
+
+    // new chunk with room for bytes at align; chunk sizes grow geometrically
+    void grow(size_type bytes, size_type align){
+        const size_type max = std::numeric_limits<size_type>::max();
+        size_type header = alignUp(sizeof(Chunk), alignof(std::max_align_t));
+        if (bytes > max - header - align) {
+            throw std::bad_alloc();
+        }
+        size_type need = header + bytes + align;
+        size_type size = nextChunk;
+        while (size < need) {
+            size = size > max / 2 ? need : size * 2;   // doubling would wrap
+        }
+        Chunk* c = static_cast<Chunk*>(::operator new(size));
+        c->next = chunks;
+        c->bytes = size;
+        chunks = c;
+        upstream++;
+        nextChunk = size > max / 2 ? size : size * 2;
+        cursor = reinterpret_cast<unsigned char*>(c) + header;
+        limit = reinterpret_cast<unsigned char*>(c) + size;
+    }
+
+    void freeChunks(Chunk* c){
+        while (c != nullptr) {
+            Chunk* next = c->next;
+            ::operator delete(c);
+            c = next;
+        }
+    }
+
+public:
+    // first chunk of initial_bytes is requested lazily
+    explicit MonotonicArena(size_type initial_bytes = kDefaultChunk)
+        : nextChunk(initial_bytes < 2 * sizeof(Chunk) ? 2 * sizeof(Chunk) : initial_bytes) {}
+
+    // serve from buffer (e.g. on the stack) first, then from the heap
+    MonotonicArena(void* buffer, size_type bytes)
+        : cursor(static_cast<unsigned char*>(buffer)),
+          limit(static_cast<unsigned char*>(buffer) + bytes),
+          initial(static_cast<unsigned char*>(buffer)),
+          initialBytes(bytes),
+          nextChunk(bytes < kDefaultChunk ? size_type(kDefaultChunk) : 2 * bytes) {}
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    ~MonotonicArena(){
+        freeChunks(chunks);
+    }
+
+    // bytes of storage aligned to align (a power of two)
+    // throw std::invalid_argument if align is not a power of two
+    void* allocate(size_type bytes, size_type align = alignof(std::max_align_t)){
+        if (align == 0 || (align & (align - 1)) != 0) {
+            throw std::invalid_argument("alignment must be a power of two");
+        }
+        unsigned char* p = reinterpret_cast<unsigned char*>(
+            alignUp(reinterpret_cast<size_type>(cursor), align));
+        if (cursor == nullptr || p > limit || bytes > static_cast<size_type>(limit - p)) {
+            grow(bytes, align);
+            p = reinterpret_cast<unsigned char*>(alignUp(reinterpret_cast<size_type>(cursor), align));
+        }
+        cursor = p + bytes;
+        used += bytes;
+        return p;
+    }
+
+    // no-op; memory comes back with release() or reset()
+    void deallocate(void*, size_type, size_type = alignof(std::max_align_t)){}
+
+    // return every heap chunk and start over from the initial buffer
+    // (everything allocated from the arena must be dead)
+    void release(){
+        freeChunks(chunks);
+        chunks = nullptr;
+        cursor = initial;
+        limit = initial == nullptr ? nullptr : initial + initialBytes;
+        used = 0;
+    }
+
+    // like release(), but keep the newest (largest) chunk so the next
+    // round of the same workload makes no heap calls
+    void reset(){
+        if (chunks == nullptr) {
+            release();
+            return;
+        }
+        freeChunks(chunks->next);
+        chunks->next = nullptr;
+        cursor = reinterpret_cast<unsigned char*>(chunks) + alignUp(sizeof(Chunk), alignof(std::max_align_t));
+        limit = reinterpret_cast<unsigned char*>(chunks) + chunks->bytes;
+        used = 0;
+    }
+
+    size_type bytesAllocated() const { return used; }  // since the last release/reset
+    size_type upstreamAllocations() const { return upstream; }  // heap chunks so far
+};
+
+// std::allocator_traits-compatible handle to a MonotonicArena.
+// Containers keep their arena on copy, move and swap (nothing propagates),
+// so elements never migrate between arenas.
+template <typename T>
+class ArenaAllocator {
+    template <typename U> friend class ArenaAllocator;
+
+    MonotonicArena* arena;
+
+public:
+    using value_type = T;
+
+    ArenaAllocator(MonotonicArena& a) noexcept : arena(&a) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena(other.arena) {}
+
+    T* allocate(std::size_t n){
+        return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, std::size_t){}
+
+    MonotonicArena* resource() const { return arena; }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const { return arena != other.arena; }
+};
+
+} // namespace dsa
@@ -0,0 +1,342 @@
+//include/parallel.hpp
+#pragma once
+
+// Parallel element-wise algorithms over contiguous ranges (dsa::Vector,
+// raw arrays, BasicMatrix rows), run on a ThreadPool:
+//
+//   dsa::parallel::transform(v.begin(), v.end(), out.begin(), f);
+//   double s = dsa::parallel::reduce(v.begin(), v.end(), 0.0);
+//   dsa::parallel::sort(v.begin(), v.end(), std::less<double>(), pool);
+//   dsa::parallel::sort(dsa::execution::par.withGrain(1 << 16), v.begin(), v.end());
+//
+// Every algorithm also takes an execution policy as its first argument
+// (execution.hpp): seq runs on the caller, par on the policy's pool, with
+// its grain as the fewest elements per chunk.
+//
+// The range is split into a few chunks per thread. Chunk boundaries fall on
+// cache lines of the written range, so two threads never write the same
+// line. Ranges below kMinChunkBytes per thread run on the caller alone.
+//
+// reduce and inclusive_scan need an associative op. For floating point the
+// grouping changes the rounding: Reduction::fast groups by chunk, so the
+// result depends on the number of threads; Reduction::deterministic groups
+// by fixed kDeterministicBlock-element blocks and gives the same bits on
+// any pool.
+
+#include <algorithm>    // std::sort, std::inplace_merge, std::min
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uintptr_t
+#include <functional>   // std::plus, std::less
+#include <iterator>     // std::iterator_traits
+#include <type_traits>  // std::is_same
+#include <utility>      // std::move
+
+#include "execution.hpp"
+#include "thread_pool.hpp"
+#include "vector.hpp"
+
+namespace dsa{
+namespace parallel{
+
+using size_type = std::size_t;
+
+// below this many bytes a chunk is not worth a thread
+constexpr size_type kMinChunkBytes = 32 * 1024;
+
+// chunks per thread, so uneven chunks even out
+constexpr size_type kChunksPerThread = 4;
+
+// elements per partial result in Reduction::deterministic
+constexpr size_type kDeterministicBlock = 4096;
+
+enum class Reduction { fast, deterministic };
+
+namespace detail{
+
+constexpr size_type kCacheLine = 64;
+
+// the element an iterator of a contiguous range points at; never
+// dereferences, so it is safe on the (possibly null) begin of an empty range
+template <typename T>
+T* address(T* p) {
+    return p;
+}
+
+template <typename It>
+auto address(It it) -> decltype(it.operator->()) {
+    static_assert(dsa::detail::IsContiguous<It>::value,
+                  "dsa::parallel needs contiguous iterators (pointers or dsa::Vector iterators)");
+    return it.operator->();
+}
+
+// boundaries 0 = b[0] < b[1] < ... < b[k] = n of chunks of the n elements
+// at p; inner boundaries sit on cache lines of p when T allows it
+// chunks hold at least grain elements (0 = kMinChunkBytes worth)
+template <typename T>
+dsa::Vector<size_type> split(const T* p, size_type n, size_type threads, size_type grain = 0){
+    dsa::Vector<size_type> bounds;
+    bounds.push_back(0);
+    size_type min_chunk = grain != 0 ? grain : std::max<size_type>(1, kMinChunkBytes / sizeof(T));
+    size_type parts = std::min(threads * kChunksPerThread, std::max<size_type>(1, n / min_chunk));
+    if (threads <= 1 || parts <= 1) {
+        bounds.push_back(n);
+        return bounds;
+    }
+
+    size_type step = 1;         // elements per cache line
+    size_type offset = 0;       // index of the first line-aligned element
+    auto addr = reinterpret_cast<std::uintptr_t>(p);
+    if (kCacheLine % sizeof(T) == 0 && addr % sizeof(T) == 0) {
+        step = kCacheLine / sizeof(T);
+        offset = ((kCacheLine - addr % kCacheLine) % kCacheLine) / sizeof(T);
+    }
+    for (size_type k = 1; k < parts; k++) {
+        size_type target = n / parts * k + std::min(k, n % parts);
+        size_type b = target <= offset ? offset : offset + (target - offset + step - 1) / step * step;
+        if (b > bounds[bounds.size() - 1] && b < n) {
+            bounds.push_back(b);
+        }
+    }
+    bounds.push_back(n);
+    return bounds;
+}
+
+// body(begin, end) for each chunk of [0, n) over p, spread over pool
+template <typename T, typename Body>
+void forChunks(const T* p, size_type n, ThreadPool& pool, size_type grain, Body body){
+    dsa::Vector<size_type> bounds = split(p, n, pool.concurrency(), grain);
+    pool.parallel_for(0, bounds.size() - 1, 1, [&](size_type c){ body(bounds[c], bounds[c + 1]); });
+}
+
+template <typename It, typename F>
+void for_each(It first, It last, F& f, ThreadPool& pool, size_type grain){
+    auto p = address(first);
+    size_type n = static_cast<size_type>(last - first);
+    forChunks(p, n, pool, grain, [&](size_type b, size_type e){
+        for (size_type i = b; i < e; i++) {
+            f(p[i]);
+        }
+    });
+}
+
+template <typename It, typename Out, typename Op>
+Out transform(It first, It last, Out d_first, Op& op, ThreadPool& pool, size_type grain){
+    auto src = address(first);
+    auto dst = address(d_first);
+    size_type n = static_cast<size_type>(last - first);
+    forChunks(dst, n, pool, grain, [&](size_type b, size_type e){
+        for (size_type i = b; i < e; i++) {
+            dst[i] = op(src[i]);
+        }
+    });
+    return d_first + static_cast<typename std::iterator_traits<Out>::difference_type>(n);
+}
+
+template <typename It1, typename It2, typename Out, typename Op>
+Out transform(It1 first1, It1 last1, It2 first2, Out d_first, Op& op, ThreadPool& pool, size_type grain){
+    auto a = address(first1);
+    auto b = address(first2);
+    auto dst = address(d_first);
+    size_type n = static_cast<size_type>(last1 - first1);
+    forChunks(dst, n, pool, grain, [&](size_type lo, size_type hi){
+        for (size_type i = lo; i < hi; i++) {
+            dst[i] = op(a[i], b[i]);
+        }
+    });
+    return d_first + static_cast<typename std::iterator_traits<Out>::difference_type>(n);
+}
+
+template <typename It, typename T, typename Op>
+T reduce(It first, It last, T init, Op& op, Reduction mode, ThreadPool& pool, size_type grain){
+    auto p = address(first);
+    size_type n = static_cast<size_type>(last - first);
+    if (n == 0) {
+        return init;
+    }
+
+    dsa::Vector<size_type> bounds;
+    if (mode == Reduction::deterministic) {
+        for (size_type b = 0; b < n; b += kDeterministicBlock) {
+            bounds.push_back(b);
+        }
+        bounds.push_back(n);
+    } else {
+        bounds = split(p, n, pool.concurrency(), grain);
+    }
+
+    // partial c = fold of chunk c, left to right, seeded with its first element
+    size_type chunks = bounds.size() - 1;
+    dsa::Vector<T> partial;
+    partial.resize(chunks, init);
+    size_type blocks_per_task = mode == Reduction::deterministic && grain != 0
+                              ? (grain + kDeterministicBlock - 1) / kDeterministicBlock : 0;
+    pool.parallel_for(0, chunks, blocks_per_task, [&](size_type c){
+        T acc = p[bounds[c]];
+        for (size_type i = bounds[c] + 1; i < bounds[c + 1]; i++) {
+            acc = op(std::move(acc), p[i]);
+        }
+        partial[c] = std::move(acc);
+    });
+
+    T result = std::move(init);
+    for (size_type c = 0; c < chunks; c++) {
+        result = op(std::move(result), std::move(partial[c]));
+    }
+    return result;
+}
+
+template <typename It, typename Out, typename Op>
+Out inclusive_scan(It first, It last, Out d_first, Op& op, ThreadPool& pool, size_type grain){
+    using T = typename std::iterator_traits<Out>::value_type;
+    auto src = address(first);
+    auto dst = address(d_first);
+    size_type n = static_cast<size_type>(last - first);
+    auto end = d_first + static_cast<typename std::iterator_traits<Out>::difference_type>(n);
+    if (n == 0) {
+        return end;
+    }
+
+    dsa::Vector<size_type> bounds = split(dst, n, pool.concurrency(), grain);
+    size_type chunks = bounds.size() - 1;
+    if (chunks == 1) {
+        T acc = src[0];
+        dst[0] = acc;
+        for (size_type i = 1; i < n; i++) {
+            acc = op(std::move(acc), src[i]);
+            dst[i] = acc;
+        }
+        return end;
+    }
+
+    // the last chunk's total is never needed
+    dsa::Vector<T> carry;
+    carry.resize(chunks, T(src[0]));
+    pool.parallel_for(0, chunks - 1, 1, [&](size_type c){
+        T acc = src[bounds[c]];
+        for (size_type i = bounds[c] + 1; i < bounds[c + 1]; i++) {
+            acc = op(std::move(acc), src[i]);
+        }
+        carry[c + 1] = std::move(acc);
+    });
+    for (size_type c = 2; c < chunks; c++) {
+        carry[c] = op(carry[c - 1], carry[c]);
+    }
+
+    pool.parallel_for(0, chunks, 1, [&](size_type c){
+        size_type b = bounds[c];
+        T acc = c == 0 ? T(src[b]) : op(carry[c], src[b]);
+        dst[b] = acc;
+        for (size_type i = b + 1; i < bounds[c + 1]; i++) {
+            acc = op(std::move(acc), src[i]);
+            dst[i] = acc;
+        }
+    });
+    return end;
+}
+
+template <typename It, typename Compare>
+void sort(It first, It last, Compare& comp, ThreadPool& pool, size_type grain){
+    auto p = address(first);
+    size_type n = static_cast<size_type>(last - first);
+    if (n < 2) {
+        return;
+    }
+    dsa::Vector<size_type> bounds = split(p, n, pool.concurrency(), grain);
+    size_type chunks = bounds.size() - 1;
+    pool.parallel_for(0, chunks, 1, [&](size_type c){ std::sort(p + bounds[c], p + bounds[c + 1], comp); });
+
+    // merge runs [bounds[c], bounds[c + width]) pairwise until one is left
+    for (size_type width = 1; width < chunks; width *= 2) {
+        size_type pairs = (chunks + 2 * width - 1) / (2 * width);
+        pool.parallel_for(0, pairs, 1, [&](size_type k){
+            size_type lo = 2 * width * k;
+            size_type mid = std::min(lo + width, chunks);
+            size_type hi = std::min(lo + 2 * width, chunks);
+            if (mid < hi) {
+                std::inplace_merge(p + bounds[lo], p + bounds[mid], p + bounds[hi], comp);
+            }
+        });
+    }
+}
+
+} // namespace detail
+
+// f(x) for every element of [first, last), in no particular order
+template <typename It, typename F>
+void for_each(It first, It last, F f, ThreadPool& pool = ThreadPool::global()){
+    detail::for_each(first, last, f, pool, 0);
+}
+
+template <typename Policy, typename It, typename F>
+execution::EnableIfPolicy<Policy> for_each(const Policy& policy, It first, It last, F f){
+    detail::for_each(first, last, f, policy.getPool(), policy.getGrain());
+}
+
+// d_first[i] = op(first[i]); d_first may be first
+template <typename It, typename Out, typename Op>
+Out transform(It first, It last, Out d_first, Op op, ThreadPool& pool = ThreadPool::global()){
+    return detail::transform(first, last, d_first, op, pool, 0);
+}
+
+template <typename Policy, typename It, typename Out, typename Op>
+execution::EnableIfPolicy<Policy, Out> transform(const Policy& policy, It first, It last, Out d_first, Op op){
+    return detail::transform(first, last, d_first, op, policy.getPool(), policy.getGrain());
+}
+
+// d_first[i] = op(first1[i], first2[i])
+template <typename It1, typename It2, typename Out, typename Op>
+Out transform(It1 first1, It1 last1, It2 first2, Out d_first, Op op, ThreadPool& pool = ThreadPool::global()){
+    return detail::transform(first1, last1, first2, d_first, op, pool, 0);
+}
+
+template <typename Policy, typename It1, typename It2, typename Out, typename Op>
+execution::EnableIfPolicy<Policy, Out> transform(const Policy& policy, It1 first1, It1 last1, It2 first2,
+                                                 Out d_first, Op op){
+    return detail::transform(first1, last1, first2, d_first, op, policy.getPool(), policy.getGrain());
+}
+
+// init op x0 op x1 op ... for an associative op, grouped per chunk
+// (fast) or per fixed block (deterministic, same result on any pool)
+template <typename It, typename T, typename Op = std::plus<>>
+T reduce(It first, It last, T init, Op op = Op(), Reduction mode = Reduction::fast,
+         ThreadPool& pool = ThreadPool::global()){
+    return detail::reduce(first, last, std::move(init), op, mode, pool, 0);
+}
+
+template <typename Policy, typename It, typename T, typename Op = std::plus<>>
+execution::EnableIfPolicy<Policy, T> reduce(const Policy& policy, It first, It last, T init, Op op = Op(),
+                                            Reduction mode = Reduction::fast){
+    return detail::reduce(first, last, std::move(init), op, mode, policy.getPool(), policy.getGrain());
+}
+
+// d_first[i] = first[0] op ... op first[i]; op must be associative
+// (fast grouping: floating-point sums can differ between pool sizes)
+//   pass 1: each chunk's total, in parallel
+//   carry-in of each chunk = running total of the ones before it
+//   pass 2: each chunk scanned from its carry-in, in parallel
+template <typename It, typename Out, typename Op = std::plus<>>
+Out inclusive_scan(It first, It last, Out d_first, Op op = Op(), ThreadPool& pool = ThreadPool::global()){
+    return detail::inclusive_scan(first, last, d_first, op, pool, 0);
+}
+
+template <typename Policy, typename It, typename Out, typename Op = std::plus<>>
+execution::EnableIfPolicy<Policy, Out> inclusive_scan(const Policy& policy, It first, It last, Out d_first,
+                                                      Op op = Op()){
+    return detail::inclusive_scan(first, last, d_first, op, policy.getPool(), policy.getGrain());
+}
+
+// sort [first, last) by comp (not stable)
+//   each chunk sorted with std::sort in parallel, then neighbours merged
+//   pairwise in rounds (each round's merges in parallel)
+template <typename It, typename Compare = std::less<>>
+void sort(It first, It last, Compare comp = Compare(), ThreadPool& pool = ThreadPool::global()){
+    detail::sort(first, last, comp, pool, 0);
+}
+
+template <typename Policy, typename It, typename Compare = std::less<>>
+execution::EnableIfPolicy<Policy> sort(const Policy& policy, It first, It last, Compare comp = Compare()){
+    detail::sort(first, last, comp, policy.getPool(), policy.getGrain());
+}
+
+} // namespace parallel
+} // namespace dsa
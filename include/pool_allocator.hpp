@@ -0,0 +1,248 @@
+//include/pool_allocator.hpp
+#pragma once
+
+// Fixed-size-block pools. A BlockPool hands out blocks of one size from
+// large chunks and recycles freed blocks through an intrusive free list, so
+// steady-state allocate/deallocate never touch the global heap. PoolResource
+// keeps one BlockPool per power-of-two size class, which matches the sizes a
+// doubling Vector asks for; requests above the largest class (or needing
+// more than max_align_t alignment) go straight to the heap. release() frees
+// every chunk at once.
+//
+//   dsa::PoolResource pool;
+//   dsa::Vector<int, dsa::PoolAllocator<int>> v(pool);
+
+#include <cstddef>      // std::size_t, std::max_align_t
+#include <new>          // ::operator new
+#include <stdexcept>    // std::invalid_argument
+
+namespace dsa{
+
+class BlockPool {
+public:
+    using size_type = std::size_t;
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct Chunk {
+        Chunk* next;
+    };
+
+    size_type block;                // bytes per block
+    size_type perChunk;             // blocks carved from the next chunk
+    FreeBlock* freeList{nullptr};
+    Chunk* chunks{nullptr};
+    size_type upstream{0};          // chunks requested from the global heap
+
+    static constexpr size_type kChunkBytes = 64 * 1024;
+
+    static size_type header(){
+        return (sizeof(Chunk) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) *
+               alignof(std::max_align_t);
+    }
+
+    // carve a new chunk into blocks and thread them onto the free list
+    void refill(){
+        unsigned char* raw = static_cast<unsigned char*>(::operator new(header() + block * perChunk));
+        Chunk* c = reinterpret_cast<Chunk*>(raw);
+        c->next = chunks;
+        chunks = c;
+        upstream++;
+
+        unsigned char* first = raw + header();
+        for (size_type k = perChunk; k-- > 0;) {
+            FreeBlock* b = reinterpret_cast<FreeBlock*>(first + k * block);
+            b->next = freeList;
+            freeList = b;
+        }
+        if (perChunk * block < kChunkBytes) {
+            perChunk *= 2;      // chunks grow until they reach kChunkBytes
+        }
+    }
+
+public:
+    // block_size is rounded up to a multiple of max_align_t
+    explicit BlockPool(size_type block_size)
+        : block((block_size + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) *
+                alignof(std::max_align_t)),
+          perChunk(4) {
+        if (block == 0) {
+            block = alignof(std::max_align_t);
+        }
+    }
+
+    BlockPool(const BlockPool&) = delete;
+    BlockPool& operator=(const BlockPool&) = delete;
+
+    BlockPool(BlockPool&& other) noexcept
+        : block(other.block), perChunk(other.perChunk), freeList(other.freeList),
+          chunks(other.chunks), upstream(other.upstream) {
+        other.freeList = nullptr;
+        other.chunks = nullptr;
+    }
+
+    ~BlockPool(){
+        release();
+    }
+
+    // one block of blockSize() bytes
+    void* allocate(){
+        if (freeList == nullptr) {
+            refill();
+        }
+        FreeBlock* b = freeList;
+        freeList = b->next;
+        return b;
+    }
+
+    // back onto the free list; no heap call
+    void deallocate(void* p){
+        FreeBlock* b = static_cast<FreeBlock*>(p);
+        b->next = freeList;
+        freeList = b;
+    }
+
+    // free every chunk (all blocks must be dead)
+    void release(){
+        while (chunks != nullptr) {
+            Chunk* next = chunks->next;
+            ::operator delete(chunks);
+            chunks = next;
+        }
+        freeList = nullptr;
+    }
+
+    size_type blockSize() const { return block; }
+    size_type upstreamAllocations() const { return upstream; }
+};
+
+class PoolResource {
+public:
+    using size_type = std::size_t;
+
+    static constexpr size_type kMinBlock = 16;
+    static constexpr size_type kDefaultMaxBlock = 64 * 1024;
+
+private:
+    BlockPool* pools{nullptr};      // pools[c] serves blocks of kMinBlock << c bytes
+    size_type classes{0};
+    size_type maxBlock;
+    size_type oversize{0};          // requests passed through to the heap
+
+    // smallest class holding bytes
+    size_type classOf(size_type bytes) const {
+        size_type c = 0;
+        size_type size = kMinBlock;
+        while (size < bytes) {
+            size *= 2;
+            c++;
+        }
+        return c;
+    }
+
+    bool pooled(size_type bytes, size_type align) const {
+        return bytes <= maxBlock && align <= alignof(std::max_align_t);
+    }
+
+public:
+    // max_block is rounded up to a power of two (at least kMinBlock)
+    explicit PoolResource(size_type max_block = kDefaultMaxBlock) {
+        maxBlock = kMinBlock;
+        classes = 1;
+        while (maxBlock < max_block) {
+            maxBlock *= 2;
+            classes++;
+        }
+        pools = static_cast<BlockPool*>(::operator new(sizeof(BlockPool) * classes));
+        for (size_type c = 0; c < classes; c++) {
+            ::new (static_cast<void*>(pools + c)) BlockPool(size_type(kMinBlock) << c);
+        }
+    }
+
+    PoolResource(const PoolResource&) = delete;
+    PoolResource& operator=(const PoolResource&) = delete;
+
+    ~PoolResource(){
+        for (size_type c = 0; c < classes; c++) {
+            pools[c].~BlockPool();
+        }
+        ::operator delete(pools);
+    }
+
+    // throw std::invalid_argument if align is not a power of two
+    void* allocate(size_type bytes, size_type align = alignof(std::max_align_t)){
+        if (align == 0 || (align & (align - 1)) != 0) {
+            throw std::invalid_argument("alignment must be a power of two");
+        }
+        if (!pooled(bytes, align)) {
+            oversize++;
+            return ::operator new(bytes);   // align > max_align_t is not supported here
+        }
+        return pools[classOf(bytes)].allocate();
+    }
+
+    // bytes and align must match the allocate call
+    void deallocate(void* p, size_type bytes, size_type align = alignof(std::max_align_t)){
+        if (!pooled(bytes, align)) {
+            ::operator delete(p);
+            return;
+        }
+        pools[classOf(bytes)].deallocate(p);
+    }
+
+    // free all pooled memory at once (every pooled block must be dead)
+    void release(){
+        for (size_type c = 0; c < classes; c++) {
+            pools[c].release();
+        }
+    }
+
+    size_type maxBlockSize() const { return maxBlock; }
+
+    // chunk and oversize requests made to the global heap so far
+    size_type upstreamAllocations() const {
+        size_type n = oversize;
+        for (size_type c = 0; c < classes; c++) {
+            n += pools[c].upstreamAllocations();
+        }
+        return n;
+    }
+};
+
+// std::allocator_traits-compatible handle to a PoolResource; like
+// ArenaAllocator it stays with its container on copy, move and swap
+template <typename T>
+class PoolAllocator {
+    template <typename U> friend class PoolAllocator;
+
+    PoolResource* pool;
+
+public:
+    using value_type = T;
+
+    PoolAllocator(PoolResource& p) noexcept : pool(&p) {}
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept : pool(other.pool) {}
+
+    T* allocate(std::size_t n){
+        return static_cast<T*>(pool->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n){
+        pool->deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    PoolResource* resource() const { return pool; }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>& other) const { return pool == other.pool; }
+
+    template <typename U>
+    bool operator!=(const PoolAllocator<U>& other) const { return pool != other.pool; }
+};
+
+} // namespace dsa
@@ -0,0 +1,474 @@
+//include/serialization.hpp
+#pragma once
+
+// Binary save/load for dsa::Vector and dsa::BasicMatrix of trivially
+// copyable T.
+//
+// A file is a 64-byte header followed by the elements, contiguous and
+// packed (matrix rows without their padding):
+//
+//   magic "DSA\x1a" | version | kind (vector/matrix) | byte-order mark |
+//   type tag | element size | rows | cols | payload bytes | checksum
+//
+// The payload is the in-memory representation, so saving is one write and
+// loading one read (one per row for padded matrices); there is no
+// per-element parsing. MappedArray<T> maps a saved file and reads the
+// elements in place, without copying them at all.
+//
+//   dsa::saveFile("weights.dsa", m);
+//   dsa::BasicMatrix<float> w(0, 0);
+//   dsa::loadFile("weights.dsa", w);
+//
+// Files are only portable between machines of the same byte order; a file
+// written on the other order, of another element type, or with a bad
+// checksum throws std::runtime_error.
+
+#include <algorithm>    // std::min
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t
+#include <cstring>      // std::memcpy
+#include <complex>      // std::complex
+#include <fstream>      // std::ifstream, std::ofstream
+#include <istream>      // std::istream
+#include <limits>       // std::numeric_limits
+#include <ostream>      // std::ostream
+#include <stdexcept>    // std::runtime_error
+#include <string>       // std::string
+#include <type_traits>  // std::is_trivially_copyable, std::is_integral, std::is_signed
+
+#include "matrix.hpp"
+#include "vector.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>      // open
+#include <sys/mman.h>   // mmap, munmap
+#include <sys/stat.h>   // fstat
+#include <unistd.h>     // close
+#endif
+
+namespace dsa{
+
+namespace detail{
+
+// what the elements are, so a file of int32 is not read back as float
+//   0x1nn signed integer, 0x2nn unsigned, 0x3nn floating point,
+//   0x4nn complex, 0 anything else (only the size is checked); nn = size
+template <typename T>
+struct TypeTag {
+    static constexpr std::uint32_t value =
+        std::is_floating_point<T>::value ? 0x300 | sizeof(T)
+        : std::is_integral<T>::value ? (std::is_signed<T>::value ? 0x100 : 0x200) | sizeof(T)
+        : 0;
+};
+
+template <typename T>
+struct TypeTag<std::complex<T>> {
+    static constexpr std::uint32_t value = 0x400 | sizeof(std::complex<T>);
+};
+
+enum class Kind : std::uint8_t { vector = 1, matrix = 2 };
+
+struct FileHeader {
+    char magic[4];
+    std::uint16_t version;
+    std::uint8_t kind;
+    std::uint8_t reserved0;
+    std::uint32_t byteOrder;        // kByteOrder as the writer stored it
+    std::uint32_t typeTag;
+    std::uint32_t elementSize;
+    std::uint32_t reserved1;
+    std::uint64_t rows;             // vectors: size
+    std::uint64_t cols;             // vectors: 1
+    std::uint64_t payloadBytes;
+    std::uint64_t checksum;         // Checksum of the payload
+    std::uint64_t reserved2;
+};
+static_assert(sizeof(FileHeader) == 64, "file header must stay 64 bytes");
+
+constexpr char kFileMagic[4] = {'D', 'S', 'A', '\x1a'};
+constexpr std::uint16_t kFileVersion = 1;
+constexpr std::uint32_t kByteOrder = 0x01020304;
+
+// 64-bit checksum, four independent multiply-rotate lanes over 32-byte
+// blocks (the xxHash64 round), so it runs at memory speed.
+// update() may be called piecewise; the result only depends on the bytes.
+class Checksum {
+    static constexpr std::uint64_t kPrime1 = 0x9E3779B185EBCA87ull;
+    static constexpr std::uint64_t kPrime2 = 0xC2B2AE3D27D4EB4Full;
+
+    std::uint64_t lane[4] = {kPrime1 + kPrime2, kPrime2, 0, 0 - kPrime1};
+    unsigned char pending[32];
+    std::size_t buffered{0};
+    std::uint64_t total{0};
+
+    static std::uint64_t rotl(std::uint64_t x, int r){ return (x << r) | (x >> (64 - r)); }
+
+    static std::uint64_t round(std::uint64_t acc, std::uint64_t word){
+        return rotl(acc + word * kPrime2, 31) * kPrime1;
+    }
+
+    void block(const unsigned char* p){
+        for (int j = 0; j < 4; j++) {
+            std::uint64_t word;
+            std::memcpy(&word, p + 8 * j, 8);
+            lane[j] = round(lane[j], word);
+        }
+    }
+
+public:
+    void update(const void* data, std::size_t n){
+        if (n == 0) {
+            return;
+        }
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        total += n;
+        if (buffered > 0) {
+            std::size_t take = std::min(n, sizeof(pending) - buffered);
+            std::memcpy(pending + buffered, p, take);
+            buffered += take;
+            p += take;
+            n -= take;
+            if (buffered < sizeof(pending)) {
+                return;
+            }
+            block(pending);
+            buffered = 0;
+        }
+        for (; n >= 32; p += 32, n -= 32) {
+            block(p);
+        }
+        std::memcpy(pending, p, n);
+        buffered = n;
+    }
+
+    std::uint64_t value() const {
+        std::uint64_t h = rotl(lane[0], 1) + rotl(lane[1], 7) + rotl(lane[2], 12) + rotl(lane[3], 18);
+        h ^= total * kPrime1;
+        for (std::size_t k = 0; k < buffered; k++) {
+            h = rotl(h ^ (pending[k] * kPrime2), 11) * kPrime1;
+        }
+        h ^= h >> 33;
+        h *= kPrime2;
+        h ^= h >> 29;
+        return h;
+    }
+};
+
+template <typename T>
+FileHeader makeHeader(Kind kind, std::uint64_t rows, std::uint64_t cols, std::uint64_t checksum){
+    FileHeader h{};
+    std::memcpy(h.magic, kFileMagic, sizeof(kFileMagic));
+    h.version = kFileVersion;
+    h.kind = static_cast<std::uint8_t>(kind);
+    h.byteOrder = kByteOrder;
+    h.typeTag = TypeTag<T>::value;
+    h.elementSize = sizeof(T);
+    h.rows = rows;
+    h.cols = cols;
+    h.payloadBytes = rows * cols * sizeof(T);
+    h.checksum = checksum;
+    return h;
+}
+
+// throw std::runtime_error unless h describes kind of T
+template <typename T>
+void checkHeader(const FileHeader& h, Kind kind){
+    if (std::memcmp(h.magic, kFileMagic, sizeof(kFileMagic)) != 0) {
+        throw std::runtime_error("not a dsa binary file");
+    }
+    // before the version: from the other byte order every field reads swapped
+    if (h.byteOrder != kByteOrder) {
+        throw std::runtime_error("dsa file was written with the other byte order");
+    }
+    if (h.version != kFileVersion) {
+        throw std::runtime_error("unsupported dsa file version");
+    }
+    if (h.kind != static_cast<std::uint8_t>(kind)) {
+        throw std::runtime_error(kind == Kind::vector ? "dsa file does not hold a vector"
+                                                      : "dsa file does not hold a matrix");
+    }
+    if (h.elementSize != sizeof(T) || h.typeTag != TypeTag<T>::value) {
+        throw std::runtime_error("dsa file holds another element type");
+    }
+    if (h.cols != 0 && h.rows > std::numeric_limits<std::uint64_t>::max() / h.cols / sizeof(T)) {
+        throw std::runtime_error("dsa file header is corrupt");
+    }
+    if (h.payloadBytes != h.rows * h.cols * sizeof(T)) {
+        throw std::runtime_error("dsa file header is corrupt");
+    }
+}
+
+inline FileHeader readHeader(std::istream& in){
+    FileHeader h;
+    if (!in.read(reinterpret_cast<char*>(&h), sizeof(h))) {
+        throw std::runtime_error("dsa file is truncated");
+    }
+    return h;
+}
+
+inline void readBytes(std::istream& in, void* dst, std::size_t n){
+    if (n > 0 && !in.read(static_cast<char*>(dst), static_cast<std::streamsize>(n))) {
+        throw std::runtime_error("dsa file is truncated");
+    }
+}
+
+// throw unless in still holds h.payloadBytes, so a corrupt size cannot
+// trigger a huge allocation; streams that cannot seek are not checked
+// (the read itself still reports truncation)
+inline void checkPayloadAvailable(std::istream& in, const FileHeader& h){
+    std::streambuf* buf = in.rdbuf();
+    if (buf == nullptr) {
+        return;
+    }
+    const std::streampos here = buf->pubseekoff(0, std::ios::cur, std::ios::in);
+    if (here == std::streampos(-1)) {
+        return;
+    }
+    const std::streampos end = buf->pubseekoff(0, std::ios::end, std::ios::in);
+    buf->pubseekpos(here, std::ios::in);
+    if (end != std::streampos(-1) && static_cast<std::uint64_t>(end - here) < h.payloadBytes) {
+        throw std::runtime_error("dsa file is truncated");
+    }
+}
+
+inline void writeBytes(std::ostream& out, const void* src, std::size_t n){
+    if (n > 0 && !out.write(static_cast<const char*>(src), static_cast<std::streamsize>(n))) {
+        throw std::runtime_error("writing dsa file failed");
+    }
+}
+
+inline void verifyChecksum(const Checksum& sum, const FileHeader& h){
+    if (sum.value() != h.checksum) {
+        throw std::runtime_error("dsa file checksum mismatch");
+    }
+}
+
+} // namespace detail
+
+// write v to out: header, then the elements in one write
+//   throw std::runtime_error if the stream fails
+template <typename T, typename A, std::size_t N, typename G>
+void save(const Vector<T, A, N, G>& v, std::ostream& out){
+    static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable elements are saved as bytes");
+    const T* p = v.size() > 0 ? &v[0] : nullptr;
+    detail::Checksum sum;
+    sum.update(p, v.size() * sizeof(T));
+    detail::FileHeader h = detail::makeHeader<T>(detail::Kind::vector, v.size(), 1, sum.value());
+    detail::writeBytes(out, &h, sizeof(h));
+    detail::writeBytes(out, p, v.size() * sizeof(T));
+}
+
+// write m to out: header, then the rows packed (padding dropped)
+//   one write when the rows are not padded
+template <typename T, typename A>
+void save(const BasicMatrix<T, A>& m, std::ostream& out){
+    static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable elements are saved as bytes");
+    const std::size_t rows = m.getRows();
+    const std::size_t cols = m.getCols();
+    const bool packed = m.getStride() == cols;
+    detail::Checksum sum;
+    if (packed) {
+        sum.update(rows > 0 ? m.row(0) : nullptr, rows * cols * sizeof(T));
+    } else {
+        for (std::size_t i = 0; i < rows; i++) {
+            sum.update(m.row(i), cols * sizeof(T));
+        }
+    }
+    detail::FileHeader h = detail::makeHeader<T>(detail::Kind::matrix, rows, cols, sum.value());
+    detail::writeBytes(out, &h, sizeof(h));
+    if (packed) {
+        detail::writeBytes(out, rows > 0 ? m.row(0) : nullptr, rows * cols * sizeof(T));
+    } else {
+        for (std::size_t i = 0; i < rows; i++) {
+            detail::writeBytes(out, m.row(i), cols * sizeof(T));
+        }
+    }
+}
+
+// replace v with a vector saved by save(); elements come in with one read
+//   throw std::runtime_error on a malformed, truncated or corrupt file
+//   (v is left empty then)
+template <typename T, typename A, std::size_t N, typename G>
+void load(std::istream& in, Vector<T, A, N, G>& v){
+    static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable elements are loaded as bytes");
+    detail::FileHeader h = detail::readHeader(in);
+    detail::checkHeader<T>(h, detail::Kind::vector);
+    if (h.rows > Vector<T, A, N, G>::max_size()) {
+        throw std::runtime_error("dsa file holds more elements than a Vector can");
+    }
+    detail::checkPayloadAvailable(in, h);
+    std::size_t n = static_cast<std::size_t>(h.rows);
+    v.clear();
+    v.resize_for_overwrite(n);   // no per-element pass: the read fills it
+    try {
+        T* p = n > 0 ? &v[0] : nullptr;
+        detail::readBytes(in, p, n * sizeof(T));
+        detail::Checksum sum;
+        sum.update(p, n * sizeof(T));
+        detail::verifyChecksum(sum, h);
+    } catch (...) {
+        v.clear();
+        throw;
+    }
+}
+
+// replace m with a matrix saved by save(); rows get m's default padding
+//   one read when the rows are not padded, otherwise one per row
+//   throw std::runtime_error on a malformed, truncated or corrupt file
+//   (m is unchanged then)
+template <typename T, typename A>
+void load(std::istream& in, BasicMatrix<T, A>& m){
+    static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable elements are loaded as bytes");
+    using Matrix = BasicMatrix<T, A>;
+    detail::FileHeader h = detail::readHeader(in);
+    detail::checkHeader<T>(h, detail::Kind::matrix);
+    const auto limit = static_cast<std::uint64_t>(std::numeric_limits<typename Matrix::difference_type>::max());
+    if (h.rows > limit || h.cols > limit) {
+        throw std::runtime_error("dsa file holds a matrix too large to load");
+    }
+    detail::checkPayloadAvailable(in, h);
+    Matrix loaded(static_cast<typename Matrix::difference_type>(h.rows),
+                  static_cast<typename Matrix::difference_type>(h.cols), Matrix::kDefaultRowAlign,
+                  m.getAllocator());
+    const std::size_t rows = loaded.getRows();
+    const std::size_t cols = loaded.getCols();
+    detail::Checksum sum;
+    if (loaded.getStride() == cols) {
+        T* p = rows > 0 ? loaded.row(0) : nullptr;
+        detail::readBytes(in, p, rows * cols * sizeof(T));
+        sum.update(p, rows * cols * sizeof(T));
+    } else {
+        for (std::size_t i = 0; i < rows; i++) {
+            detail::readBytes(in, loaded.row(i), cols * sizeof(T));
+            sum.update(loaded.row(i), cols * sizeof(T));
+        }
+    }
+    detail::verifyChecksum(sum, h);
+    m = std::move(loaded);
+}
+
+// save(x, file at path), replacing the file
+//   throw std::runtime_error if it cannot be written
+template <typename X>
+void saveFile(const std::string& path, const X& x){
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("cannot open " + path + " for writing");
+    }
+    save(x, out);
+    out.flush();
+    if (!out) {
+        throw std::runtime_error("writing " + path + " failed");
+    }
+}
+
+// load(file at path, x)
+//   throw std::runtime_error if it cannot be read or is not a file of x's type
+template <typename X>
+void loadFile(const std::string& path, X& x){
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("cannot open " + path);
+    }
+    load(in, x);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+
+// Read-only, zero-copy view of a file written by save()/saveFile(): the
+// file is mapped and the elements are used where they lie. Opening is O(1);
+// pages are read on first touch. verify() checks the checksum (one pass).
+// Vectors are rows() x 1.
+//
+//   dsa::MappedArray<double> w("weights.dsa");
+//   double x = w(i, j);
+template <typename T>
+class MappedArray {
+    static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable elements can be mapped");
+
+    void* base{nullptr};
+    std::size_t bytes{0};
+    detail::FileHeader h{};
+
+    const T* elements() const {
+        return reinterpret_cast<const T*>(static_cast<const unsigned char*>(base) + sizeof(detail::FileHeader));
+    }
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using const_iterator = const T*;
+
+    // map the file at path
+    //   throw std::runtime_error if it cannot be opened or is not a saved
+    //   Vector/Matrix of T
+    explicit MappedArray(const std::string& path){
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("cannot open " + path);
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(detail::FileHeader)) {
+            ::close(fd);
+            throw std::runtime_error("dsa file is truncated");
+        }
+        bytes = static_cast<std::size_t>(st.st_size);
+        base = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);    // the mapping keeps the file open
+        if (base == MAP_FAILED) {
+            base = nullptr;
+            throw std::runtime_error("cannot map " + path);
+        }
+        std::memcpy(&h, base, sizeof(h));
+        try {
+            detail::Kind kind = h.kind == static_cast<std::uint8_t>(detail::Kind::vector) ? detail::Kind::vector
+                                                                                         : detail::Kind::matrix;
+            detail::checkHeader<T>(h, kind);
+            if (bytes - sizeof(h) < h.payloadBytes) {
+                throw std::runtime_error("dsa file is truncated");
+            }
+        } catch (...) {
+            ::munmap(base, bytes);
+            throw;
+        }
+    }
+
+    MappedArray(const MappedArray&) = delete;
+    MappedArray& operator=(const MappedArray&) = delete;
+
+    MappedArray(MappedArray&& other) noexcept : base(other.base), bytes(other.bytes), h(other.h) {
+        other.base = nullptr;
+        other.bytes = 0;
+    }
+
+    ~MappedArray(){
+        if (base != nullptr) {
+            ::munmap(base, bytes);
+        }
+    }
+
+    bool isMatrix() const { return h.kind == static_cast<std::uint8_t>(detail::Kind::matrix); }
+    size_type getRows() const { return static_cast<size_type>(h.rows); }
+    size_type getCols() const { return static_cast<size_type>(h.cols); }
+    size_type size() const { return static_cast<size_type>(h.rows * h.cols); }
+
+    const T* data() const { return elements(); }
+    const T& operator[](size_type i) const { return elements()[i]; }
+    //elements()[i*cols + j] // no bounds check
+    const T& operator()(size_type i, size_type j) const { return elements()[i * h.cols + j]; }
+    const T* row(size_type i) const { return elements() + i * h.cols; }
+
+    const_iterator begin() const { return elements(); }
+    const_iterator end() const { return elements() + size(); }
+
+    // does the payload still match the checksum written with it?
+    bool verify() const {
+        detail::Checksum sum;
+        sum.update(elements(), static_cast<std::size_t>(h.payloadBytes));
+        return sum.value() == h.checksum;
+    }
+};
+
+#endif
+
+} // namespace dsa
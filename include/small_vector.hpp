@@ -0,0 +1,23 @@
+//include/small_vector.hpp
+#pragma once
+
+// SmallVector<T, N>: a dsa::Vector whose first N elements are stored inside
+// the object, so collections that stay at or below N never allocate. Past N
+// it spills to Allocator like any Vector, and shrinking back to N or less
+// (shrink, shrink_to_fit) returns the elements to the inline buffer.
+// The API and iterators are Vector's own.
+//
+//   dsa::SmallVector<int, 8> v;   // up to 8 ints without touching the heap
+
+#include "vector.hpp"
+
+#include <cstddef>  // std::size_t
+#include <memory>   // std::allocator
+
+namespace dsa{
+
+template <typename T, std::size_t N, typename Allocator = std::allocator<T>,
+          typename GrowthPolicy = DefaultGrowth>
+using SmallVector = Vector<T, Allocator, N, GrowthPolicy>;
+
+} // namespace dsa
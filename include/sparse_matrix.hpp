@@ -0,0 +1,492 @@
+//include/sparse_matrix.hpp
+#pragma once
+
+// SparseMatrix<T>: a matrix that stores only its non-zero entries, for
+// matrices that are mostly zeros. Three layouts:
+//
+//   coo  (i, j, value) triples in any order, duplicates allowed; for building
+//   csr  compressed rows: row i's entries are offsets[i] .. offsets[i + 1],
+//        sorted by column; fast SpMV and row access
+//   csc  compressed columns, the same by column; fast column access
+//
+//   dsa::SparseMatrix<double> a(1000, 1000);   // empty, COO
+//   a.insert(3, 7, 2.5);
+//   ...
+//   auto m = a.toCSR();                        // sorted, duplicates summed
+//   dsa::Vector<double> y = m * x;             // SpMV
+//
+// Conversion to CSR or CSC sorts with two counting-sort passes (O(nnz +
+// rows + cols), no comparisons), sums duplicates and drops entries that
+// sum to zero. Arithmetic takes any layout: addition of two sparse
+// matrices gives CSR (CSC if both are CSC), sparse * dense and SpMV walk
+// the entries in place, and sparse * sparse gives CSR.
+//
+// Indices are Index (32-bit by default, half the footprint of size_t);
+// rows and cols must fit in it. Row/column offsets are size_t, so nnz may
+// exceed it.
+
+#include <algorithm>    // std::lower_bound, std::sort
+#include <cstddef>      // std::size_t, std::ptrdiff_t
+#include <cstdint>      // std::uint32_t
+#include <limits>       // std::numeric_limits
+#include <stdexcept>    // std::out_of_range, std::length_error, std::logic_error
+#include <utility>      // std::move
+
+#include "execution.hpp"
+#include "kernels.hpp"
+#include "matrix.hpp"
+#include "vector.hpp"
+
+namespace dsa{
+
+enum class SparseFormat { coo, csr, csc };
+
+template <typename T, typename Index = std::uint32_t>
+class SparseMatrix {
+public:
+    using value_type = T;
+    using index_type = Index;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+private:
+    size_type rows{0};
+    size_type cols{0};
+    SparseFormat layout{SparseFormat::coo};
+    // coo: outer[k] = row of entry k (offsets unused)
+    // csr: offsets[i] .. offsets[i + 1] index row i's entries (outer unused)
+    // csc: the same per column
+    dsa::Vector<size_type> offsets;
+    dsa::Vector<Index> outer;
+    dsa::Vector<Index> inner;      // coo, csr: column; csc: row
+    dsa::Vector<T> values;
+
+    SparseMatrix(size_type r, size_type c, SparseFormat f) : rows(r), cols(c), layout(f) {}
+
+    void check(size_type i, size_type j) const {
+        if (i >= rows || j >= cols) {
+            throw std::out_of_range("Invalid Index");
+        }
+    }
+
+    // rows, cols, or the entries of a compressed row/column
+    size_type majorCount() const {
+        return layout == SparseFormat::csc ? cols : rows;
+    }
+
+    // entries (maj[k], mnr[k], val[k]) -> compressed by major, sorted by minor,
+    // duplicates summed, zeros dropped
+    //   pass 1: counting sort of the entries by minor
+    //   pass 2: stable counting sort of that order by major
+    //   then one merge pass over the sorted order
+    static SparseMatrix compress(size_type r, size_type c, SparseFormat f,
+                                 const dsa::Vector<Index>& maj, const dsa::Vector<Index>& mnr,
+                                 const dsa::Vector<T>& val){
+        SparseMatrix result(r, c, f);
+        size_type nmajor = f == SparseFormat::csc ? c : r;
+        size_type nminor = f == SparseFormat::csc ? r : c;
+        size_type n = val.size();
+
+        dsa::Vector<size_type> by_minor = countingOrder(mnr, nminor, nullptr);
+        dsa::Vector<size_type> order = countingOrder(maj, nmajor, &by_minor);
+
+        result.offsets.resize(nmajor + 1, 0);
+        result.inner.reserve(n);
+        result.values.reserve(n);
+        size_type k = 0;
+        for (size_type m = 0; m < nmajor; m++) {
+            while (k < n && maj[order[k]] == m) {
+                Index idx = mnr[order[k]];
+                T sum = val[order[k]];
+                for (k++; k < n && maj[order[k]] == m && mnr[order[k]] == idx; k++) {
+                    sum = sum + val[order[k]];
+                }
+                if (!(sum == T())) {
+                    result.inner.push_back(idx);
+                    result.values.push_back(std::move(sum));
+                }
+            }
+            result.offsets[m + 1] = result.values.size();
+        }
+        return result;
+    }
+
+    // positions 0..n-1 (or the permutation `within`) stably ordered by key
+    static dsa::Vector<size_type> countingOrder(const dsa::Vector<Index>& key, size_type buckets,
+                                                const dsa::Vector<size_type>* within){
+        size_type n = key.size();
+        dsa::Vector<size_type> start;
+        start.resize(buckets + 1, 0);
+        for (size_type k = 0; k < n; k++) {
+            start[static_cast<size_type>(key[k]) + 1]++;
+        }
+        for (size_type b = 0; b < buckets; b++) {
+            start[b + 1] += start[b];
+        }
+        dsa::Vector<size_type> order;
+        order.resize(n);
+        for (size_type k = 0; k < n; k++) {
+            size_type e = within ? (*within)[k] : k;
+            order[start[key[e]]++] = e;
+        }
+        return order;
+    }
+
+    // this matrix as COO arrays (rows, cols, values), any layout
+    void triples(dsa::Vector<Index>& r, dsa::Vector<Index>& c, dsa::Vector<T>& v) const {
+        r.clear();
+        c.clear();
+        r.reserve(nonZeros());
+        c.reserve(nonZeros());
+        forEach([&](size_type i, size_type j, const T&){
+            r.push_back(static_cast<Index>(i));
+            c.push_back(static_cast<Index>(j));
+        });
+        v = values;
+    }
+
+    void requireSameShape(size_type r, size_type c) const {
+        if (rows != r || cols != c) {
+            throw std::out_of_range("dimensions must match"); //must match dimensions for element-wise ops
+        }
+    }
+
+public:
+    /*
+    if r < 0 OR c < 0
+        throw std::out_of_range("Negative dimensions");
+    if r or c does not fit in Index
+        throw std::length_error("SparseMatrix too large");
+    no entries, COO layout
+    */
+    SparseMatrix(difference_type r, difference_type c){
+        if (r < 0 || c < 0) {
+            throw std::out_of_range("Negative dimensions");
+        }
+        if (static_cast<size_type>(r) > std::numeric_limits<Index>::max() ||
+            static_cast<size_type>(c) > std::numeric_limits<Index>::max()) {
+            throw std::length_error("SparseMatrix too large");
+        }
+        rows = static_cast<size_type>(r);
+        cols = static_cast<size_type>(c);
+    }
+
+    // the non-zero elements of a dense matrix, in layout f
+    template <typename A>
+    static SparseMatrix fromDense(const BasicMatrix<T, A>& m, SparseFormat f = SparseFormat::csr){
+        SparseMatrix result(static_cast<difference_type>(m.getRows()), static_cast<difference_type>(m.getCols()));
+        for (size_type i = 0; i < m.getRows(); i++) {
+            const T* r = m.row(i);
+            for (size_type j = 0; j < m.getCols(); j++) {
+                if (!(r[j] == T())) {
+                    result.insert(i, j, r[j]);
+                }
+            }
+        }
+        // row-major scan: already CSR order, no sort needed
+        if (f == SparseFormat::csr) {
+            result.layout = SparseFormat::csr;
+            result.offsets.resize(result.rows + 1, 0);
+            for (size_type k = 0; k < result.outer.size(); k++) {
+                result.offsets[static_cast<size_type>(result.outer[k]) + 1]++;
+            }
+            for (size_type i = 0; i < result.rows; i++) {
+                result.offsets[i + 1] += result.offsets[i];
+            }
+            result.outer.clear();
+            result.outer.shrink_to_fit();
+            return result;
+        }
+        return f == SparseFormat::csc ? result.toCSC() : result;
+    }
+
+    // append (i, j) = v to a COO matrix; repeated (i, j) add up on conversion
+    //   throw std::out_of_range("Invalid Index") if i >= rows or j >= cols
+    //   throw std::logic_error if the matrix is not COO (convert with toCOO)
+    // amortized O(1)
+    void insert(size_type i, size_type j, const T& v){
+        check(i, j);
+        if (layout != SparseFormat::coo) {
+            throw std::logic_error("insert needs COO format");
+        }
+        outer.push_back(static_cast<Index>(i));
+        inner.push_back(static_cast<Index>(j));
+        values.push_back(v);
+    }
+
+    // room for n entries without reallocating (COO building)
+    void reserve(size_type n){
+        values.reserve(n);
+        inner.reserve(n);
+        if (layout == SparseFormat::coo) {
+            outer.reserve(n);
+        }
+    }
+
+    SparseMatrix toCOO() const {
+        SparseMatrix result(rows, cols, SparseFormat::coo);
+        triples(result.outer, result.inner, result.values);
+        return result;
+    }
+
+    // sorted by row then column, duplicates summed, zeros dropped
+    // O(nnz + rows + cols)
+    SparseMatrix toCSR() const {
+        if (layout == SparseFormat::csr) {
+            return *this;
+        }
+        dsa::Vector<Index> r, c;
+        dsa::Vector<T> v;
+        triples(r, c, v);
+        return compress(rows, cols, SparseFormat::csr, r, c, v);
+    }
+
+    // sorted by column then row, duplicates summed, zeros dropped
+    SparseMatrix toCSC() const {
+        if (layout == SparseFormat::csc) {
+            return *this;
+        }
+        dsa::Vector<Index> r, c;
+        dsa::Vector<T> v;
+        triples(r, c, v);
+        return compress(rows, cols, SparseFormat::csc, c, r, v);
+    }
+
+    template <typename A = AlignedAllocator<T, 64>>
+    BasicMatrix<T, A> toDense() const {
+        BasicMatrix<T, A> result(static_cast<difference_type>(rows), static_cast<difference_type>(cols));
+        forEach([&](size_type i, size_type j, const T& v){ result.unchecked(i, j) = result.unchecked(i, j) + v; });
+        return result;
+    }
+
+    // f(i, j, value) for every stored entry, in storage order
+    template <typename F>
+    void forEach(F f) const {
+        if (layout == SparseFormat::coo) {
+            for (size_type k = 0; k < values.size(); k++) {
+                f(static_cast<size_type>(outer[k]), static_cast<size_type>(inner[k]), values[k]);
+            }
+            return;
+        }
+        bool by_row = layout == SparseFormat::csr;
+        for (size_type m = 0; m < majorCount(); m++) {
+            for (size_type k = offsets[m]; k < offsets[m + 1]; k++) {
+                size_type other = static_cast<size_type>(inner[k]);
+                if (by_row) {
+                    f(m, other, values[k]);
+                } else {
+                    f(other, m, values[k]);
+                }
+            }
+        }
+    }
+
+    //element (i, j), T() where nothing is stored
+    //  throw std::out_of_range("Invalid Index") if i >= rows or j >= cols
+    //O(log nnz-per-row) for CSR/CSC (binary search), O(nnz) for COO
+    T operator()(size_type i, size_type j) const {
+        check(i, j);
+        if (layout == SparseFormat::coo) {
+            T sum = T();
+            for (size_type k = 0; k < values.size(); k++) {
+                if (outer[k] == i && inner[k] == j) {
+                    sum = sum + values[k];
+                }
+            }
+            return sum;
+        }
+        size_type m = layout == SparseFormat::csr ? i : j;
+        Index key = static_cast<Index>(layout == SparseFormat::csr ? j : i);
+        if (offsets[m] == offsets[m + 1]) {
+            return T();
+        }
+        const Index* first = &inner[offsets[m]];
+        const Index* last = first + (offsets[m + 1] - offsets[m]);
+        const Index* at = std::lower_bound(first, last, key);
+        return at != last && *at == key ? values[offsets[m] + static_cast<size_type>(at - first)] : T();
+    }
+
+    //y = (*this) * x; x has cols elements
+    //  csr: y[i] = sum of v * x[j] over row i (rows spread over the policy's pool)
+    //  csc, coo: y[i] += v * x[j] entry by entry, on the caller
+    //  throw std::out_of_range("dimensions must match") if x.size() != cols
+    template <typename Policy = execution::sequenced_policy>
+    dsa::Vector<T> multiply(const dsa::Vector<T>& x, const Policy& policy = Policy()) const {
+        if (x.size() != cols) {
+            throw std::out_of_range("dimensions must match");
+        }
+        dsa::Vector<T> y;
+        y.resize(rows, T());
+        if (rows == 0 || cols == 0) {
+            return y;
+        }
+        const T* xs = &x[0];
+        T* ys = &y[0];
+        if (layout == SparseFormat::csr) {
+            policy.getPool().parallel_for(0, rows, policy.getGrain(), [&](size_type i){
+                T sum = T();
+                for (size_type k = offsets[i]; k < offsets[i + 1]; k++) {
+                    sum = sum + values[k] * xs[inner[k]];
+                }
+                ys[i] = sum;
+            });
+        } else {
+            forEach([&](size_type i, size_type j, const T& v){ ys[i] = ys[i] + v * xs[j]; });
+        }
+        return y;
+    }
+
+    //C = (*this) * B, dense B (cols x n), dense C (rows x n)
+    //  every entry (i, j, v) adds v * B.row(j) to C.row(i) (kernels::axpy)
+    //  csr: rows of C spread over the policy's pool; others on the caller
+    //  throw std::out_of_range("dimensions must match") if cols != B.rows
+    template <typename A, typename Policy = execution::sequenced_policy>
+    BasicMatrix<T, A> multiply(const BasicMatrix<T, A>& B, const Policy& policy = Policy()) const {
+        if (cols != B.getRows()) {
+            throw std::out_of_range("dimensions must match");
+        }
+        size_type n = B.getCols();
+        BasicMatrix<T, A> C(static_cast<difference_type>(rows), static_cast<difference_type>(n),
+                            BasicMatrix<T, A>::kDefaultRowAlign, B.getAllocator());
+        if (n == 0 || rows == 0) {
+            return C;
+        }
+        if (layout == SparseFormat::csr) {
+            policy.getPool().parallel_for(0, rows, policy.getGrain(), [&](size_type i){
+                for (size_type k = offsets[i]; k < offsets[i + 1]; k++) {
+                    kernels::axpy<T>(values[k], B.row(inner[k]), C.row(i), n);
+                }
+            });
+        } else {
+            forEach([&](size_type i, size_type j, const T& v){ kernels::axpy<T>(v, B.row(j), C.row(i), n); });
+        }
+        return C;
+    }
+
+    //C = (*this) * B, both sparse; C is CSR
+    //  Gustavson: row i of C accumulates v * (row j of B) for each (i, j, v)
+    //  in a dense scratch row, then its touched columns are sorted and kept
+    //  throw std::out_of_range("dimensions must match") if cols != B.rows
+    SparseMatrix multiply(const SparseMatrix& B) const {
+        if (cols != B.rows) {
+            throw std::out_of_range("dimensions must match");
+        }
+        const SparseMatrix a = toCSR();
+        const SparseMatrix b = B.toCSR();
+        SparseMatrix C(rows, B.cols, SparseFormat::csr);
+        C.offsets.resize(rows + 1, 0);
+
+        dsa::Vector<T> acc;
+        acc.resize(B.cols, T());
+        dsa::Vector<size_type> mark;                 // row + 1 that last touched column j
+        mark.resize(B.cols, 0);
+        dsa::Vector<Index> touched;
+        for (size_type i = 0; i < rows; i++) {
+            touched.clear();
+            for (size_type ka = a.offsets[i]; ka < a.offsets[i + 1]; ka++) {
+                size_type j = a.inner[ka];
+                for (size_type kb = b.offsets[j]; kb < b.offsets[j + 1]; kb++) {
+                    Index c = b.inner[kb];
+                    if (mark[c] != i + 1) {
+                        mark[c] = i + 1;
+                        acc[c] = T();
+                        touched.push_back(c);
+                    }
+                    acc[c] = acc[c] + a.values[ka] * b.values[kb];
+                }
+            }
+            std::sort(touched.begin(), touched.end());
+            for (size_type t = 0; t < touched.size(); t++) {
+                if (!(acc[touched[t]] == T())) {
+                    C.inner.push_back(touched[t]);
+                    C.values.push_back(acc[touched[t]]);
+                }
+            }
+            C.offsets[i + 1] = C.values.size();
+        }
+        return C;
+    }
+
+    dsa::Vector<T> operator*(const dsa::Vector<T>& x) const { return multiply(x); }
+
+    template <typename A>
+    BasicMatrix<T, A> operator*(const BasicMatrix<T, A>& B) const { return multiply(B); }
+
+    SparseMatrix operator*(const SparseMatrix& B) const { return multiply(B); }
+
+    //(*this) + other, both sparse
+    //  merge of the two sorted rows (columns if both are CSC) per row;
+    //  entries that cancel are dropped
+    //  throw std::out_of_range("dimensions must match")
+    SparseMatrix operator+(const SparseMatrix& other) const {
+        requireSameShape(other.rows, other.cols);
+        SparseFormat f = layout == SparseFormat::csc && other.layout == SparseFormat::csc
+                       ? SparseFormat::csc : SparseFormat::csr;
+        const SparseMatrix a = f == SparseFormat::csr ? toCSR() : *this;
+        const SparseMatrix b = f == SparseFormat::csr ? other.toCSR() : other;
+        SparseMatrix result(rows, cols, f);
+        size_type nmajor = a.majorCount();
+        result.offsets.resize(nmajor + 1, 0);
+        result.inner.reserve(a.nonZeros() + b.nonZeros());
+        result.values.reserve(a.nonZeros() + b.nonZeros());
+        for (size_type m = 0; m < nmajor; m++) {
+            size_type ka = a.offsets[m], ea = a.offsets[m + 1];
+            size_type kb = b.offsets[m], eb = b.offsets[m + 1];
+            while (ka < ea || kb < eb) {
+                if (kb == eb || (ka < ea && a.inner[ka] < b.inner[kb])) {
+                    result.inner.push_back(a.inner[ka]);
+                    result.values.push_back(a.values[ka++]);
+                } else if (ka == ea || b.inner[kb] < a.inner[ka]) {
+                    result.inner.push_back(b.inner[kb]);
+                    result.values.push_back(b.values[kb++]);
+                } else {
+                    T sum = a.values[ka++] + b.values[kb];
+                    if (!(sum == T())) {
+                        result.inner.push_back(b.inner[kb]);
+                        result.values.push_back(sum);
+                    }
+                    kb++;
+                }
+            }
+            result.offsets[m + 1] = result.values.size();
+        }
+        return result;
+    }
+
+    //(*this) + dense: a copy of dense with the entries added in
+    //  throw std::out_of_range("dimensions must match")
+    template <typename A>
+    BasicMatrix<T, A> operator+(const BasicMatrix<T, A>& dense) const {
+        requireSameShape(dense.getRows(), dense.getCols());
+        BasicMatrix<T, A> result(dense);
+        forEach([&](size_type i, size_type j, const T& v){ result.unchecked(i, j) = result.unchecked(i, j) + v; });
+        return result;
+    }
+
+    SparseFormat format() const { return layout; }
+    size_type getRows() const { return rows; }
+    size_type getCols() const { return cols; }
+
+    // stored entries (for COO, duplicates count separately)
+    size_type nonZeros() const { return values.size(); }
+
+    // bytes held by the index and value arrays
+    size_type memoryBytes() const {
+        return offsets.capacity() * sizeof(size_type) + (outer.capacity() + inner.capacity()) * sizeof(Index) +
+               values.capacity() * sizeof(T);
+    }
+
+    // raw arrays, as described at the top of the class
+    const dsa::Vector<size_type>& getOffsets() const { return offsets; }
+    const dsa::Vector<Index>& getOuter() const { return outer; }
+    const dsa::Vector<Index>& getInner() const { return inner; }
+    const dsa::Vector<T>& getValues() const { return values; }
+};
+
+// dense + sparse == sparse + dense
+template <typename T, typename A, typename Index>
+BasicMatrix<T, A> operator+(const BasicMatrix<T, A>& dense, const SparseMatrix<T, Index>& sparse){
+    return sparse + dense;
+}
+
+} // namespace dsa
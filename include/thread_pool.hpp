@@ -0,0 +1,332 @@
+//include/thread_pool.hpp
+#pragma once
+
+#include <algorithm>           // std::min, std::max
+#include <atomic>              // std::atomic
+#include <chrono>              // std::chrono::microseconds
+#include <condition_variable>  // std::condition_variable
+#include <cstddef>             // std::size_t
+#include <deque>               // std::deque
+#include <exception>           // std::exception_ptr
+#include <functional>          // std::function
+#include <memory>              // std::unique_ptr
+#include <mutex>               // std::mutex
+#include <thread>              // std::thread
+#include <utility>             // std::move
+#include <vector>              // std::vector
+
+#if defined(__linux__)
+#include <pthread.h>           // pthread_setaffinity_np
+#include <sched.h>             // cpu_set_t, CPU_SET
+#endif
+
+namespace dsa{
+
+// Work-stealing pool: every worker owns a deque of tasks. A worker pops its
+// own newest task (LIFO, so forked work stays in cache) and, when it runs
+// dry, steals the oldest task of another worker (FIFO, the biggest pieces
+// of a split range). Tasks submitted from outside the pool are dealt out
+// round-robin.
+//
+// parallel_for is fork/join: the range is halved recursively, one half
+// pushed for others to steal and the other kept, down to grain indices.
+// The calling thread works too and, while it waits for the join, runs
+// queued tasks instead of blocking; so a pool with 0 workers runs
+// everything inline, and nested calls cannot deadlock.
+//
+// With Affinity::pinned each worker is bound to one CPU (Linux; elsewhere
+// the hint is ignored).
+class ThreadPool {
+public:
+    using size_type = std::size_t;
+
+    enum class Affinity { none, pinned };
+
+private:
+    using Task = std::function<void()>;
+
+    struct Queue {
+        std::mutex lock;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;   // one per worker
+    std::vector<std::thread> workers;
+    std::atomic<size_type> queued{0};             // tasks in all queues
+    std::atomic<size_type> nextQueue{0};          // round-robin for outside pushes
+    std::mutex sleepLock;
+    std::condition_variable wake;
+    bool stopping{false};                         // guarded by sleepLock
+    bool isPinned{false};
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    // which pool and worker the current thread is (npos: not a worker)
+    struct Self {
+        const ThreadPool* pool{nullptr};
+        size_type index{npos};
+    };
+
+    static Self& self(){
+        thread_local Self s;
+        return s;
+    }
+
+    size_type myIndex() const {
+        return self().pool == this ? self().index : npos;
+    }
+
+    void push(Task task){
+        size_type i = myIndex();
+        if (i == npos) {
+            i = nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+        }
+        queued.fetch_add(1);    // before the task is visible, so the count never wraps
+        {
+            std::lock_guard<std::mutex> guard(queues[i]->lock);
+            queues[i]->tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> guard(sleepLock);   // no lost wake-up
+        }
+        wake.notify_one();
+    }
+
+    // own newest task, else the oldest of another worker
+    bool tryRun(size_type me){
+        Task task;
+        size_type n = queues.size();
+        if (me != npos) {
+            Queue& q = *queues[me];
+            std::lock_guard<std::mutex> guard(q.lock);
+            if (!q.tasks.empty()) {
+                task = std::move(q.tasks.back());
+                q.tasks.pop_back();
+            }
+        }
+        size_type start = me == npos ? nextQueue.load(std::memory_order_relaxed) : me + 1;
+        for (size_type k = 0; !task && k < n; k++) {
+            Queue& q = *queues[(start + k) % n];
+            std::lock_guard<std::mutex> guard(q.lock);
+            if (!q.tasks.empty()) {
+                task = std::move(q.tasks.front());
+                q.tasks.pop_front();
+            }
+        }
+        if (!task) {
+            return false;
+        }
+        queued.fetch_sub(1);
+        task();
+        return true;
+    }
+
+    void workerLoop(size_type me){
+        self().pool = this;
+        self().index = me;
+        for (;;) {
+            if (tryRun(me)) {
+                continue;
+            }
+            std::unique_lock<std::mutex> guard(sleepLock);
+            wake.wait(guard, [this]{ return stopping || queued.load() > 0; });
+            if (stopping && queued.load() == 0) {
+                return;
+            }
+        }
+    }
+
+    // bind t to cpu; false where that is not supported
+    static bool pin(std::thread& t, size_type cpu){
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(static_cast<int>(cpu), &set);
+        return pthread_setaffinity_np(t.native_handle(), sizeof(set), &set) == 0;
+#else
+        (void)t;
+        (void)cpu;
+        return false;
+#endif
+    }
+
+    // state of one parallel_for: outstanding pieces and the first error
+    struct Join {
+        std::atomic<size_type> pending{1};
+        std::mutex lock;
+        std::condition_variable finished;
+        std::exception_ptr error;
+
+        void fail(){
+            std::lock_guard<std::mutex> guard(lock);
+            if (!error) error = std::current_exception();
+        }
+
+        // under the lock, so the waiter cannot see 0 and destroy *this
+        // while the last piece is still notifying
+        void done(){
+            std::lock_guard<std::mutex> guard(lock);
+            if (pending.fetch_sub(1) == 1) {
+                finished.notify_all();
+            }
+        }
+    };
+
+    // run body on [b, e): fork the upper half while it is above grain
+    template <typename Body>
+    void forkJoin(size_type b, size_type e, size_type grain, Body& body, Join& join){
+        while (e - b > grain) {
+            size_type mid = b + (e - b) / 2;
+            join.pending.fetch_add(1);
+            push([this, mid, e, grain, &body, &join]{ forkJoin(mid, e, grain, body, join); });
+            e = mid;
+        }
+        try {
+            for (size_type i = b; i < e; i++) {
+                body(i);
+            }
+        } catch (...) {
+            join.fail();
+        }
+        join.done();
+    }
+
+public:
+    // threads = number of workers besides the caller
+    explicit ThreadPool(size_type threads, Affinity affinity = Affinity::none){
+        queues.reserve(threads);
+        for (size_type t = 0; t < threads; t++) {
+            queues.emplace_back(new Queue);
+        }
+        size_type cpus = std::max(1u, std::thread::hardware_concurrency());
+        isPinned = affinity == Affinity::pinned && threads > 0;
+        workers.reserve(threads);
+        for (size_type t = 0; t < threads; t++) {
+            workers.emplace_back([this, t]{ workerLoop(t); });
+            if (affinity == Affinity::pinned) {
+                isPinned = pin(workers.back(), (t + 1) % cpus) && isPinned;   // cpu 0 is left to the caller
+            }
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // finishes the queued tasks, then joins the workers
+    ~ThreadPool(){
+        {
+            std::lock_guard<std::mutex> guard(sleepLock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& t : workers) {
+            t.join();
+        }
+    }
+
+    // worker threads, not counting the caller
+    size_type size() const {
+        return workers.size();
+    }
+
+    // threads that take part in a parallel_for
+    size_type concurrency() const {
+        return workers.size() + 1;
+    }
+
+    // were the workers bound to CPUs?
+    bool pinned() const {
+        return isPinned;
+    }
+
+    // run task on some worker (or inline if there are none)
+    // task should not throw: an exception reaches whichever thread ran it,
+    // the submitter with no workers, a parallel_for caller that was helping
+    // (once its own pieces are done), or std::terminate on a worker
+    void submit(std::function<void()> task){
+        if (workers.empty()) {
+            task();
+            return;
+        }
+        push(std::move(task));
+    }
+
+    // indices per piece when the caller does not say: about 8 pieces per
+    // thread, enough to even out irregular work
+    size_type defaultGrain(size_type n) const {
+        return std::max<size_type>(1, n / (8 * concurrency()));
+    }
+
+    // body(i) for every i in [begin, end); returns when all calls finished
+    // pieces of at most grain indices run as one task (0 = defaultGrain)
+    // the first exception thrown by body is rethrown here
+    template <typename Body>
+    void parallel_for(size_type begin, size_type end, size_type grain, Body body){
+        if (begin >= end) {
+            return;
+        }
+        size_type n = end - begin;
+        if (grain == 0) {
+            grain = defaultGrain(n);
+        }
+        if (n <= grain || workers.empty()) {
+            for (size_type i = begin; i < end; i++) {
+                body(i);
+            }
+            return;
+        }
+
+        Join join;
+        forkJoin(begin, end, grain, body, join);
+
+        // help until every piece is done; our pieces never throw out of a
+        // task, so an exception here is from someone else's submit() and is
+        // held until join and body are no longer referenced
+        size_type me = myIndex();
+        std::exception_ptr foreign;
+        while (join.pending.load() != 0) {
+            bool ran = false;
+            try {
+                ran = tryRun(me);
+            } catch (...) {
+                if (!foreign) foreign = std::current_exception();
+                ran = true;
+            }
+            if (!ran) {
+                std::unique_lock<std::mutex> guard(join.lock);
+                join.finished.wait_for(guard, std::chrono::microseconds(50),
+                                       [&]{ return join.pending.load() == 0; });
+            }
+        }
+        // the last piece may still be inside done(): wait for it to let go
+        // of the lock before join goes out of scope
+        {
+            std::lock_guard<std::mutex> guard(join.lock);
+        }
+        if (join.error) {
+            std::rethrow_exception(join.error);
+        }
+        if (foreign) {
+            std::rethrow_exception(foreign);
+        }
+    }
+
+    template <typename Body>
+    void parallel_for(size_type begin, size_type end, Body body){
+        parallel_for(begin, end, 0, std::move(body));
+    }
+
+    // process-wide pool sized to the hardware
+    static ThreadPool& global(){
+        static ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+        return pool;
+    }
+
+    // no workers: everything runs on the calling thread
+    static ThreadPool& inlinePool(){
+        static ThreadPool pool(0);
+        return pool;
+    }
+};
+
+}
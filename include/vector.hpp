@@ -1,32 +1,539 @@
 #pragma once
 
-#include <algorithm>  // std::max
-#include <utility>    // std::move
-#include <stdexcept>  // std::out_of_range
+#include <algorithm>    // std::max, std::min, std::copy, std::fill, std::move
+#include <cstddef>      // std::size_t, std::ptrdiff_t
+#include <cstring>      // std::memcpy, std::memcmp
+#include <iterator>     // std::random_access_iterator_tag, std::reverse_iterator
+#include <limits>       // std::numeric_limits
+#include <memory>       // std::allocator, std::allocator_traits
+#include <type_traits>  // std::is_trivially_copyable, std::is_empty
+#include <utility>      // std::move, std::forward, std::swap
+#include <stdexcept>    // std::out_of_range, std::length_error
+
+#include "growth_policy.hpp"
+#include "vector_stats.hpp"
 
 namespace dsa{
 
+namespace detail{
+
+template <typename...>
+struct MakeVoid { using type = void; };
+
+template <typename... Ts>
+using VoidT = typename MakeVoid<Ts...>::type;
+
+// A::is_always_equal if it says so, otherwise "A has no state"
+// (the C++17 allocator_traits rule)
+template <typename A, typename = void>
+struct AlwaysEqual : std::is_empty<A> {};
+
+template <typename A>
+struct AlwaysEqual<A, VoidT<typename A::is_always_equal>> : A::is_always_equal {};
+
+// does A customize construct/destroy of T?
+template <typename A, typename T, typename = void>
+struct HasConstruct : std::false_type {};
+
+template <typename A, typename T>
+struct HasConstruct<A, T, VoidT<decltype(std::declval<A&>().construct(std::declval<T*>(), std::declval<T&&>()))>>
+    : std::true_type {};
+
+template <typename A, typename T, typename = void>
+struct HasDestroy : std::false_type {};
+
+template <typename A, typename T>
+struct HasDestroy<A, T, VoidT<decltype(std::declval<A&>().destroy(std::declval<T*>()))>> : std::true_type {};
+
+// A builds and destroys T exactly like placement new / ~T(), so trivial
+// element types can be memcpy'd and their destructors skipped
+template <typename A, typename T>
+struct PlainLifetime
+    : std::integral_constant<bool, std::is_same<A, std::allocator<T>>::value ||
+                                   (!HasConstruct<A, T>::value && !HasDestroy<A, T>::value)> {};
+
+// does A hand out zero-filled blocks (A::allocate_zeroed, e.g. AlignedAllocator)?
+template <typename A, typename = void>
+struct HasAllocateZeroed : std::false_type {};
+
+template <typename A>
+struct HasAllocateZeroed<A, VoidT<decltype(std::declval<A&>().allocate_zeroed(std::size_t{}))>> : std::true_type {};
+
+// is T() represented by all zero bytes?
 template <typename T>
-class Vector {
+struct ZeroIsAllBits
+    : std::integral_constant<bool, std::is_arithmetic<T>::value || std::is_pointer<T>::value ||
+                                   std::is_enum<T>::value> {};
+
+// holds the allocator; stateless allocators take no space (empty base)
+template <typename A, bool = std::is_empty<A>::value && !std::is_final<A>::value>
+class AllocatorHolder : private A {
+public:
+    AllocatorHolder() = default;
+    AllocatorHolder(const A& a) : A(a) {}
+    AllocatorHolder(A&& a) : A(std::move(a)) {}
+    A& alloc() { return *this; }
+    const A& alloc() const { return *this; }
+};
+
+template <typename A>
+class AllocatorHolder<A, false> {
+    A a;
+public:
+    AllocatorHolder() = default;
+    AllocatorHolder(const A& x) : a(x) {}
+    AllocatorHolder(A&& x) : a(std::move(x)) {}
+    A& alloc() { return a; }
+    const A& alloc() const { return a; }
+};
+
+// pointers, and iterators that declare is_contiguous (Vector's own)
+template <typename It, typename = void>
+struct IsContiguous : std::is_pointer<It> {};
+
+template <typename It>
+struct IsContiguous<It, VoidT<typename It::is_contiguous>> : It::is_contiguous {};
+
+// storage for the first N elements inside the Vector object itself
+template <typename T, std::size_t N>
+class InlineBuffer {
+    alignas(T) unsigned char buf[N * sizeof(T)];
+public:
+    T* inlineData() { return reinterpret_cast<T*>(buf); }
+    const T* inlineData() const { return reinterpret_cast<const T*>(buf); }
+};
+
+// N == 0: no buffer, no space (empty base)
+template <typename T>
+class InlineBuffer<T, 0> {
+public:
+    T* inlineData() { return nullptr; }
+    const T* inlineData() const { return nullptr; }
+};
+
+} // namespace detail
+
+// Allocator follows std::allocator_traits: storage comes from
+// allocate/deallocate, elements are made with construct/destroy, and the
+// propagate_on_container_* flags decide whether the allocator follows the
+// elements on copy assignment, move assignment and swap.
+//
+// With InlineCapacity N > 0 the first N elements live inside the object and
+// the allocator is only used once the size exceeds N (see small_vector.hpp);
+// N == 0 is the plain heap vector and costs nothing extra.
+//
+// GrowthPolicy decides how far capacity grows when full and when
+// pop_back/erase give memory back (see growth_policy.hpp).
+//
+// Built with DSA_VECTOR_STATS=1, every Vector counts its allocations and
+// element moves (see vector_stats.hpp); otherwise stats() is all zeros.
+template <typename T, typename Allocator = std::allocator<T>, std::size_t InlineCapacity = 0,
+          typename GrowthPolicy = DefaultGrowth>
+class Vector : private detail::AllocatorHolder<Allocator>,
+               private detail::InlineBuffer<T, InlineCapacity>,
+               private detail::StatsHolder<Vector<T, Allocator, InlineCapacity, GrowthPolicy>> {
+
+private:
+    using holder = detail::AllocatorHolder<Allocator>;
+    using stats_holder = detail::StatsHolder<Vector>;
+    using stats_holder::countAllocation;
+    using stats_holder::countReallocation;
+    using stats_holder::countShrink;
+    using stats_holder::countMoved;
+    using stats_holder::countCopied;
+    using alloc_traits = std::allocator_traits<Allocator>;
+    using holder::alloc;
+    using detail::InlineBuffer<T, InlineCapacity>::inlineData;
+
+    static_assert(std::is_same<typename alloc_traits::value_type, T>::value,
+                  "Allocator::value_type must be T");
+    static_assert(std::is_same<typename alloc_traits::pointer, T*>::value,
+                  "Vector stores raw T*; fancy allocator pointers are not supported");
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;          // 64-bit on LP64, > 2^31 elements
+    using difference_type = std::ptrdiff_t;
+
+    static constexpr size_type inline_capacity = InlineCapacity;
 
 private:
-    int cap{0};       // capacity of the array
-    int sz{0};        // number of actual entries
-    T* data{nullptr}; // pointer to array of elements
+    size_type cap{InlineCapacity};  // capacity of the array
+    size_type sz{0};   // number of actual entries
+    T* data{inlineData()}; // pointer to raw storage; only [0, sz) is constructed
+
+    // storage is the inline buffer (never true when InlineCapacity == 0)
+    bool isInline() const {
+        return InlineCapacity != 0 && data == inlineData();
+    }
+
+    // empty, pointing at the inline buffer (or nothing)
+    void resetStorage(){
+        cap = InlineCapacity;
+        sz = 0;
+        data = inlineData();
+    }
+
+    using plain_lifetime = detail::PlainLifetime<Allocator, T>;
+
+    // raw storage for n elements, nothing is constructed
+    T* allocate(size_type n){
+        if (n > max_size()) {
+            throw std::length_error("Vector capacity exceeds max_size");
+        }
+        T* p = alloc_traits::allocate(alloc(), n);
+        countAllocation(n, n * sizeof(T));
+        return p;
+    }
+
+    // release raw storage of n elements (elements must already be destroyed)
+    // the inline buffer is not the allocator's and is left alone
+    void deallocate(T* p, size_type n){
+        if (p != nullptr && p != inlineData()) {
+            alloc_traits::deallocate(alloc(), p, n);
+        }
+    }
+
+    // construct *p from args
+    template <typename... Args>
+    void construct(T* p, Args&&... args){
+        alloc_traits::construct(alloc(), p, std::forward<Args>(args)...);
+    }
+
+    // run destructors on [0, n)
+    void destroy(T* p, size_type n){
+        if (!(plain_lifetime::value && std::is_trivially_destructible<T>::value)) {
+            for (size_type k = 0; k < n; k++) {
+                alloc_traits::destroy(alloc(), p + k);
+            }
+        }
+    }
+
+    // trivially copyable elements can be moved around with memcpy/memmove
+    using bitwise = std::integral_constant<bool, plain_lifetime::value && std::is_trivially_copyable<T>::value>;
+
+    // construct n elements in dst from src (moved if that cannot throw,
+    // copied otherwise); src stays alive
+    // trivially copyable T is a single memcpy
+    void uninitializedMove(T* src, size_type n, T* dst, std::true_type){
+        if (n > 0) {
+            std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), sizeof(T) * n);
+        }
+        countMoved(n);
+    }
+
+    void uninitializedMove(T* src, size_type n, T* dst, std::false_type){
+        size_type k = 0;
+        try {
+            for (; k < n; k++) {
+                construct(dst + k, std::move_if_noexcept(src[k]));
+            }
+        } catch (...) {
+            destroy(dst, k); // src is untouched when copying
+            throw;
+        }
+        countRelocated(n);
+    }
+
+    // n elements went through move_if_noexcept
+    void countRelocated(size_type n){
+        if (std::is_nothrow_move_constructible<T>::value || !std::is_copy_constructible<T>::value) {
+            countMoved(n);
+        } else {
+            countCopied(n);
+        }
+    }
+
+    void uninitializedMove(T* src, size_type n, T* dst){
+        uninitializedMove(src, n, dst, bitwise{});
+    }
+
+    // construct n elements in dst from src, then destroy src
+    void relocate(T* src, size_type n, T* dst){
+        uninitializedMove(src, n, dst);
+        if (!bitwise::value) {
+            destroy(src, n);
+        }
+    }
+
+    // capacity to grow to when full: GrowthPolicy::grow (double by
+    // default), saturating at max_size()
+    //   if cap==max_size(): throw std::length_error
+    size_type grown_capacity() const {
+        if (cap >= max_size()) {
+            throw std::length_error("Vector at max_size");
+        }
+        return GrowthPolicy::grow(cap, max_size());
+    }
+
+    // iterators over contiguous T's in memory
+    template <typename It>
+    using contiguous = std::integral_constant<bool, detail::IsContiguous<It>::value &&
+        std::is_same<typename std::iterator_traits<It>::value_type, T>::value>;
+
+    // construct n elements at raw dst from [first, first+n); on a throw the
+    // ones already built are destroyed
+    template <typename It>
+    void constructRange(T* dst, It first, size_type n, std::true_type){
+        if (n > 0) {
+            std::memcpy(static_cast<void*>(dst), static_cast<const void*>(&*first), sizeof(T) * n);
+        }
+    }
+
+    template <typename It>
+    void constructRange(T* dst, It first, size_type n, std::false_type){
+        size_type k = 0;
+        try {
+            for (; k < n; ++k, ++first) {
+                construct(dst + k, *first);
+            }
+        } catch (...) {
+            destroy(dst, k);
+            throw;
+        }
+    }
+
+    template <typename It>
+    void constructRange(T* dst, It first, size_type n){
+        constructRange(dst, first, n, std::integral_constant<bool, bitwise::value && contiguous<It>::value>{});
+    }
+
+    // an empty vector can take a zeroed block from the allocator in place of
+    // constructing value element by element, when value is all zero bytes
+    using zero_fill = std::integral_constant<bool, plain_lifetime::value && detail::ZeroIsAllBits<T>::value &&
+                                                   detail::HasAllocateZeroed<Allocator>::value>;
+
+    // resize(n, value) as one zeroed allocation; false if that does not apply
+    // (not empty, enough capacity already, or value is not zero bits, e.g. -0.0)
+    bool resizeZeroed(size_type n, const T& value, std::true_type){
+        const T zero = T();
+        if (sz != 0 || n <= cap || std::memcmp(&value, &zero, sizeof(T)) != 0) {
+            return false;
+        }
+        if (n > max_size()) {
+            throw std::length_error("Vector capacity exceeds max_size");
+        }
+        T* fresh = alloc().allocate_zeroed(n);
+        countAllocation(n, n * sizeof(T));
+        deallocate(data, cap);
+        data = fresh;
+        cap = n;
+        sz = n;
+        return true;
+    }
+
+    bool resizeZeroed(size_type, const T&, std::false_type){
+        return false;
+    }
+
+    // bitwise T: claim the slots, construct nothing
+    void resizeForOverwrite(size_type n, std::true_type){
+        if (n > sz) {
+            reserve(n);
+        }
+        sz = n;   // trivially copyable, so trivially destructible: no tail to destroy
+    }
+
+    void resizeForOverwrite(size_type n, std::false_type){
+        resize(n);
+    }
+
+    // n copies of value at raw dst
+    void constructFill(T* dst, size_type n, const T& value){
+        size_type k = 0;
+        try {
+            for (; k < n; k++) {
+                construct(dst + k, value);
+            }
+        } catch (...) {
+            destroy(dst, k);
+            throw;
+        }
+    }
+
+    // move [i, sz) to [i+n, sz+n), leaving [i, i+n) raw; one memmove for
+    // bitwise T, otherwise move-construct from the back (T's move is noexcept here)
+    void shiftRight(size_type i, size_type n){
+        countMoved(sz - i);
+        if (bitwise::value) {
+            std::memmove(static_cast<void*>(data + i + n), static_cast<const void*>(data + i), sizeof(T) * (sz - i));
+            return;
+        }
+        for (size_type k = sz; k-- > i;) {
+            construct(data + k + n, std::move(data[k]));
+            destroy(data + k, 1);
+        }
+    }
+
+    // undo shiftRight(i, n)
+    void shiftLeft(size_type i, size_type n){
+        countMoved(sz - i);
+        if (bitwise::value) {
+            std::memmove(static_cast<void*>(data + i), static_cast<const void*>(data + i + n), sizeof(T) * (sz - i));
+            return;
+        }
+        for (size_type k = i; k < sz; k++) {
+            construct(data + k, std::move(data[k + n]));
+            destroy(data + k + n, 1);
+        }
+    }
+
+    // open n raw slots at i and fill them with make(T* slots): one shift and
+    // at most one reallocation. When reallocating, make runs before the old
+    // block is touched, so it may read elements of *this.
+    template <typename Make>
+    void insertGap(size_type i, size_type n, Make make){
+        if (n == 0) {
+            return;
+        }
+        if (n > max_size() - sz) {
+            throw std::length_error("Vector capacity exceeds max_size");
+        }
+        if (sz + n <= cap && (bitwise::value || std::is_nothrow_move_constructible<T>::value)) {
+            shiftRight(i, n);
+            try {
+                make(data + i);
+            } catch (...) {
+                shiftLeft(i, n);
+                throw;
+            }
+            sz += n;
+            return;
+        }
+
+        size_type new_cap = sz + n;
+        if (new_cap > cap) {
+            new_cap = std::max(new_cap, grown_capacity());
+        } else {
+            new_cap = cap;   // fits, but T's move may throw: copy into a fresh block
+        }
+        T* block = allocate(new_cap);
+        try {
+            make(block + i);
+            try {
+                // copy-or-move both halves before destroying anything
+                uninitializedMove(data, i, block);
+                try {
+                    uninitializedMove(data + i, sz - i, block + i + n);
+                } catch (...) {
+                    destroy(block, i);
+                    throw;
+                }
+            } catch (...) {
+                destroy(block + i, n);
+                throw;
+            }
+        } catch (...) {
+            deallocate(block, new_cap);
+            throw;
+        }
+        if (!bitwise::value) {
+            destroy(data, sz);
+        }
+        deallocate(data, cap);
+        data = block;
+        cap = new_cap;
+        sz += n;
+        countReallocation();
+    }
+
+    template <typename It>
+    void assignRange(It first, It last, std::forward_iterator_tag){
+        size_type n = static_cast<size_type>(std::distance(first, last));
+        if (n > cap) {
+            if (n > max_size()) {
+                throw std::length_error("Vector capacity exceeds max_size");
+            }
+            T* block = allocate(n);
+            try {
+                constructRange(block, first, n);
+            } catch (...) {
+                deallocate(block, n);
+                throw;
+            }
+            release();
+            data = block;
+            cap = n;
+            sz = n;
+            return;
+        }
+        size_type common = std::min(n, sz);
+        It mid = first;
+        std::advance(mid, common);
+        std::copy(first, mid, data);
+        if (n > sz) {
+            constructRange(data + sz, mid, n - sz);
+        } else {
+            destroy(data + n, sz - n);
+        }
+        sz = n;
+    }
+
+    template <typename It>
+    void assignRange(It first, It last, std::input_iterator_tag){
+        clear();
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+
+    // insert [first, last) at i
+    template <typename It>
+    void insertRange(size_type i, It first, It last, std::forward_iterator_tag){
+        size_type n = static_cast<size_type>(std::distance(first, last));
+        insertGap(i, n, [&](T* dst){ constructRange(dst, first, n); });
+    }
+
+    // single pass: buffer first unless appending
+    template <typename It>
+    void insertRange(size_type i, It first, It last, std::input_iterator_tag){
+        if (i == sz) {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+            return;
+        }
+        Vector tmp(alloc());
+        for (; first != last; ++first) {
+            tmp.emplace_back(*first);
+        }
+        insertGap(i, tmp.sz, [&](T* dst){ constructRange(dst, std::make_move_iterator(tmp.data), tmp.sz); });
+    }
 
 public:
     // empty - O(1)
     Vector() = default;
+
+    // empty, drawing storage from a
+    explicit Vector(const Allocator& a) : holder(a) {}
+
+    // copy of the allocator in use
+    allocator_type get_allocator() const {
+        return alloc();
+    }
+
+    // this object's allocation/move counts (all zero unless built with
+    // DSA_VECTOR_STATS=1; the per-type totals are in VectorStatsRegistry)
+    VectorStats stats() const {
+        return stats_holder::stats();
+    }
     
     //capacity - O(1)
-    int capacity() const {
+    size_type capacity() const {
         return cap;
     }
 
     //elements stored
-    int size() const {
+    size_type size() const {
         return sz;
     }
+
+    //largest element count the storage can be sized to
+    //(bytes must fit in ptrdiff_t so pointer differences stay defined)
+    static constexpr size_type max_size() {
+        return static_cast<size_type>(std::numeric_limits<difference_type>::max()) / sizeof(T);
+    }
     
     //return (sz == 0)
     //O(1)
@@ -37,14 +544,14 @@ public:
     //element at index when vector is const (unchecked)
     //return data[i] // no bounds check
     //O(1)
-    const T& operator[](int i) const { 
+    const T& operator[](size_type i) const { 
         return data[i];
     }
     
     //element at index when vector is non-const (unchecked)
     //return data[i] // no bounds check
     //O(1)
-    T& operator[](int i) { 
+    T& operator[](size_type i) { 
         return data[i];
     }
     
@@ -52,8 +559,8 @@ public:
     //if invalid index 
     //throw std::out_of_range("Invalid Index");
     //return data[i] after checking bounds
-    const T& at(int i) const{
-        if (i < 0 || i >= sz)
+    const T& at(size_type i) const{
+        if (i >= sz) // negative indices wrap around to huge values
         {
             throw std::out_of_range("Invalid Index");
         }
@@ -64,8 +571,8 @@ public:
     //if invalid index 
     //throw std::out_of_range("Invalid Index");
     //return data[i] after checking bounds
-    T& at(int i){
-        if (i < 0 || i >= sz)
+    T& at(size_type i){
+        if (i >= sz) // negative indices wrap around to huge values
         {
             throw std::out_of_range("Invalid Index");
         }
@@ -101,49 +608,120 @@ public:
     }
     
     // insert at end
-    // double array size
-    //   if sz==cap: reserve(max(1, 2*cap))
-    //   data[sz] = elem
+    // grow array per GrowthPolicy (saturating at max_size())
+    //   if sz==cap: reserve(grown_capacity())  // 2*cap by default
+    //   construct data[sz] from elem
     //   sz++
     //Amortized O(1); worst-case O(n)
     void push_back(const T& elem){
+        emplace_back(elem);
+    }
+
+    // insert at end, stealing elem's resources
+    void push_back(T&& elem){
+        emplace_back(std::move(elem));
+    }
+
+    // construct a new last element in place from args
+    //   if sz==cap: grow to grown_capacity() (max(1, 2*cap) by default)
+    //   construct data[sz] from args...
+    //   sz++
+    //Amortized O(1); worst-case O(n)
+    template <typename... Args>
+    T& emplace_back(Args&&... args){
         if (sz == cap)
         {
-            reserve(std::max(1, 2 * cap)); // inc cap
+            // build the new element before relocating, args may refer into data
+            size_type new_cap = grown_capacity(); // inc cap
+            T* new_array = allocate(new_cap);
+            try {
+                construct(new_array + sz, std::forward<Args>(args)...);
+                try {
+                    relocate(data, sz, new_array);
+                } catch (...) {
+                    destroy(new_array + sz, 1);
+                    throw;
+                }
+            } catch (...) {
+                deallocate(new_array, new_cap);
+                throw;
+            }
+            deallocate(data, cap);
+            data = new_array;
+            cap = new_cap;
+            countReallocation();
+        }
+        else
+        {
+            construct(data + sz, std::forward<Args>(args)...);
         }
-        data[sz] = elem;
         sz++;
+        return data[sz - 1];
     }
 
     // remove from end
     //   if sz==0 -> throw
+    //   destroy data[sz-1]
     //   sz--
     //   shrink()
     // O(1) (shrink can be O(n) when it triggers)
     void pop_back() { 
+        if (sz == 0)
+        {
+            throw std::out_of_range("pop_back on empty Vector");
+        }
+        destroy(data + sz - 1, 1);
         sz--;
         Vector::shrink();
     }
 
     // insert at index
     //   if i<0 or i>sz -> throw
-    //   if sz==cap: reserve(max(1, 2*cap))
+    //   if sz==cap: reserve(grown_capacity())  // 2*cap by default
     //   shift right
     //   data[i] = elem
     //   sz++
     // Complexity: O(n-i) moves + possible O(n) reallocation
-    void insert(int i, const T& elem){
+    void insert(size_type i, const T& elem){
+        emplace(i, elem);
+    }
+
+    // insert at index, moving elem into place
+    void insert(size_type i, T&& elem){
+        emplace(i, std::move(elem));
+    }
+
+    // construct an element from args and place it at index i
+    //   if i==sz: emplace_back
+    //   build tmp from args (args may alias an element that is about to move)
+    //   if sz==cap: reserve(grown_capacity())  // 2*cap by default
+    //   move-construct data[sz] from data[sz-1], move-assign the rest right
+    //   data[i] = move(tmp)
+    //   sz++
+    // Complexity: O(n-i) moves + possible O(n) reallocation
+    template <typename... Args>
+    void emplace(size_type i, Args&&... args){
+        if (i == sz)
+        {
+            emplace_back(std::forward<Args>(args)...);
+            return;
+        }
+        T tmp(std::forward<Args>(args)...);
+
         if (sz == cap)
         {
-            reserve(std::max(1, 2 * cap)); // inc cap
+            reserve(grown_capacity()); // inc cap
         }
 
-        for (int k = sz - 1; k >= i; k--)
+        // slot sz is raw storage, construct it from the last element
+        countMoved(sz - i);
+        construct(data + sz, std::move(data[sz - 1]));
+        for (size_type k = sz - 1; k > i; k--)
         { // from the right, move left until i. shift elements right
-            data[k + 1] = data[k];
+            data[k] = std::move(data[k - 1]);
         }
 
-        data[i] = elem;
+        data[i] = std::move(tmp);
         sz++;
     }
 
@@ -153,308 +731,685 @@ public:
     //   sz--
     //   shrink()
     // Complexity: O(n-i) moves; shrink may reallocate O(n)
-    void erase(int i){
-        for (int k = i + 1; k < sz; k++)
+    void erase(size_type i){
+        if (i >= sz) // negative indices wrap around to huge values
+        {
+            throw std::out_of_range("Invalid Index");
+        }
+        countMoved(sz - i - 1);
+        for (size_type k = i + 1; k < sz; k++)
         {
-            data[k - 1] = data[k]; // shifts elements over left
+            data[k - 1] = std::move(data[k]); // shifts elements over left
         }
+        destroy(data + sz - 1, 1);
         sz--;
         shrink();
     }
 
+    // insert [first, last) before index i
+    //   one shift of the tail and at most one reallocation
+    //   (memmove/memcpy for trivially copyable T)
+    //   [first, last) must not point into *this unless i == size()
+    // Complexity: O(n - i + k) for k forward-iterator elements
+    template <typename InputIt, typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+    void insert(size_type i, InputIt first, InputIt last){
+        insertRange(i, first, last, typename std::iterator_traits<InputIt>::iterator_category{});
+    }
+
+    // insert count copies of value before index i (value may alias an element)
+    void insert(size_type i, size_type count, const T& value){
+        if (count == 0) {
+            return;
+        }
+        T fill(value);
+        insertGap(i, count, [&](T* dst){ constructFill(dst, count, fill); });
+    }
+
+    // append every element of r (anything with begin/end, including *this)
+    template <typename Range>
+    void append(const Range& r){
+        using std::begin;
+        using std::end;
+        insert(sz, begin(r), end(r));
+    }
+
+    // removes indices [first, last)
+    //   one shift of the tail (memmove for trivially copyable T)
+    //   destroy the vacated tail, sz -= last - first
+    //   shrink()
+    // Complexity: O(n - first)
+    void erase(size_type first, size_type last){
+        if (first >= last) {
+            return;
+        }
+        size_type n = last - first;
+        countMoved(sz - last);
+        if (bitwise::value) {
+            std::memmove(static_cast<void*>(data + first), static_cast<const void*>(data + last),
+                         sizeof(T) * (sz - last));
+        } else {
+            std::move(data + last, data + sz, data + first);
+            destroy(data + sz - n, n);
+        }
+        sz -= n;
+        shrink();
+    }
+
+    // destroy every element; capacity is kept
+    void clear(){
+        destroy(data, sz);
+        sz = 0;
+    }
+
+    // replace the contents with [first, last)
+    //   forward iterators: at most one allocation, existing elements are
+    //   assigned over rather than rebuilt
+    template <typename InputIt, typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+    void assign(InputIt first, InputIt last){
+        assignRange(first, last, typename std::iterator_traits<InputIt>::iterator_category{});
+    }
+
+    // replace the contents with count copies of value
+    void assign(size_type count, const T& value){
+        T fill(value);
+        if (count > cap) {
+            clear();
+            reallocate(count);
+        }
+        size_type common = std::min(count, sz);
+        std::fill(data, data + common, fill);
+        if (count > sz) {
+            constructFill(data + sz, count - sz, fill);
+        } else {
+            destroy(data + count, sz - count);
+        }
+        sz = count;
+    }
+
     //capacity >= minimum
     //if cap < minimum:
-    // create new array and move elements
+    // allocate raw storage and relocate elements (no default construction)
     // O(n) when reallocation else O(1)
-    void reserve(int minimum){
+    void reserve(size_type minimum){
         if (cap < minimum)
         {
-            T *new_array = new T[minimum];
-            for (int k = 0; k < sz; k++)
-            {
-                new_array[k] = data[k];
-            }
-            delete[] data;
-            data = new_array;
-            cap = minimum;
+            reallocate(minimum);
         }    
     }
 
+    // set the size to n
+    //   if n<sz: destroy the tail (capacity is kept)
+    //   if empty, value is zero and the allocator has allocate_zeroed:
+    //     one zeroed block, nothing written (lazily zeroed OS pages)
+    //   else: reserve(n) once, then copy-construct value into [sz, n)
+    // O(|n - sz|) plus at most one reallocation
+    void resize(size_type n, const T& value = T()){
+        if (n <= sz)
+        {
+            destroy(data + n, sz - n);
+            sz = n;
+            return;
+        }
+        if (resizeZeroed(n, value, zero_fill{})) {
+            return;
+        }
+        T fill(value); // value may live in data
+        reserve(n);
+        for (; sz < n; sz++)
+        {
+            construct(data + sz, fill);
+        }
+    }
+
+    // set the size to n, leaving new elements uninitialized when T is
+    // trivially copyable and the allocator constructs by plain placement
+    // (otherwise the same as resize(n)); the caller writes [old size, n)
+    // before reading it, e.g. one bulk read straight into the storage
+    // at most one reallocation, O(1) otherwise
+    void resize_for_overwrite(size_type n){
+        resizeForOverwrite(n, bitwise{});
+    }
+
     // nested iterator class
+    // A plain element pointer: random access (and contiguous in the C++20
+    // sense), so std::sort, std::lower_bound, std::copy and friends take
+    // their pointer-speed paths. Invalidated by any reallocation.
     class iterator {
         // needed by Vector's insert and erase
         friend class Vector;
         
         private:
-            Vector* vec;
-            int ind;   // index within the vector
+            T* ptr;   // element this iterator refers to
         public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = T*;
+            using reference = T&;
+            using is_contiguous = std::true_type;   // elements are adjacent in memory
+
             // constructor
-            iterator(Vector* v=nullptr, int i=-1){ 
-                vec=v; ind=i; 
+            explicit iterator(T* p=nullptr){ 
+                ptr = p;
             }
 
-            //return this->vec->[this->ind];
+            //return *ptr
             T& operator*() const {
-                // ToDo
-                return vec->data[ind];
+                return *ptr;
             }
 
-            // return address of this->vec->[this->ind];
+            // return ptr
             T* operator->() const { 
-                // ToDo
-                return &vec->data[ind];
+                return ptr;
+            }
+
+            //return ptr[n]
+            T& operator[](difference_type n) const {
+                return ptr[n];
             }
 
             //pre increment overloaded without param
-            //ind++; return *this
+            //ptr++; return *this
             iterator& operator++(){
-                // ToDo
-                ind++;
+                ptr++;
                 return *this;
             }
 
             //post increment overloaded with parameter
-            //old=*this; ind++; return old
+            //old=*this; ptr++; return old
             iterator operator++(int){ 
-                // ToDo
                 iterator old = *this;
-                ind++;
+                ptr++;
                 return old;
             }
 
             //pre decrementr overloaded without param
-            //ind--; return *this
+            //ptr--; return *this
             iterator& operator--(){
-                // ToDo
-                ind--;
+                ptr--;
                 return *this;
             }
             
             //post decrement overloaded with parameter
-            //old=*this; ind--; return old
+            //old=*this; ptr--; return old
             iterator operator--(int){
-                // ToDo
                 iterator old = *this;
-                ind--;
+                ptr--;
                 return old;
             }
 
-            //return vec==rhs.vec && ind==rhs.ind
+            //ptr += n; return *this
+            iterator& operator+=(difference_type n){
+                ptr += n;
+                return *this;
+            }
+
+            //ptr -= n; return *this
+            iterator& operator-=(difference_type n){
+                ptr -= n;
+                return *this;
+            }
+
+            friend iterator operator+(iterator it, difference_type n){ return it += n; }
+            friend iterator operator+(difference_type n, iterator it){ return it += n; }
+            friend iterator operator-(iterator it, difference_type n){ return it -= n; }
+
+            //elements between the two positions
+            friend difference_type operator-(iterator a, iterator b){ return a.ptr - b.ptr; }
+
+            //return ptr==rhs.ptr
             bool operator==(iterator rhs) const{
-                // ToDo
-                return (vec == rhs.vec) && (ind == rhs.ind);
+                return ptr == rhs.ptr;
             }
 
             //return !(*this == rhs)
             bool operator!=(iterator rhs) const{
-                // ToDo
                 return !(*this == rhs);
             }
+
+            bool operator<(iterator rhs) const{ return ptr < rhs.ptr; }
+            bool operator>(iterator rhs) const{ return ptr > rhs.ptr; }
+            bool operator<=(iterator rhs) const{ return ptr <= rhs.ptr; }
+            bool operator>=(iterator rhs) const{ return ptr >= rhs.ptr; }
     };
 
     // nested const_iterator class
     class const_iterator {
+        friend class Vector;
+
         private:
-            const Vector* vec;
-            int ind;   // index within the vector
+            const T* ptr;   // element this iterator refers to
         
         public:
-            const_iterator(const Vector* v=nullptr, int i=-1){
-                vec = v; ind=i;
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T*;
+            using reference = const T&;
+            using is_contiguous = std::true_type;
+
+            explicit const_iterator(const T* p=nullptr){
+                ptr = p;
             }
 
-            //return vec->data[ind]
+            // every iterator is usable where a const_iterator is expected
+            const_iterator(iterator it){
+                ptr = it.ptr;
+            }
+
+            //return *ptr
             const T& operator*() const { 
-                // ToDo
-                return vec->data[ind];
+                return *ptr;
             }
             
-            //return &vec->data[ind]
+            //return ptr
             const T* operator->() const { 
-                // ToDo
-                return &vec->data[ind];
+                return ptr;
+            }
+
+            //return ptr[n]
+            const T& operator[](difference_type n) const {
+                return ptr[n];
             }
 
             //pre
-            //ind++; return *this
+            //ptr++; return *this
             const_iterator& operator++(){
-                // ToDo
-                ind++;
+                ptr++;
                 return *this;
             }
 
             //post
-            //old=*this; ind++; return old
+            //old=*this; ptr++; return old
             const_iterator operator++(int){
-                // ToDo
                 const_iterator old = *this;
-                ind++;
+                ptr++;
                 return old;
             }
 
             //pre
-            //ind--; return *this
+            //ptr--; return *this
             const_iterator& operator--(){
-                // ToDo
-                ind--;
+                ptr--;
                 return *this;
             }
 
             //post
-            //old=*this; ind--; return old
+            //old=*this; ptr--; return old
             const_iterator operator--(int){
-                // ToDo
                 const_iterator old = *this;
-                ind--;
+                ptr--;
                 return old;
             }
 
-            //return vec==rhs.vec && ind==rhs.ind
-            bool operator==(const_iterator rhs) const{
-                // ToDo
-                return (vec == rhs.vec) && (ind == rhs.ind);
+            const_iterator& operator+=(difference_type n){
+                ptr += n;
+                return *this;
             }
 
-            //return !(*this == rhs)
-            bool operator!=(const_iterator rhs) const{
-                // ToDo
-                return !(*this == rhs);
+            const_iterator& operator-=(difference_type n){
+                ptr -= n;
+                return *this;
             }
+
+            friend const_iterator operator+(const_iterator it, difference_type n){ return it += n; }
+            friend const_iterator operator+(difference_type n, const_iterator it){ return it += n; }
+            friend const_iterator operator-(const_iterator it, difference_type n){ return it -= n; }
+            friend difference_type operator-(const_iterator a, const_iterator b){ return a.ptr - b.ptr; }
+
+            // friends so an iterator on either side converts
+            //return a.ptr==b.ptr
+            friend bool operator==(const_iterator a, const_iterator b){ return a.ptr == b.ptr; }
+            //return !(a == b)
+            friend bool operator!=(const_iterator a, const_iterator b){ return a.ptr != b.ptr; }
+            friend bool operator<(const_iterator a, const_iterator b){ return a.ptr < b.ptr; }
+            friend bool operator>(const_iterator a, const_iterator b){ return a.ptr > b.ptr; }
+            friend bool operator<=(const_iterator a, const_iterator b){ return a.ptr <= b.ptr; }
+            friend bool operator>=(const_iterator a, const_iterator b){ return a.ptr >= b.ptr; }
     };
+
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
 public:
     // additional functions of Vector class
     
-    //return iterator(this, 0)
+    //return iterator(data)
     iterator begin(){
-        return iterator(this, 0);
+        return iterator(data);
     }
 
-    //return iterator(this, sz)
+    //return iterator(data + sz)
     iterator end(){
-        return iterator(this, sz);
+        return iterator(data + sz);
     }
 
-    //return const_iterator(this, 0)
+    //return const_iterator(data)
     const_iterator begin() const{
-        return const_iterator(this, 0);
+        return const_iterator(data);
     }
 
-    //return const_iterator(this, sz)
+    //return const_iterator(data + sz)
     const_iterator end() const{
-        return const_iterator(this, sz);
+        return const_iterator(data + sz);
+    }
+
+    const_iterator cbegin() const{
+        return begin();
+    }
+
+    const_iterator cend() const{
+        return end();
+    }
+
+    reverse_iterator rbegin(){
+        return reverse_iterator(end());
+    }
+
+    reverse_iterator rend(){
+        return reverse_iterator(begin());
+    }
+
+    const_reverse_iterator rbegin() const{
+        return const_reverse_iterator(end());
+    }
+
+    const_reverse_iterator rend() const{
+        return const_reverse_iterator(begin());
     }
 
     // Inserts an element immediately before iterator position
-    //insert(it.ind, elem); return it;
-    iterator insert(iterator it, const T& elem){
-        // ToDo
-        insert(it.ind, elem);
-        return it;
+    //i = it - begin(); insert(i, elem); return begin() + i;
+    // (the returned iterator is valid even if storage moved)
+    iterator insert(const_iterator it, const T& elem){
+        size_type i = static_cast<size_type>(it.ptr - data);
+        insert(i, elem);
+        return iterator(data + i);
+    }
+
+    // i = it - begin(); insert(i, move(elem)); return begin() + i;
+    iterator insert(const_iterator it, T&& elem){
+        size_type i = static_cast<size_type>(it.ptr - data);
+        insert(i, std::move(elem));
+        return iterator(data + i);
+    }
+
+    // Constructs an element in place immediately before iterator position
+    //i = it - begin(); emplace(i, args...); return begin() + i;
+    template <typename... Args>
+    iterator emplace(const_iterator it, Args&&... args){
+        size_type i = static_cast<size_type>(it.ptr - data);
+        emplace(i, std::forward<Args>(args)...);
+        return iterator(data + i);
     }
 
     // Removes the element at the given iterator position
-    //erase(it.ind); return it;
-    iterator erase(iterator it){
-        // ToDo
-        erase(it.ind);
-        return it;
+    //i = it - begin(); erase(i); return begin() + i;
+    iterator erase(const_iterator it){
+        size_type i = static_cast<size_type>(it.ptr - data);
+        erase(i);
+        return iterator(data + i);
+    }
+
+    // Inserts [first, last) before pos; returns the first inserted element
+    template <typename InputIt, typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+    iterator insert(const_iterator pos, InputIt first, InputIt last){
+        size_type i = static_cast<size_type>(pos.ptr - data);
+        insert(i, first, last);
+        return iterator(data + i);
+    }
+
+    // Inserts count copies of value before pos
+    iterator insert(const_iterator pos, size_type count, const T& value){
+        size_type i = static_cast<size_type>(pos.ptr - data);
+        insert(i, count, value);
+        return iterator(data + i);
+    }
+
+    // Removes [first, last); returns the element after the removed ones
+    iterator erase(const_iterator first, const_iterator last){
+        size_type i = static_cast<size_type>(first.ptr - data);
+        erase(i, static_cast<size_type>(last.ptr - data));
+        return iterator(data + i);
     }
     
 
     // Rule of Five
     private:
         //sz=other.sz; cap=other.cap
-        //if cap==0: data=nullptr
-        //else: data=new T[cap]; copy [0..sz)
+        //if other fits inline: use the inline buffer
+        //else: data=allocate(cap); copy-construct [0..sz)
         void clone(const Vector& other){
-            cap = other.cap;
-            sz = other.sz;
+            resetStorage();
 
-            
-            if(sz == 0) {
-                data = nullptr;
+            if(other.sz > InlineCapacity) {
+                data = allocate(other.cap);   //raw memory for cap elements of type T
+
+                size_type k = 0;
+                try {
+                    for (; k < other.sz; k++){
+                        construct(data + k, other.data[k]);
+                    }
+                } catch (...) {
+                    destroy(data, k);
+                    deallocate(data, other.cap);
+                    resetStorage();
+                    throw;
+                }
+                cap = other.cap;
+                sz = other.sz;
             } else {
-                data = new T[cap];   //alloc memory for new array of type T w/ size cap
+                try {
+                    for (; sz < other.sz; sz++){
+                        construct(data + sz, other.data[sz]);
+                    }
+                } catch (...) {
+                    destroy(data, sz);
+                    sz = 0;
+                    throw;
+                }
+            }
+            countCopied(sz);
+        }
+
+        // like clone, but move-constructs the elements; used when other's
+        // block cannot be adopted because our allocator did not make it
+        void cloneMoving(Vector& other){
+            resetStorage();
+
+            if(other.sz > InlineCapacity) {
+                data = allocate(other.cap);
 
-                for (int k = 0; k < sz; k++){
-                    data[k] = other.data[k];
+                size_type k = 0;
+                try {
+                    for (; k < other.sz; k++){
+                        construct(data + k, std::move(other.data[k]));
+                    }
+                } catch (...) {
+                    destroy(data, k);
+                    deallocate(data, other.cap);
+                    resetStorage();
+                    throw;
+                }
+                cap = other.cap;
+                sz = other.sz;
+            } else {
+                try {
+                    for (; sz < other.sz; sz++){
+                        construct(data + sz, std::move(other.data[sz]));
+                    }
+                } catch (...) {
+                    destroy(data, sz);
+                    sz = 0;
+                    throw;
                 }
             }
+            countMoved(sz);
+        }
+
+        // destroy live elements and release storage
+        void release(){
+            destroy(data, sz);
+            deallocate(data, cap);
         }
 
         // move other's pointers/sizes into this
         // reset other to empty state
+        // inline elements cannot be stolen and are relocated instead
         void transfer(Vector& other){
             // ToDo
+            if (other.isInline()) {
+                resetStorage();
+                relocate(other.data, other.sz, data);
+                sz = other.sz;
+                other.sz = 0;
+                return;
+            }
             cap = other.cap;
             sz = other.sz;
             data = other.data;
 
             //set the other vector (source) to empty
-            other.cap = 0;
-            other.sz = 0;
-            other.data = nullptr;
+            other.resetStorage();
         }
 
+        // moving inline elements may throw unless T's move cannot
+        static constexpr bool nothrow_transfer =
+            InlineCapacity == 0 || std::is_nothrow_move_constructible<T>::value;
+
+        using pocca = typename alloc_traits::propagate_on_container_copy_assignment;
+        using pocma = typename alloc_traits::propagate_on_container_move_assignment;
+        using pocs = typename alloc_traits::propagate_on_container_swap;
+
     public:
         // Copy constructor
-        Vector(const Vector& other){ 
+        // allocator from select_on_container_copy_construction
+        // stats are per object: the copy starts from zero (its own
+        // allocation and copied elements are its first counts)
+        Vector(const Vector& other)
+            : holder(alloc_traits::select_on_container_copy_construction(other.alloc())), stats_holder() {
             clone(other); 
         }
 
+        // copy into storage from a
+        Vector(const Vector& other, const Allocator& a) : holder(a) {
+            clone(other);
+        }
+
         // Copy assignment
         Vector& operator=(const Vector& other){
             // nothing to be done if self-assignment
-            // else deallocate previous and clone
+            // else deallocate previous (with the old allocator),
+            // adopt other's allocator if it propagates, and clone
             if (this != &other) {
-                delete[] data;
+                release();
+                if (pocca::value) {
+                    alloc() = other.alloc();
+                }
                 clone(other);
             }
             return *this;
         }
 
         // Move constructor
-        Vector(Vector&& other){ 
+        // noexcept so relocation of Vector<Vector<T>> moves rows
+        Vector(Vector&& other) noexcept(nothrow_transfer) : holder(std::move(other.alloc())) {
             transfer(other); 
         }
 
+        // move into storage from a; steals other's block only if a can free it
+        Vector(Vector&& other, const Allocator& a) : holder(a) {
+            if (alloc() == other.alloc()) {
+                transfer(other);
+            } else {
+                cloneMoving(other);
+            }
+        }
+
         // Move assignment
-        Vector& operator=(Vector&& other){
+        // steals other's block if the allocator propagates or the two are
+        // equal, otherwise moves element by element into our own storage
+        Vector& operator=(Vector&& other)
+            noexcept((pocma::value || detail::AlwaysEqual<Allocator>::value) && nothrow_transfer) {
             // nothing to be done if self-assignment
             // else deallocate previous and transfer
             if(this != &other) {
-                delete[] data;
-                transfer(other);
+                release();
+                if (pocma::value) {
+                    alloc() = std::move(other.alloc());
+                    transfer(other);
+                } else if (alloc() == other.alloc()) {
+                    transfer(other);
+                } else {
+                    cloneMoving(other);
+                }
             }
             return *this;
         }
 
+        // exchange contents; allocators are exchanged only if they propagate
+        // on swap (otherwise they must compare equal)
+        // inline contents are exchanged with three moves
+        void swap(Vector& other) noexcept(nothrow_transfer) {
+            if (isInline() || other.isInline()) {
+                Vector tmp(std::move(other));
+                other = std::move(*this);
+                *this = std::move(tmp);
+                return;
+            }
+            if (pocs::value) {
+                using std::swap;
+                swap(alloc(), other.alloc());
+            }
+            std::swap(cap, other.cap);
+            std::swap(sz, other.sz);
+            std::swap(data, other.data);
+        }
+
+        friend void swap(Vector& a, Vector& b) noexcept(nothrow_transfer) {
+            a.swap(b);
+        }
+
         // deallocate
         ~Vector(){
-            delete[] this->data; 
+            release(); 
         }
 
     // additional assignment functions
     // Reallocate storage to exactly new_cap (>= sz), moving elements.
-    void reallocate(int new_cap){ // optional helper
+    // Only the sz live elements are constructed in the new block.
+    // Never below the inline capacity: at or under it the elements move
+    // back into the inline buffer.
+    void reallocate(size_type new_cap){ // optional helper
+        if (new_cap < InlineCapacity) {
+            new_cap = InlineCapacity;
+        }
         if (new_cap == cap) {
             return;
         }
-        T *temp = new T[new_cap];
+        T *temp = (InlineCapacity != 0 && new_cap == InlineCapacity) ? inlineData() : allocate(new_cap);
 
-        for (int k = 0; k < sz; k++) {
-            temp[k] = data[k];
+        try {
+            relocate(data, sz, temp);
+        } catch (...) {
+            deallocate(temp, new_cap);
+            throw;
         }
         
-        delete[] data;
+        deallocate(data, cap);
+        countReallocation();
+        if (new_cap < cap) {
+            countShrink();
+        }
         data = temp;
         cap  = new_cap;
     }
 
+    // give memory back after a removal if GrowthPolicy says so
+    // (default: halve once sz <= cap/4)
     void shrink(){
-        if (cap > 0 && sz <= cap / 4) {
-            int new_cap = std::max(1, cap/2);
+        size_type new_cap = GrowthPolicy::shrink(sz, cap);
+        if (new_cap < cap) {
             reallocate(new_cap);
         }
     }
@@ -462,10 +1417,17 @@ public:
     // explicitly reduce the cap to sz and keep at least 1 slot
     void shrink_to_fit(){
         if (cap > sz) {
-            int new_cap = std::max(1, sz);
+            size_type new_cap = std::max<size_type>(1, sz);
             reallocate(new_cap);
         }
     }
 
 }; //end class Vector
+
+template <typename T, typename Allocator, std::size_t InlineCapacity, typename GrowthPolicy>
+constexpr typename Vector<T, Allocator, InlineCapacity, GrowthPolicy>::size_type
+    Vector<T, Allocator, InlineCapacity, GrowthPolicy>::inline_capacity;
+
+template <typename T, typename Allocator, std::size_t InlineCapacity, typename GrowthPolicy>
+constexpr bool Vector<T, Allocator, InlineCapacity, GrowthPolicy>::nothrow_transfer;
 }//end namespace dsa
\ No newline at end of file
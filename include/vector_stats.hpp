@@ -0,0 +1,267 @@
+//include/vector_stats.hpp
+#pragma once
+
+// Opt-in instrumentation for dsa::Vector.
+//
+// Build with DSA_VECTOR_STATS=1 (cmake -DDSA_VECTOR_STATS=ON) and every
+// Vector counts its allocations, reallocations, shrinks, bytes allocated
+// and the elements it moved or copied while growing, inserting and erasing.
+// Counts are kept per object (v.stats()) and per Vector type in a global
+// registry:
+//
+//   dsa::VectorStatsRegistry::instance().dumpAtExit();   // table on stderr
+//
+// With DSA_VECTOR_STATS=0 (the default) the hooks are empty inline
+// functions on an empty base: no space in the object, no code in the
+// hot paths, and stats() is all zeros. The flag changes Vector's layout, so
+// it must be the same in every translation unit of a program.
+
+#ifndef DSA_VECTOR_STATS
+#define DSA_VECTOR_STATS 0
+#endif
+
+#include <atomic>       // std::atomic
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint64_t
+#include <cstdio>       // std::FILE, std::fprintf
+#include <cstdlib>      // std::atexit, std::free
+#include <memory>       // std::unique_ptr
+#include <mutex>        // std::mutex, std::lock_guard
+#include <string>       // std::string
+#include <typeinfo>     // typeid
+#include <utility>      // std::pair
+#include <vector>       // std::vector
+
+#if defined(__GNUG__)
+#include <cxxabi.h>     // abi::__cxa_demangle
+#endif
+
+namespace dsa{
+
+struct VectorStats {
+    std::uint64_t allocations{0};       // blocks taken from the allocator
+    std::uint64_t reallocations{0};     // storage replaced by a new block (grow or shrink)
+    std::uint64_t shrinks{0};           // reallocations that lowered capacity
+    std::uint64_t bytes_allocated{0};   // sum over all allocations
+    std::uint64_t elements_moved{0};    // existing elements moved to another slot
+    std::uint64_t elements_copied{0};   // ... copied instead (clone, or T's move may throw)
+    std::uint64_t peak_capacity{0};     // largest block allocated, in elements
+
+    VectorStats& operator+=(const VectorStats& o){
+        allocations += o.allocations;
+        reallocations += o.reallocations;
+        shrinks += o.shrinks;
+        bytes_allocated += o.bytes_allocated;
+        elements_moved += o.elements_moved;
+        elements_copied += o.elements_copied;
+        peak_capacity = peak_capacity > o.peak_capacity ? peak_capacity : o.peak_capacity;
+        return *this;
+    }
+};
+
+// running totals for one Vector type; safe to update from several threads
+class VectorStatsEntry {
+    std::string typeName;
+    std::atomic<std::uint64_t> allocations{0};
+    std::atomic<std::uint64_t> reallocations{0};
+    std::atomic<std::uint64_t> shrinks{0};
+    std::atomic<std::uint64_t> bytesAllocated{0};
+    std::atomic<std::uint64_t> elementsMoved{0};
+    std::atomic<std::uint64_t> elementsCopied{0};
+    std::atomic<std::uint64_t> peakCapacity{0};
+
+    static void add(std::atomic<std::uint64_t>& c, std::uint64_t n){
+        c.fetch_add(n, std::memory_order_relaxed);
+    }
+
+public:
+    explicit VectorStatsEntry(std::string name) : typeName(std::move(name)) {}
+
+    const std::string& name() const { return typeName; }
+
+    void countAllocation(std::uint64_t elements, std::uint64_t bytes){
+        add(allocations, 1);
+        add(bytesAllocated, bytes);
+        std::uint64_t peak = peakCapacity.load(std::memory_order_relaxed);
+        while (elements > peak &&
+               !peakCapacity.compare_exchange_weak(peak, elements, std::memory_order_relaxed)) {
+        }
+    }
+    void countReallocation(){ add(reallocations, 1); }
+    void countShrink(){ add(shrinks, 1); }
+    void countMoved(std::uint64_t n){ add(elementsMoved, n); }
+    void countCopied(std::uint64_t n){ add(elementsCopied, n); }
+
+    VectorStats snapshot() const {
+        VectorStats s;
+        s.allocations = allocations.load(std::memory_order_relaxed);
+        s.reallocations = reallocations.load(std::memory_order_relaxed);
+        s.shrinks = shrinks.load(std::memory_order_relaxed);
+        s.bytes_allocated = bytesAllocated.load(std::memory_order_relaxed);
+        s.elements_moved = elementsMoved.load(std::memory_order_relaxed);
+        s.elements_copied = elementsCopied.load(std::memory_order_relaxed);
+        s.peak_capacity = peakCapacity.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    void reset(){
+        for (std::atomic<std::uint64_t>* c : {&allocations, &reallocations, &shrinks, &bytesAllocated,
+                                              &elementsMoved, &elementsCopied, &peakCapacity}) {
+            c->store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+// one entry per instrumented Vector type, in order of first use
+class VectorStatsRegistry {
+    mutable std::mutex lock;
+    std::vector<std::unique_ptr<VectorStatsEntry>> entries;
+
+    VectorStatsRegistry() = default;
+
+    static void dumpToStderr(){
+        instance().dump(stderr);
+    }
+
+public:
+    VectorStatsRegistry(const VectorStatsRegistry&) = delete;
+    VectorStatsRegistry& operator=(const VectorStatsRegistry&) = delete;
+
+    static VectorStatsRegistry& instance(){
+        static VectorStatsRegistry registry;
+        return registry;
+    }
+
+    // entry for type name (entries live as long as the registry)
+    VectorStatsEntry& add(std::string name){
+        std::lock_guard<std::mutex> guard(lock);
+        entries.emplace_back(new VectorStatsEntry(std::move(name)));
+        return *entries.back();
+    }
+
+    // (type, totals) for every type used so far
+    std::vector<std::pair<std::string, VectorStats>> snapshot() const {
+        std::lock_guard<std::mutex> guard(lock);
+        std::vector<std::pair<std::string, VectorStats>> out;
+        for (const auto& e : entries) {
+            out.emplace_back(e->name(), e->snapshot());
+        }
+        return out;
+    }
+
+    // totals over every type
+    VectorStats total() const {
+        VectorStats sum;
+        for (const auto& e : snapshot()) {
+            sum += e.second;
+        }
+        return sum;
+    }
+
+    // zero every counter (entries stay registered)
+    void reset(){
+        std::lock_guard<std::mutex> guard(lock);
+        for (const auto& e : entries) {
+            e->reset();
+        }
+    }
+
+    // one line per type (the name last: template names get long)
+    void dump(std::FILE* out) const {
+        std::fprintf(out, "%10s %10s %8s %14s %12s %12s %12s  %s\n", "allocs", "reallocs", "shrinks", "bytes",
+                     "moved", "copied", "peak_cap", "dsa::Vector type");
+        for (const auto& e : snapshot()) {
+            const VectorStats& s = e.second;
+            std::fprintf(out, "%10llu %10llu %8llu %14llu %12llu %12llu %12llu  %s\n",
+                         static_cast<unsigned long long>(s.allocations),
+                         static_cast<unsigned long long>(s.reallocations),
+                         static_cast<unsigned long long>(s.shrinks),
+                         static_cast<unsigned long long>(s.bytes_allocated),
+                         static_cast<unsigned long long>(s.elements_moved),
+                         static_cast<unsigned long long>(s.elements_copied),
+                         static_cast<unsigned long long>(s.peak_capacity), e.first.c_str());
+        }
+    }
+
+    // dump to stderr when the program exits (registered once)
+    void dumpAtExit(){
+        static const bool registered = std::atexit(&VectorStatsRegistry::dumpToStderr) == 0;
+        (void)registered;
+    }
+};
+
+namespace detail{
+
+// readable name of T for the registry
+template <typename T>
+std::string typeName(){
+    const char* mangled = typeid(T).name();
+#if defined(__GNUG__)
+    int status = 0;
+    char* readable = abi::__cxa_demangle(mangled, nullptr, nullptr, &status);
+    if (status == 0 && readable != nullptr) {
+        std::string name(readable);
+        std::free(readable);
+        return name;
+    }
+#endif
+    return mangled;
+}
+
+// Vector's counters: per object, and per Owner type in the registry.
+// Copies and moves start from zero; the counts belong to the object.
+template <typename Owner, bool Enabled = DSA_VECTOR_STATS != 0>
+class StatsHolder {
+    VectorStats own;
+
+    static VectorStatsEntry& entry(){
+        static VectorStatsEntry& e = VectorStatsRegistry::instance().add(typeName<Owner>());
+        return e;
+    }
+
+public:
+    StatsHolder() = default;
+    StatsHolder(const StatsHolder&) {}
+    StatsHolder& operator=(const StatsHolder&) { return *this; }
+
+    VectorStats stats() const { return own; }
+
+    void countAllocation(std::size_t elements, std::size_t bytes){
+        own.allocations++;
+        own.bytes_allocated += bytes;
+        own.peak_capacity = own.peak_capacity > elements ? own.peak_capacity : elements;
+        entry().countAllocation(elements, bytes);
+    }
+    void countReallocation(){
+        own.reallocations++;
+        entry().countReallocation();
+    }
+    void countShrink(){
+        own.shrinks++;
+        entry().countShrink();
+    }
+    void countMoved(std::size_t n){
+        own.elements_moved += n;
+        entry().countMoved(n);
+    }
+    void countCopied(std::size_t n){
+        own.elements_copied += n;
+        entry().countCopied(n);
+    }
+};
+
+// disabled: nothing stored, nothing counted
+template <typename Owner>
+class StatsHolder<Owner, false> {
+public:
+    VectorStats stats() const { return VectorStats(); }
+    void countAllocation(std::size_t, std::size_t){}
+    void countReallocation(){}
+    void countShrink(){}
+    void countMoved(std::size_t){}
+    void countCopied(std::size_t){}
+};
+
+} // namespace detail
+
+} // namespace dsa
@@ -0,0 +1,201 @@
+// test_allocators.cpp
+#include "catch2/catch.hpp"
+#include "vector.hpp"
+#include "matrix.hpp"
+#include "monotonic_arena.hpp"
+#include "pool_allocator.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+TEST_CASE("MonotonicArena bumps, aligns and releases in bulk", "[allocator][arena]") {
+    dsa::MonotonicArena arena(256);
+    void* a = arena.allocate(3, 1);
+    void* b = arena.allocate(8, 64);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(b) % 64 == 0);
+    REQUIRE(static_cast<unsigned char*>(b) > static_cast<unsigned char*>(a));
+    REQUIRE(arena.upstreamAllocations() == 1);
+
+    arena.allocate(1000);                // larger than the next chunk: grows to fit
+    REQUIRE(arena.upstreamAllocations() == 2);
+    REQUIRE(arena.bytesAllocated() == 3 + 8 + 1000);
+    REQUIRE_THROWS_AS(arena.allocate(8, 3), std::invalid_argument);
+
+    arena.reset();                       // keeps the newest chunk
+    REQUIRE(arena.bytesAllocated() == 0);
+    arena.allocate(500);
+    REQUIRE(arena.upstreamAllocations() == 2);
+
+    arena.release();
+    arena.allocate(8);
+    REQUIRE(arena.upstreamAllocations() == 3);
+}
+
+TEST_CASE("MonotonicArena rejects requests near SIZE_MAX", "[allocator][arena]") {
+    const std::size_t max = std::numeric_limits<std::size_t>::max();
+    dsa::MonotonicArena arena(256);
+    REQUIRE_THROWS_AS(arena.allocate(max), std::bad_alloc);
+    REQUIRE_THROWS_AS(arena.allocate(max - 1, 1), std::bad_alloc);
+    REQUIRE_THROWS_AS(arena.allocate(max - 64, 64), std::bad_alloc);
+    REQUIRE_THROWS_AS(arena.allocate(max / 2 + 1), std::bad_alloc);   // doubling the chunk would wrap
+    REQUIRE(arena.upstreamAllocations() == 0);
+
+    arena.allocate(8);                   // still usable afterwards
+    REQUIRE(arena.upstreamAllocations() == 1);
+    REQUIRE(arena.bytesAllocated() == 8);
+}
+
+TEST_CASE("MonotonicArena serves a caller buffer first", "[allocator][arena]") {
+    alignas(16) unsigned char buffer[512];
+    dsa::MonotonicArena arena(buffer, sizeof(buffer));
+    unsigned char* p = static_cast<unsigned char*>(arena.allocate(100));
+    REQUIRE(p >= buffer);
+    REQUIRE(p + 100 <= buffer + sizeof(buffer));
+    REQUIRE(arena.upstreamAllocations() == 0);
+
+    arena.allocate(1000);
+    REQUIRE(arena.upstreamAllocations() == 1);
+    arena.release();
+    REQUIRE(arena.allocate(16) == buffer);
+}
+
+TEST_CASE("Vector and Matrix on a MonotonicArena", "[allocator][arena]") {
+    dsa::MonotonicArena arena;
+    {
+        dsa::Vector<std::string, dsa::ArenaAllocator<std::string>> v(arena);
+        for (int i{0}; i < 200; ++i)
+            v.push_back(std::to_string(i));
+        REQUIRE(v[199] == "199");
+
+        dsa::Vector<std::string, dsa::ArenaAllocator<std::string>> copy(v);
+        REQUIRE(copy.get_allocator().resource() == &arena);
+
+        using ArenaMatrix = dsa::BasicMatrix<double, dsa::ArenaAllocator<double>>;
+        ArenaMatrix a(3, 4, ArenaMatrix::kDefaultRowAlign, arena), b(3, 4, 0, arena);
+        a(2, 3) = 1.5;
+        b(2, 3) = 2.0;
+        ArenaMatrix c(a + b * 2.0, arena);
+        REQUIRE(c(2, 3) == 5.5);
+        REQUIRE(c.getAllocator().resource() == &arena);
+
+        ArenaMatrix bt(4, 2, 0, arena);
+        bt(3, 1) = 2.0;
+        ArenaMatrix p = a * bt;          // result lives on the same arena
+        REQUIRE(p(2, 1) == 3.0);
+        REQUIRE(p.getAllocator() == a.getAllocator());
+    }
+    REQUIRE(arena.bytesAllocated() > 0);
+    arena.release();
+    REQUIRE(arena.bytesAllocated() == 0);
+}
+
+TEST_CASE("BlockPool recycles blocks without going back to the heap", "[allocator][pool]") {
+    dsa::BlockPool pool(24);
+    REQUIRE(pool.blockSize() % alignof(std::max_align_t) == 0);
+    REQUIRE(pool.blockSize() >= 24);
+
+    void* a = pool.allocate();
+    void* b = pool.allocate();
+    REQUIRE(a != b);
+    pool.deallocate(a);
+    REQUIRE(pool.allocate() == a);       // LIFO free list
+
+    for (int i{0}; i < 1000; ++i)
+        pool.allocate();
+    std::size_t chunks = pool.upstreamAllocations();
+    REQUIRE(chunks < 20);                // chunks grow, so few heap calls
+
+    pool.release();
+    pool.allocate();
+    REQUIRE(pool.upstreamAllocations() == chunks + 1);
+}
+
+TEST_CASE("Vector on a PoolResource reuses freed size classes", "[allocator][pool]") {
+    dsa::PoolResource pool(1024);
+    REQUIRE(pool.maxBlockSize() == 1024);
+
+    using PoolVec = dsa::Vector<int, dsa::PoolAllocator<int>>;
+    {
+        PoolVec v(pool);
+        for (int i{0}; i < 256; ++i)
+            v.push_back(i);
+        REQUIRE(v[255] == 255);
+    }
+    std::size_t warm = pool.upstreamAllocations();
+    for (int round{0}; round < 10; ++round) {
+        PoolVec v(pool);
+        for (int i{0}; i < 256; ++i)
+            v.push_back(i);
+        REQUIRE(v.back() == 255);
+    }
+    REQUIRE(pool.upstreamAllocations() == warm);   // all served from free lists
+
+    PoolVec big(pool);
+    big.reserve(1000);                   // 4000 bytes > max block: straight to the heap
+    REQUIRE(pool.upstreamAllocations() == warm + 1);
+}
+
+namespace {
+
+// AlignedAllocator that counts which entry point Vector used
+template <typename T>
+struct ZeroCounting : dsa::AlignedAllocator<T, 64> {
+    static int zeroed;
+    template <typename U>
+    struct rebind { using other = ZeroCounting<U>; };
+    T* allocate_zeroed(std::size_t n) {
+        zeroed++;
+        return dsa::AlignedAllocator<T, 64>::allocate_zeroed(n);
+    }
+};
+template <typename T>
+int ZeroCounting<T>::zeroed = 0;
+
+}
+
+TEST_CASE("AlignedAllocator hands out aligned and zeroed blocks", "[allocator][aligned]") {
+    dsa::AlignedAllocator<double, 64> a;
+    for (std::size_t n : {1u, 3u, 1000u, 1u << 20}) {
+        double* p = a.allocate_zeroed(n);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(p) % 64 == 0);
+        bool zero = true;
+        for (std::size_t k = 0; k < n; k++) zero = zero && p[k] == 0.0;
+        REQUIRE(zero);
+        a.deallocate(p, n);
+
+        double* q = a.allocate(n);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(q) % 64 == 0);
+        q[n - 1] = 1.0;
+        a.deallocate(q, n);
+    }
+    dsa::AlignedAllocator<char, 4096> page;
+    char* c = page.allocate_zeroed(10);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(c) % 4096 == 0);
+    page.deallocate(c, 10);
+}
+
+TEST_CASE("Vector value-initializes in bulk through allocate_zeroed", "[allocator][aligned]") {
+    using V = dsa::Vector<int, ZeroCounting<int>>;
+    V v;
+    v.resize(100000);
+    REQUIRE(ZeroCounting<int>::zeroed == 1);
+    REQUIRE(v.size() == 100000);
+    REQUIRE(v.capacity() == 100000);
+    REQUIRE(std::all_of(v.begin(), v.end(), [](int x) { return x == 0; }));
+
+    v.resize(200000);                    // not empty: the usual fill
+    v.clear();
+    v.resize(50000, 3);                  // not zero
+    V w;
+    w.reserve(10);
+    w.resize(5000);                      // empty, too small: replaces the reserved block
+    REQUIRE(ZeroCounting<int>::zeroed == 2);
+    REQUIRE(w[4999] == 0);
+
+    dsa::Matrix m(300, 300);             // the default allocator takes this path
+    REQUIRE(m(299, 299) == 0);
+}
@@ -0,0 +1,169 @@
+// test_concurrent_vector.cpp
+#include "catch2/catch.hpp"
+#include "concurrent_vector.hpp"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// counts live instances; throws when constructed from a negative value
+struct Tracked {
+    static std::atomic<int> live;
+    int value;
+    Tracked(int v) : value(v) {
+        if (v < 0) throw std::runtime_error("negative");
+        live++;
+    }
+    Tracked(const Tracked& o) : value(o.value) { live++; }
+    ~Tracked() { live--; }
+};
+std::atomic<int> Tracked::live{0};
+
+}
+
+TEST_CASE("ConcurrentVector appends, indexes and iterates like a vector", "[concurrent_vector]") {
+    dsa::ConcurrentVector<int> v;
+    REQUIRE(v.empty());
+    REQUIRE(v.capacity() == 0);
+    for (int i = 0; i < 1000; i++)
+        REQUIRE(v.push_back(i * 3) == static_cast<std::size_t>(i));
+    REQUIRE(v.size() == 1000);
+    REQUIRE(v.capacity() >= 1000);
+    bool ok = true;
+    for (std::size_t i = 0; i < v.size(); i++)
+        ok = ok && v[i] == static_cast<int>(i) * 3 && v.at(i) == v[i];
+    REQUIRE(ok);
+    REQUIRE_THROWS_AS(v.at(1000), std::out_of_range);
+
+    REQUIRE(v.end() - v.begin() == 1000);
+    REQUIRE(std::is_sorted(v.begin(), v.end()));
+    REQUIRE(*std::lower_bound(v.begin(), v.end(), 300) == 300);
+    const dsa::ConcurrentVector<int>& cv = v;
+    dsa::ConcurrentVector<int>::const_iterator it = v.begin();
+    REQUIRE(*(it + 999) == 2997);
+    REQUIRE(std::count_if(cv.begin(), cv.end(), [](int x) { return x % 2 == 0; }) == 500);
+
+    int& r = v.emplace_back(-7);
+    REQUIRE(&r == &v[1000]);
+    v.clear();
+    REQUIRE(v.empty());
+    REQUIRE(v.capacity() == 0);
+}
+
+TEST_CASE("ConcurrentVector elements never move", "[concurrent_vector]") {
+    dsa::ConcurrentVector<std::string> v;
+    v.push_back("first");
+    const std::string* first = &v[0];
+    std::vector<const std::string*> addresses;
+    for (int i = 0; i < 5000; i++) {
+        v.emplace_back(std::to_string(i));
+        addresses.push_back(&v[v.size() - 1]);
+    }
+    REQUIRE(first == &v[0]);
+    REQUIRE(*first == "first");
+    bool same = true;
+    for (std::size_t i = 0; i < addresses.size(); i++)
+        same = same && addresses[i] == &v[i + 1];
+    REQUIRE(same);
+
+    // reserve allocates up front without changing the size
+    dsa::ConcurrentVector<double> r;
+    r.reserve(100);
+    REQUIRE(r.size() == 0);
+    std::size_t cap = r.capacity();
+    REQUIRE(cap >= 100);
+    for (int i = 0; i < 100; i++) r.push_back(i);
+    REQUIRE(r.capacity() == cap);
+}
+
+TEST_CASE("ConcurrentVector takes pushes from many threads", "[concurrent_vector]") {
+    const int threads = 8, per_thread = 20000;
+    dsa::ConcurrentVector<long> v;
+    std::vector<std::thread> pool;
+    std::atomic<long> bad{0};
+    for (int t = 0; t < threads; t++) {
+        pool.emplace_back([&, t] {
+            for (int i = 0; i < per_thread; i++) {
+                long value = static_cast<long>(t) * per_thread + i;
+                std::size_t at = v.push_back(value);
+                if (v[at] != value) bad++;   // readable by its pusher at once
+            }
+        });
+    }
+    // a reader alongside: the size only ever grows
+    pool.emplace_back([&] {
+        std::size_t last = 0;
+        for (int k = 0; k < 1000; k++) {
+            std::size_t now = v.size();
+            if (now < last) bad++;
+            last = now;
+            std::this_thread::yield();
+        }
+    });
+    for (std::thread& t : pool) t.join();
+    REQUIRE(bad == 0);
+    REQUIRE(v.size() == static_cast<std::size_t>(threads * per_thread));
+
+    std::vector<long> seen(v.begin(), v.end());
+    std::sort(seen.begin(), seen.end());
+    bool each_once = true;
+    for (std::size_t i = 0; i < seen.size(); i++)
+        each_once = each_once && seen[i] == static_cast<long>(i);
+    REQUIRE(each_once);
+}
+
+TEST_CASE("ConcurrentVector grow_by claims adjacent slots", "[concurrent_vector]") {
+    dsa::ConcurrentVector<int> v;
+    v.push_back(1);
+    std::size_t first = v.grow_by(40, 9);
+    REQUIRE(first == 1);
+    REQUIRE(v.size() == 41);
+    REQUIRE(std::all_of(v.begin() + 1, v.end(), [](int x) { return x == 9; }));
+    REQUIRE(v.grow_by(0) == 41);
+    REQUIRE(v.size() == 41);
+}
+
+TEST_CASE("ConcurrentVector destroys what it built and skips failed slots", "[concurrent_vector]") {
+    {
+        dsa::ConcurrentVector<Tracked> v;
+        for (int i = 0; i < 100; i++) v.emplace_back(i);
+        REQUIRE(Tracked::live == 100);
+        REQUIRE_THROWS_AS(v.emplace_back(-1), std::runtime_error);
+        REQUIRE(v.size() == 101);   // the slot stays claimed
+        v.push_back(Tracked(5));
+        REQUIRE(v[101].value == 5);
+        REQUIRE(Tracked::live == 101);
+    }
+    REQUIRE(Tracked::live == 0);
+
+    dsa::ConcurrentVector<Tracked> a;
+    a.grow_by(30, Tracked(2));
+    dsa::ConcurrentVector<Tracked> b(std::move(a));
+    REQUIRE(a.size() == 0);
+    REQUIRE(b.size() == 30);
+    REQUIRE(b[29].value == 2);
+    b.clear();
+    REQUIRE(Tracked::live == 0);
+}
+
+TEST_CASE("ConcurrentVector refused grow_by leaves the size alone", "[concurrent_vector]") {
+    {
+        dsa::ConcurrentVector<Tracked> v;
+        v.grow_by(20, Tracked(1));   // two segments allocated
+        REQUIRE(Tracked::live == 20);
+        REQUIRE_THROWS_AS(v.grow_by(v.max_size(), Tracked(0)), std::length_error);
+        REQUIRE(v.size() == 20);
+        REQUIRE(v.end() - v.begin() == 20);
+
+        v.push_back(Tracked(3));     // claims the next slot, not one past the refused range
+        REQUIRE(v.size() == 21);
+        REQUIRE(v[20].value == 3);
+        REQUIRE(Tracked::live == 21);
+    }
+    REQUIRE(Tracked::live == 0);     // only built elements were destroyed
+}
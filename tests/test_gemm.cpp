@@ -0,0 +1,155 @@
+// test_gemm.cpp
+#include "catch2/catch.hpp"
+#include "gemm.hpp"
+#include "matrix.hpp"
+#include "thread_pool.hpp"
+#include <atomic>
+#include <complex>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+void fill(dsa::Matrix& M, unsigned seed) {
+    unsigned x = seed;
+    for (std::size_t i = 0; i < M.getRows(); ++i)
+        for (std::size_t j = 0; j < M.getCols(); ++j) {
+            x = x * 1103515245u + 12345u;
+            M(i, j) = static_cast<int>(x >> 8) % 201 - 100;
+        }
+}
+
+// triple loop through the checked accessor
+dsa::Matrix reference(const dsa::Matrix& A, const dsa::Matrix& B) {
+    dsa::Matrix C(A.getRows(), B.getCols());
+    dsa::gemm::naive(A.getRows(), B.getCols(), A.getCols(),
+                     A.row(0), A.getStride(), B.row(0), B.getStride(),
+                     C.row(0), C.getStride());
+    return C;
+}
+
+bool same(const dsa::Matrix& X, const dsa::Matrix& Y) {
+    if (X.getRows() != Y.getRows() || X.getCols() != Y.getCols()) return false;
+    for (std::size_t i = 0; i < X.getRows(); ++i)
+        for (std::size_t j = 0; j < X.getCols(); ++j)
+            if (X(i, j) != Y(i, j)) return false;
+    return true;
+}
+
+}
+
+TEST_CASE("ThreadPool parallel_for visits every index once", "[thread_pool]") {
+    for (std::size_t workers : {0u, 1u, 3u}) {
+        dsa::ThreadPool pool(workers);
+        std::vector<std::atomic<int>> hits(1000);
+        for (auto& h : hits) h = 0;
+        pool.parallel_for(0, hits.size(), [&](std::size_t i) { hits[i]++; });
+        for (auto& h : hits) REQUIRE(h == 1);
+    }
+}
+
+TEST_CASE("ThreadPool parallel_for rethrows and nests", "[thread_pool]") {
+    dsa::ThreadPool pool(2);
+    REQUIRE_THROWS_AS(pool.parallel_for(0, 64, [](std::size_t i) {
+        if (i == 17) throw std::runtime_error("boom");
+    }), std::runtime_error);
+
+    std::atomic<int> total{0};
+    pool.parallel_for(0, 8, [&](std::size_t) {
+        pool.parallel_for(0, 8, [&](std::size_t) { total++; });
+    });
+    REQUIRE(total == 64);
+}
+
+TEST_CASE("blocked gemm matches the naive triple loop", "[gemm][matrix]") {
+    dsa::ThreadPool pool(3);
+    struct Shape { int m, k, n; };
+    // edges of MR/NR/KC/MC/NC blocks, skinny and degenerate shapes
+    const Shape shapes[] = {
+        {1, 1, 1}, {5, 7, 3}, {6, 16, 16}, {7, 17, 15}, {97, 257, 33},
+        {200, 3, 520}, {3, 600, 2}, {130, 64, 1030}, {0, 4, 4}, {4, 0, 4},
+    };
+    for (const Shape& s : shapes) {
+        INFO("m=" << s.m << " k=" << s.k << " n=" << s.n);
+        dsa::Matrix A(s.m, s.k), B(s.k, s.n, 0); // mixed strides
+        fill(A, 1);
+        fill(B, 2);
+        REQUIRE(same(A.multiply(B, pool), reference(A, B)));
+    }
+
+    dsa::Matrix A(33, 70), B(70, 21);
+    fill(A, 3);
+    fill(B, 4);
+    REQUIRE(same(A * B, reference(A, B)));
+}
+
+TEST_CASE("Matrix multiplication checks inner dimensions", "[gemm][matrix]") {
+    dsa::Matrix A(2, 3), B(2, 3);
+    REQUIRE_THROWS_AS(A * B, std::out_of_range);
+
+    A(0, 0) = 1; A(0, 1) = 2; A(0, 2) = 3;
+    A(1, 0) = 4; A(1, 1) = 5; A(1, 2) = 6;
+    dsa::Matrix I(3, 3);
+    I(0, 0) = I(1, 1) = I(2, 2) = 1;
+    dsa::Matrix P = A * I;
+    REQUIRE(P.getRows() == 2);
+    REQUIRE(P.getCols() == 3);
+    REQUIRE(P(1, 2) == 6);
+}
+
+TEMPLATE_TEST_CASE("blocked gemm matches the naive loop for each element type", "[gemm][types]",
+                   std::int8_t, std::int16_t, long long, float, double, std::complex<float>) {
+    dsa::ThreadPool pool(2);
+    using M = dsa::BasicMatrix<TestType>;
+    const int shapes[][3] = {{1, 1, 1}, {7, 17, 15}, {70, 300, 41}, {13, 5, 530}};
+    for (const auto& s : shapes) {
+        INFO("m=" << s[0] << " k=" << s[1] << " n=" << s[2]);
+        M A(s[0], s[1]), B(s[1], s[2]);
+        for (int i = 0; i < s[0]; ++i)
+            for (int j = 0; j < s[1]; ++j)
+                A(i, j) = static_cast<TestType>((i * 7 + j * 3) % 11 - 5);
+        for (int i = 0; i < s[1]; ++i)
+            for (int j = 0; j < s[2]; ++j)
+                B(i, j) = static_cast<TestType>((i * 5 + j) % 9 - 4);
+
+        M R(s[0], s[2]);
+        dsa::gemm::naive(s[0], s[2], s[1], A.row(0), A.getStride(), B.row(0), B.getStride(),
+                         R.row(0), R.getStride());
+        M C = A.multiply(B, pool);
+        // small integers are exact in every type, so results must be equal
+        for (int i = 0; i < s[0]; ++i)
+            for (int j = 0; j < s[2]; ++j)
+                REQUIRE(C(i, j) == R(i, j));
+    }
+}
+
+TEST_CASE("int8 products accumulate in 32 bits before narrowing", "[gemm][types]") {
+    dsa::BasicMatrix<std::int8_t> A(1, 4), B(4, 1);
+    for (int p = 0; p < 4; ++p) {
+        A(0, p) = 100;
+        B(p, 0) = 100;
+    }
+    // 4 * 100 * 100 = 40000 = 0x9C40 -> low byte 0x40
+    dsa::BasicMatrix<std::int8_t> C = A * B;
+    REQUIRE(C(0, 0) == 0x40);
+}
+
+TEST_CASE("int16 extreme products wrap instead of overflowing", "[gemm][types]") {
+    dsa::BasicMatrix<std::int16_t> A(1, 4), B(4, 1);
+    for (int p = 0; p < 4; ++p) {
+        A(0, p) = -32768;
+        B(p, 0) = -32768;
+    }
+    // 4 * 2^30 = 2^32 -> low 16 bits are 0
+    dsa::BasicMatrix<std::int16_t> C = A * B;
+    REQUIRE(C(0, 0) == 0);
+
+    dsa::BasicMatrix<std::int16_t> D(1, 4), E(4, 1);
+    for (int p = 0; p < 4; ++p) {
+        D(0, p) = 32767;
+        E(p, 0) = 32767;
+    }
+    // 4 * 32767^2 = 0xFFFC0004 -> low 16 bits are 4
+    REQUIRE((D * E)(0, 0) == 4);
+}
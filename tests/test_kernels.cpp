@@ -0,0 +1,196 @@
+// test_kernels.cpp
+#include "catch2/catch.hpp"
+#include "kernels.hpp"
+#include "matrix.hpp"
+#include <climits>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+// deterministic values that include negatives and overflow-prone magnitudes
+std::vector<int> pattern(std::size_t n, unsigned seed) {
+    std::vector<int> v(n);
+    unsigned x = seed;
+    for (std::size_t k = 0; k < n; ++k) {
+        x = x * 1664525u + 1013904223u;
+        v[k] = static_cast<int>(x);
+    }
+    if (n > 0) v[0] = INT_MAX;
+    if (n > 1) v[1] = INT_MIN;
+    return v;
+}
+
+template <typename T>
+std::vector<T> patternOf(std::size_t n, unsigned seed) {
+    std::vector<int> raw = pattern(n, seed);
+    std::vector<T> v(n);
+    for (std::size_t k = 0; k < n; ++k)
+        v[k] = static_cast<T>(raw[k] % 1000) / static_cast<T>(8);
+    return v;
+}
+
+}
+
+/* every SIMD kernel must match the scalar reference bit for bit,
+   including odd lengths that exercise the scalar tail */
+TEST_CASE("SIMD kernels match the scalar path", "[kernels]") {
+    using dsa::kernels::Isa;
+    const Isa isas[] = {Isa::Scalar, Isa::SSE2, Isa::AVX2};
+    const dsa::kernels::Table<int> ref = dsa::kernels::table<int>(Isa::Scalar);
+
+    for (Isa isa : isas) {
+        if (!dsa::kernels::supported(isa))
+            continue;
+        INFO("isa = " << dsa::kernels::isaName(isa));
+        const dsa::kernels::Table<int> t = dsa::kernels::table<int>(isa);
+
+        for (std::size_t n : {0u, 1u, 3u, 4u, 7u, 8u, 9u, 31u, 1000u}) {
+            std::vector<int> a = pattern(n, 1), b = pattern(n, 2);
+            std::vector<int> want(n), got(n);
+
+            ref.add(a.data(), b.data(), want.data(), n);
+            t.add(a.data(), b.data(), got.data(), n);
+            REQUIRE(got == want);
+
+            ref.sub(a.data(), b.data(), want.data(), n);
+            t.sub(a.data(), b.data(), got.data(), n);
+            REQUIRE(got == want);
+
+            ref.mul(a.data(), b.data(), want.data(), n);
+            t.mul(a.data(), b.data(), got.data(), n);
+            REQUIRE(got == want);
+
+            ref.scale(a.data(), -7, want.data(), n);
+            t.scale(a.data(), -7, got.data(), n);
+            REQUIRE(got == want);
+
+            want = b; got = b;
+            ref.axpy(3, a.data(), want.data(), n);
+            t.axpy(3, a.data(), got.data(), n);
+            REQUIRE(got == want);
+        }
+    }
+}
+
+/* floating point kernels: exact on every isa; axpy rounds once (fused) on
+   AVX2 and twice everywhere else, the same way across body and tail */
+TEMPLATE_TEST_CASE("floating point SIMD kernels match the scalar path", "[kernels]", float, double) {
+    using dsa::kernels::Isa;
+    const Isa isas[] = {Isa::Scalar, Isa::SSE2, Isa::AVX2};
+    const dsa::kernels::Table<TestType> ref = dsa::kernels::table<TestType>(Isa::Scalar);
+
+    for (Isa isa : isas) {
+        if (!dsa::kernels::supported(isa))
+            continue;
+        INFO("isa = " << dsa::kernels::isaName(isa));
+        const dsa::kernels::Table<TestType> t = dsa::kernels::table<TestType>(isa);
+
+        for (std::size_t n : {0u, 1u, 3u, 4u, 7u, 8u, 9u, 31u, 1000u}) {
+            std::vector<TestType> a = patternOf<TestType>(n, 1), b = patternOf<TestType>(n, 2);
+            std::vector<TestType> want(n), got(n);
+
+            ref.add(a.data(), b.data(), want.data(), n);
+            t.add(a.data(), b.data(), got.data(), n);
+            REQUIRE(got == want);
+
+            ref.sub(a.data(), b.data(), want.data(), n);
+            t.sub(a.data(), b.data(), got.data(), n);
+            REQUIRE(got == want);
+
+            ref.mul(a.data(), b.data(), want.data(), n);
+            t.mul(a.data(), b.data(), got.data(), n);
+            REQUIRE(got == want);
+
+            ref.scale(a.data(), TestType(-1.5), want.data(), n);
+            t.scale(a.data(), TestType(-1.5), got.data(), n);
+            REQUIRE(got == want);
+
+            const TestType alpha = TestType(1) / TestType(3);
+            want = b; got = b;
+            if (isa == Isa::AVX2) {
+                for (std::size_t k = 0; k < n; ++k)
+                    want[k] = std::fma(alpha, a[k], want[k]);
+            } else {
+                ref.axpy(alpha, a.data(), want.data(), n);
+            }
+            t.axpy(alpha, a.data(), got.data(), n);
+            REQUIRE(got == want);
+        }
+    }
+}
+
+TEST_CASE("detected isa is supported", "[kernels]") {
+    REQUIRE(dsa::kernels::supported(dsa::kernels::detectIsa()));
+    REQUIRE(dsa::kernels::supported(dsa::kernels::Isa::Scalar));
+}
+
+TEST_CASE("scalar multiply of narrow unsigned types wraps", "[kernels][types]") {
+    // 65535 * 65535 = 0xFFFE0001 -> low 16 bits are 1 (and no signed int overflow)
+    REQUIRE(dsa::kernels::scalar::op_mul<std::uint16_t>(65535, 65535) == 1);
+    REQUIRE(dsa::kernels::scalar::op_mul<std::uint8_t>(255, 255) == 1);
+}
+
+TEST_CASE("Matrix element-wise operations", "[matrix][kernels]") {
+    dsa::Matrix A(3, 5), B(3, 5, 0); // different strides take the per-row path
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 5; ++j) {
+            A(i, j) = i * 5 + j;
+            B(i, j) = 2 - j;
+        }
+    }
+
+    dsa::Matrix S = A - B;
+    dsa::Matrix H = A.hadamard(B);
+    dsa::Matrix K = A * 3;
+    dsa::Matrix K2 = -2 * A;
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 5; ++j) {
+            REQUIRE(S(i, j) == A(i, j) - B(i, j));
+            REQUIRE(H(i, j) == A(i, j) * B(i, j));
+            REQUIRE(K(i, j) == 3 * A(i, j));
+            REQUIRE(K2(i, j) == -2 * A(i, j));
+        }
+    }
+
+    dsa::Matrix C = A;
+    C.axpy(4, B);
+    REQUIRE(C(2, 3) == A(2, 3) + 4 * B(2, 3));
+    C -= B;
+    C += A;
+    C *= 2;
+    REQUIRE(C(1, 1) == 2 * (2 * A(1, 1) + 3 * B(1, 1)));
+
+    dsa::Matrix D(2, 5);
+    REQUIRE_THROWS_AS(A - D, std::out_of_range);
+    REQUIRE_THROWS_AS(A.hadamard(D), std::out_of_range);
+    REQUIRE_THROWS_AS(A.axpy(1, D), std::out_of_range);
+}
+
+TEMPLATE_TEST_CASE("BasicMatrix element-wise operations for each element type", "[matrix][kernels][types]",
+                   std::int8_t, std::int16_t, long long, float, double, std::complex<double>) {
+    using M = dsa::BasicMatrix<TestType>;
+    M A(3, 5), B(3, 5, 0);
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 5; ++j) {
+            A(i, j) = static_cast<TestType>(i + j);
+            B(i, j) = static_cast<TestType>(2 - j);
+        }
+    }
+    M S = A + B;
+    M D = A - B;
+    M H = A.hadamard(B);
+    M K = A * TestType(3);
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 5; ++j) {
+            REQUIRE(S(i, j) == static_cast<TestType>(i + 2));
+            REQUIRE(D(i, j) == static_cast<TestType>(i + 2 * j - 2));
+            REQUIRE(H(i, j) == static_cast<TestType>((i + j) * (2 - j)));
+            REQUIRE(K(i, j) == static_cast<TestType>(3 * (i + j)));
+        }
+    }
+    A.axpy(TestType(2), B);
+    REQUIRE(A(2, 4) == static_cast<TestType>(6 - 4));
+}
@@ -0,0 +1,159 @@
+// test_mapped_vector.cpp
+#include "catch2/catch.hpp"
+#include "mapped_vector.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+struct Record {
+    std::uint64_t id;
+    double value;
+    char tag[8];
+};
+
+// a fresh file on tmpfs (falls back to /tmp), removed at scope exit
+struct TempFile {
+    std::string path;
+
+    explicit TempFile(const char* name){
+        struct stat st;
+        std::string dir = ::stat("/dev/shm", &st) == 0 ? "/dev/shm" : "/tmp";
+        path = dir + "/dsa_" + std::to_string(::getpid()) + "_" + name;
+        std::remove(path.c_str());
+    }
+    ~TempFile(){ std::remove(path.c_str()); }
+};
+
+std::size_t fileSize(const std::string& path){
+    struct stat st;
+    ::stat(path.c_str(), &st);
+    return static_cast<std::size_t>(st.st_size);
+}
+
+} // namespace
+
+TEST_CASE("MappedVector starts empty and grows like a Vector", "[mapped]") {
+    TempFile file("grow");
+    dsa::MappedVector<int> v(file.path);
+    REQUIRE(v.empty());
+    REQUIRE(v.capacity() == 0);
+
+    for (int i = 0; i < 100000; i++) {
+        v.push_back(i);
+    }
+    REQUIRE(v.size() == 100000);
+    REQUIRE(v.capacity() >= 100000);
+    REQUIRE(fileSize(file.path) == 64 + v.capacity() * sizeof(int));
+    for (int i = 0; i < 100000; i++) {
+        REQUIRE(v[i] == i);
+    }
+    REQUIRE(v.front() == 0);
+    REQUIRE(v.back() == 99999);
+    REQUIRE_THROWS_AS(v.at(100000), std::out_of_range);
+}
+
+TEST_CASE("MappedVector contents persist across reopen", "[mapped]") {
+    TempFile file("persist");
+    {
+        dsa::MappedVector<Record> v(file.path);
+        for (std::uint64_t i = 0; i < 5000; i++) {
+            v.push_back(Record{i, i * 0.5, {'r', 'e', 'c'}});
+        }
+        v.pop_back();
+        v.sync();
+    }
+
+    dsa::MappedVector<Record> v(file.path);
+    REQUIRE(v.size() == 4999);
+    for (std::uint64_t i = 0; i < v.size(); i++) {
+        REQUIRE(v[i].id == i);
+        REQUIRE(v[i].value == i * 0.5);
+        REQUIRE(std::string(v[i].tag) == "rec");
+    }
+
+    v.push_back(Record{42, 1.0, {}});     // keeps growing after reopen
+    REQUIRE(v.back().id == 42);
+}
+
+TEST_CASE("MappedVector pop_back on empty leaves the file usable", "[mapped]") {
+    TempFile file("pop_empty");
+    {
+        dsa::MappedVector<int> v(file.path);
+        v.push_back(1);
+        v.pop_back();
+        REQUIRE_THROWS_AS(v.pop_back(), std::out_of_range);
+        REQUIRE(v.empty());
+    }
+
+    dsa::MappedVector<int> v(file.path);   // header still says size 0
+    REQUIRE(v.empty());
+    v.push_back(5);
+    REQUIRE(v.back() == 5);
+}
+
+TEST_CASE("MappedVector insert, erase, resize and shrink_to_fit", "[mapped]") {
+    TempFile file("edit");
+    dsa::MappedVector<int> v(file.path);
+    v.resize(10, 7);
+    v.insert(0, 1);
+    v.insert(11, 2);
+    v.insert(5, 3);
+    REQUIRE(v.size() == 13);
+    REQUIRE(v[0] == 1);
+    REQUIRE(v[5] == 3);
+    REQUIRE(v[12] == 2);
+    v.erase(5);
+    v.erase(0);
+    REQUIRE(v.size() == 11);
+    REQUIRE(v[0] == 7);
+    REQUIRE(v[10] == 2);
+    REQUIRE_THROWS_AS(v.erase(11), std::out_of_range);
+
+    v.shrink_to_fit();
+    REQUIRE(v.capacity() == 11);
+    REQUIRE(fileSize(file.path) == 64 + 11 * sizeof(int));
+
+    int sum = 0;
+    for (int x : v) {
+        sum += x;
+    }
+    REQUIRE(sum == 10 * 7 + 2);
+
+    v.clear();
+    REQUIRE(v.empty());
+    REQUIRE(v.capacity() == 11);
+}
+
+TEST_CASE("MappedVector refuses files of another type", "[mapped]") {
+    TempFile file("type");
+    {
+        dsa::MappedVector<int> v(file.path);
+        v.push_back(1);
+    }
+    REQUIRE_THROWS_AS(dsa::MappedVector<Record>(file.path), std::runtime_error);
+
+    TempFile junk("junk");
+    std::FILE* f = std::fopen(junk.path.c_str(), "wb");
+    std::fputs("not a vector", f);
+    std::fclose(f);
+    REQUIRE_THROWS_AS(dsa::MappedVector<int>(junk.path), std::runtime_error);
+
+    REQUIRE_THROWS_AS(dsa::MappedVector<int>("/nonexistent/dir/file"), std::system_error);
+}
+
+TEST_CASE("MappedVector moves own the mapping", "[mapped]") {
+    TempFile file("move");
+    dsa::MappedVector<int> a(file.path);
+    a.push_back(5);
+    dsa::MappedVector<int> b(std::move(a));
+    REQUIRE(b.size() == 1);
+    REQUIRE(b[0] == 5);
+    REQUIRE(b.path() == file.path);
+    b.push_back(6);
+    REQUIRE(b[1] == 6);
+}
@@ -0,0 +1,85 @@
+// test_matrix_expr.cpp
+#include "catch2/catch.hpp"
+#include "matrix.hpp"
+#include <stdexcept>
+
+namespace {
+
+dsa::Matrix filled(int r, int c, int base, std::size_t align = dsa::Matrix::kDefaultRowAlign) {
+    dsa::Matrix M(r, c, align);
+    for (int i = 0; i < r; ++i)
+        for (int j = 0; j < c; ++j)
+            M(i, j) = base + i * c + j;
+    return M;
+}
+
+}
+
+TEST_CASE("chained sums evaluate lazily into the destination", "[matrix][expr]") {
+    // wider than one evaluation chunk so rows are split
+    const int r = 3, c = 1100;
+    dsa::Matrix a = filled(r, c, 0), b = filled(r, c, 1, 0), cc = filled(r, c, 2), d = filled(r, c, 3);
+
+    auto e = a + b + cc + d;             // nothing evaluated yet
+    REQUIRE(e.getRows() == 3);
+    REQUIRE(e.getCols() == 1100);
+
+    dsa::Matrix sum = e;
+    dsa::Matrix mixed = 2 * (a - b) + a.hadamard(d) - cc * 3;
+    for (int i = 0; i < r; ++i) {
+        for (int j = 0; j < c; j += 97) {
+            REQUIRE(sum(i, j) == a(i, j) + b(i, j) + cc(i, j) + d(i, j));
+            REQUIRE(mixed(i, j) == 2 * (a(i, j) - b(i, j)) + a(i, j) * d(i, j) - 3 * cc(i, j));
+        }
+    }
+}
+
+TEST_CASE("expressions may alias the destination", "[matrix][expr]") {
+    dsa::Matrix a = filled(4, 40, 1), b = filled(4, 40, 5);
+    dsa::Matrix a0 = a;
+
+    a = a + b;
+    REQUIRE(a(3, 39) == a0(3, 39) + b(3, 39));
+
+    a = b - a * 2;
+    REQUIRE(a(2, 7) == b(2, 7) - 2 * (a0(2, 7) + b(2, 7)));
+
+    a += b + b;
+    a -= b;
+    REQUIRE(a(1, 1) == b(1, 1) - 2 * (a0(1, 1) + b(1, 1)) + b(1, 1));
+}
+
+TEST_CASE("the destination may appear anywhere in the expression", "[matrix][expr]") {
+    // several chunks per row so a later chunk cannot hide an early overwrite
+    dsa::BasicMatrix<double> x = dsa::BasicMatrix<double>::filled(3, 700, 1.0);
+    dsa::BasicMatrix<double> y = dsa::BasicMatrix<double>::filled(3, 700, 10.0);
+    y = 2.0 * x + y;
+    REQUIRE(y(0, 0) == 12.0);
+    REQUIRE(y(2, 699) == 12.0);
+
+    dsa::Matrix a = filled(4, 40, 1), b = filled(4, 40, 5), c = filled(4, 40, 9);
+    dsa::Matrix a0 = a;
+    a = b + a;
+    REQUIRE(a(3, 39) == b(3, 39) + a0(3, 39));
+    a = a0;
+    a = b + c + a;
+    REQUIRE(a(2, 17) == b(2, 17) + c(2, 17) + a0(2, 17));
+    a = a0;
+    a = hadamard(b, a) - a * 3;
+    REQUIRE(a(1, 5) == b(1, 5) * a0(1, 5) - 3 * a0(1, 5));
+}
+
+TEST_CASE("assigning an expression of another shape reallocates", "[matrix][expr]") {
+    dsa::Matrix a(1, 1), b = filled(2, 3, 0), c = filled(2, 3, 10);
+    a = b + c;
+    REQUIRE(a.getRows() == 2);
+    REQUIRE(a.getCols() == 3);
+    REQUIRE(a(1, 2) == 5 + 15);
+}
+
+TEST_CASE("mismatched operands throw when the expression is built", "[matrix][expr]") {
+    dsa::Matrix a(2, 2), b(2, 2), c(3, 2);
+    REQUIRE_THROWS_AS(a + b + c, std::out_of_range);
+    REQUIRE_THROWS_AS(a.hadamard(c), std::out_of_range);
+    REQUIRE_THROWS_AS(dsa::Matrix(a - c), std::out_of_range);
+}
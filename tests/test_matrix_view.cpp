@@ -0,0 +1,230 @@
+// test_matrix_view.cpp
+#include "catch2/catch.hpp"
+#include "matrix.hpp"
+#include "thread_pool.hpp"
+#include <stdexcept>
+
+namespace {
+
+dsa::Matrix filled(int r, int c, int base) {
+    dsa::Matrix M(r, c);
+    for (int i = 0; i < r; ++i)
+        for (int j = 0; j < c; ++j)
+            M(i, j) = base + i * c + j;
+    return M;
+}
+
+// reference product of any two views
+dsa::Matrix naiveProduct(const dsa::ConstMatrixView& a, const dsa::ConstMatrixView& b) {
+    dsa::Matrix r(a.getRows(), b.getCols());
+    for (std::size_t i = 0; i < a.getRows(); ++i)
+        for (std::size_t j = 0; j < b.getCols(); ++j) {
+            int sum = 0;
+            for (std::size_t p = 0; p < a.getCols(); ++p) sum += a(i, p) * b(p, j);
+            r(i, j) = sum;
+        }
+    return r;
+}
+
+// matrices or views, element by element
+template <typename X, typename Y>
+bool same(const X& x, const Y& y) {
+    if (x.getRows() != y.getRows() || x.getCols() != y.getCols()) return false;
+    for (std::size_t i = 0; i < x.getRows(); ++i)
+        for (std::size_t j = 0; j < x.getCols(); ++j)
+            if (x(i, j) != y(i, j)) return false;
+    return true;
+}
+
+}
+
+TEST_CASE("views share the matrix storage", "[matrix][view]") {
+    dsa::Matrix m = filled(5, 7, 0);
+    dsa::MatrixView b = m.block(1, 2, 3, 4);
+    REQUIRE(b.getRows() == 3);
+    REQUIRE(b.getCols() == 4);
+    REQUIRE(b.getStride() == m.getStride());
+    REQUIRE(&b(0, 0) == &m(1, 2));
+    REQUIRE(b(2, 3) == m(3, 5));
+    b(0, 0) = -1;
+    REQUIRE(m(1, 2) == -1);
+
+    // row and column views, and blocks of blocks
+    REQUIRE(m.rowView(4)(0, 6) == m(4, 6));
+    REQUIRE(m.colView(3).getRows() == 5);
+    REQUIRE(m.colView(3)(4, 0) == m(4, 3));
+    REQUIRE(b.block(1, 1, 2, 2)(1, 1) == m(3, 4));
+
+    // transpose swaps the shape without copying
+    dsa::MatrixView t = m.transposed();
+    REQUIRE(t.getRows() == 7);
+    REQUIRE(t.getCols() == 5);
+    REQUIRE(t.isTransposed());
+    REQUIRE(&t(6, 4) == &m(4, 6));
+    REQUIRE(&t.block(2, 1, 3, 2)(0, 1) == &m(2, 2));
+    REQUIRE(&t.rowView(3)(0, 4) == &m(4, 3));
+    REQUIRE(!t.transpose().isTransposed());
+    REQUIRE(&t.transpose()(1, 2) == &m(1, 2));
+
+    const dsa::Matrix& cm = m;
+    dsa::ConstMatrixView cv = cm.block(0, 0, 2, 2);
+    dsa::ConstMatrixView from_mutable = b;
+    REQUIRE(cv(1, 1) == m(1, 1));
+    REQUIRE(from_mutable.getData() == b.getData());
+
+    REQUIRE_THROWS_AS(m.block(3, 0, 3, 1), std::out_of_range);
+    REQUIRE_THROWS_AS(m.block(0, 7, 1, 1), std::out_of_range);
+    REQUIRE_THROWS_AS(b(3, 0), std::out_of_range);
+    REQUIRE_THROWS_AS(t(0, 5), std::out_of_range);
+    REQUIRE(m.block(5, 7, 0, 0).getRows() == 0);
+}
+
+TEST_CASE("views are expression operands", "[matrix][view][expr]") {
+    // wider than one evaluation chunk so rows are split
+    const int n = 700;
+    dsa::Matrix a = filled(n, n, 0), b = filled(n, n, 3);
+
+    dsa::Matrix sum = a.block(10, 20, 30, 600) + b.transposed().block(5, 7, 30, 600) * 2;
+    bool ok = true;
+    for (int i = 0; i < 30; ++i)
+        for (int j = 0; j < 600; ++j)
+            ok = ok && sum(i, j) == a(10 + i, 20 + j) + 2 * b(7 + j, 5 + i);
+    REQUIRE(ok);
+
+    dsa::Matrix t = a.transposed();
+    REQUIRE(t.getRows() == static_cast<std::size_t>(n));
+    REQUIRE(same(t.view(), a.transposed()));
+    REQUIRE_THROWS_AS(a.rowView(0) + a.colView(0), std::out_of_range);
+}
+
+TEST_CASE("writing through views", "[matrix][view]") {
+    dsa::Matrix m(6, 6), src = filled(3, 4, 1);
+
+    m.block(1, 1, 3, 4) = src;
+    REQUIRE(m(1, 1) == src(0, 0));
+    REQUIRE(m(3, 4) == src(2, 3));
+    REQUIRE(m(0, 0) == 0);
+    REQUIRE(m(1, 5) == 0);
+
+    // into a transposed block: m(j, i) = src(i, j)
+    dsa::Matrix n(6, 6);
+    n.transposed().block(0, 0, 3, 4) = src;
+    REQUIRE(n(3, 2) == src(2, 3));
+    REQUIRE(n(0, 1) == src(1, 0));
+
+    // view to view copies elements, it does not rebind
+    dsa::MatrixView dst = n.block(4, 0, 2, 2);
+    dst = m.block(1, 1, 2, 2);
+    REQUIRE(dst.getData() == &n(4, 0));
+    REQUIRE(n(5, 1) == m(2, 2));
+
+    m.rowView(0).fill(9);
+    m.colView(5).fill(7);
+    REQUIRE(m(0, 4) == 9);
+    REQUIRE(m(0, 5) == 7);
+    REQUIRE(m(5, 5) == 7);
+
+    dsa::Matrix before = m;
+    m.block(1, 1, 3, 4) *= 2;
+    m.block(1, 1, 3, 4) += src;
+    m.block(1, 1, 3, 4) -= src * 3;
+    REQUIRE(m(2, 3) == 2 * before(2, 3) - 2 * src(1, 2));
+    REQUIRE(m(0, 0) == before(0, 0));
+
+    dsa::Matrix x = filled(6, 6, 2);
+    m = before;
+    m.view().axpy(3, x.transposed());
+    m.block(0, 0, 2, 6).axpy(-1, x.block(4, 0, 2, 6));
+    REQUIRE(m(3, 1) == before(3, 1) + 3 * x(1, 3));
+    REQUIRE(m(1, 2) == before(1, 2) + 3 * x(2, 1) - x(5, 2));
+    REQUIRE_THROWS_AS(m.block(0, 0, 2, 2) = src, std::out_of_range);
+}
+
+TEST_CASE("sources that read the destination out of place go through a temporary", "[matrix][view]") {
+    dsa::Matrix m = filled(3, 3, 0);
+    m = m.transposed();
+    const int expect[] = {0, 3, 6, 1, 4, 7, 2, 5, 8};
+    for (int k = 0; k < 9; ++k) REQUIRE(m(k / 3, k % 3) == expect[k]);
+
+    // wider than a chunk, mixed with an element-for-element operand
+    dsa::Matrix big = filled(600, 600, 1), big0 = big;
+    big = big + big.transposed();
+    REQUIRE(big(2, 500) == big0(2, 500) + big0(500, 2));
+    REQUIRE(big(599, 3) == big0(599, 3) + big0(3, 599));
+
+    // blocks shifted onto themselves, in both directions
+    dsa::Matrix s = filled(6, 6, 0), s0 = s;
+    s.block(1, 1, 5, 5) = s.block(0, 0, 5, 5);
+    REQUIRE(s(5, 5) == s0(4, 4));
+    REQUIRE(s(1, 1) == s0(0, 0));
+    s = s0;
+    s.block(0, 0, 5, 5) = s.block(1, 1, 5, 5);
+    REQUIRE(s(0, 0) == s0(1, 1));
+    REQUIRE(s(4, 4) == s0(5, 5));
+    s = s0;
+    s.view() = s.transposed();
+    REQUIRE(same(s, s0.transposed()));
+    s = s0;
+    s.block(1, 0, 5, 6).axpy(1, s.block(0, 0, 5, 6));
+    REQUIRE(s(5, 2) == s0(5, 2) + s0(4, 2));
+    REQUIRE(s(2, 2) == s0(2, 2) + s0(1, 2));
+
+    // c += a * b with c sharing storage with a
+    dsa::Matrix g = filled(4, 4, 1), g0 = g;
+    dsa::multiplyAdd(g.view(), g.view(), g0.view(), dsa::execution::seq);
+    dsa::Matrix want = g0 * g0;
+    want += g0;
+    REQUIRE(same(g, want));
+}
+
+TEST_CASE("views go straight into the matrix product", "[matrix][view][gemm]") {
+    dsa::ThreadPool pool(3);
+    dsa::Matrix a = filled(70, 90, -2000), b = filled(90, 60, 5);
+    for (int i = 0; i < 70; ++i)
+        for (int j = 0; j < 90; ++j) a(i, j) %= 17;
+    for (int i = 0; i < 90; ++i)
+        for (int j = 0; j < 60; ++j) b(i, j) %= 13;
+    dsa::Matrix at = a.transposed(), bt = b.transposed();
+
+    REQUIRE(same(a.view() * b.view(), a * b));
+    REQUIRE(same(at.transposed() * bt.transposed(), a * b));
+    REQUIRE(same(dsa::multiply(at.transposed(), b.view(), dsa::execution::seq), a * b));
+
+    // sub-blocks of transposed operands
+    auto lhs = at.transposed().block(3, 5, 40, 50);
+    auto rhs = b.block(7, 2, 50, 33);
+    REQUIRE(same(dsa::multiply(lhs, rhs, dsa::execution::par.on(pool)), naiveProduct(lhs, rhs)));
+
+    // blocked product: C(I, J) += A(I, P) * B(P, J) over 32-wide blocks
+    dsa::Matrix blocked(70, 60);
+    for (std::size_t i = 0; i < 70; i += 32)
+        for (std::size_t j = 0; j < 60; j += 32)
+            for (std::size_t p = 0; p < 90; p += 32) {
+                std::size_t r = std::min<std::size_t>(32, 70 - i), c = std::min<std::size_t>(32, 60 - j),
+                            k = std::min<std::size_t>(32, 90 - p);
+                dsa::multiplyAdd(blocked.block(i, j, r, c), a.block(i, p, r, k), b.block(p, j, k, c),
+                                 dsa::execution::seq);
+            }
+    REQUIRE(same(blocked, a * b));
+
+    // a transposed destination: (C^T) += B^T A^T
+    dsa::Matrix ct(60, 70);
+    dsa::multiplyAdd(ct.transposed(), a.view(), b.view(), dsa::execution::par.on(pool));
+    REQUIRE(same(ct.transposed(), a * b));
+
+    REQUIRE_THROWS_AS(a.view() * a.view(), std::out_of_range);
+    REQUIRE_THROWS_AS(dsa::multiplyAdd(ct.view(), a.view(), b.view()), std::out_of_range);
+}
+
+TEST_CASE("views of floating point matrices", "[matrix][view]") {
+    dsa::BasicMatrix<double> m(3, 5);
+    for (std::size_t i = 0; i < 3; ++i)
+        for (std::size_t j = 0; j < 5; ++j) m(i, j) = 0.5 * static_cast<double>(i * 5 + j);
+    dsa::BasicMatrix<double> t = m.transposed();
+    REQUIRE(t(4, 2) == m(2, 4));
+    dsa::BasicMatrix<double> g = m.view() * m.transposed();
+    double expect = 0;
+    for (std::size_t j = 0; j < 5; ++j) expect += m(1, j) * m(2, j);
+    REQUIRE(g(1, 2) == Approx(expect));
+    REQUIRE(g(2, 1) == Approx(expect));
+}
@@ -0,0 +1,128 @@
+// test_parallel.cpp
+#include "catch2/catch.hpp"
+#include "parallel.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// sizes around the single-chunk cutoff and with ragged ends
+const std::size_t kSizes[] = {0, 1, 7, 4095, 100003, 1000000};
+
+dsa::Vector<std::int64_t> iota(std::size_t n){
+    dsa::Vector<std::int64_t> v;
+    v.reserve(n);
+    for (std::size_t i = 0; i < n; i++)
+        v.push_back(static_cast<std::int64_t>(i % 1000) - 500);
+    return v;
+}
+
+} // namespace
+
+TEST_CASE("parallel chunks start on cache lines", "[parallel]") {
+    dsa::Vector<double> v;
+    v.resize(1000003);
+    for (std::size_t threads : {2, 3, 8}) {
+        dsa::Vector<std::size_t> b = dsa::parallel::detail::split(&v[0], v.size(), threads);
+        REQUIRE(b[0] == 0);
+        REQUIRE(b[b.size() - 1] == v.size());
+        REQUIRE(b.size() > 2);
+        for (std::size_t k = 1; k + 1 < b.size(); k++) {
+            REQUIRE(b[k] > b[k - 1]);
+            REQUIRE(reinterpret_cast<std::uintptr_t>(&v[b[k]]) % 64 == 0);
+        }
+    }
+    // too small to split
+    REQUIRE(dsa::parallel::detail::split(&v[0], 100, 8).size() == 2);
+}
+
+TEST_CASE("parallel for_each and transform visit every element once", "[parallel]") {
+    for (std::size_t workers : {0, 1, 3}) {
+        dsa::ThreadPool pool(workers);
+        for (std::size_t n : kSizes) {
+            dsa::Vector<std::int64_t> v = iota(n);
+            dsa::parallel::for_each(v.begin(), v.end(), [](std::int64_t& x){ x *= 2; }, pool);
+            dsa::Vector<std::int64_t> out;
+            out.resize(n);
+            dsa::parallel::transform(v.begin(), v.end(), out.begin(), [](std::int64_t x){ return x + 1; }, pool);
+            dsa::parallel::transform(out.begin(), out.end(), v.begin(), out.begin(),
+                                     std::minus<std::int64_t>(), pool);
+            REQUIRE(std::all_of(out.begin(), out.end(), [](std::int64_t x){ return x == 1; }));
+        }
+    }
+}
+
+TEST_CASE("parallel reduce and inclusive_scan match the serial result", "[parallel]") {
+    for (std::size_t workers : {0, 2, 5}) {
+        dsa::ThreadPool pool(workers);
+        for (std::size_t n : kSizes) {
+            dsa::Vector<std::int64_t> v = iota(n);
+            std::int64_t expect = std::accumulate(v.begin(), v.end(), std::int64_t{7});
+            REQUIRE(dsa::parallel::reduce(v.begin(), v.end(), std::int64_t{7}, std::plus<>(),
+                                          dsa::parallel::Reduction::fast, pool) == expect);
+            REQUIRE(dsa::parallel::reduce(v.begin(), v.end(), std::int64_t{7}, std::plus<>(),
+                                          dsa::parallel::Reduction::deterministic, pool) == expect);
+
+            std::vector<std::int64_t> serial(n);
+            std::partial_sum(v.begin(), v.end(), serial.begin());
+            dsa::parallel::inclusive_scan(v.begin(), v.end(), v.begin(), std::plus<>(), pool);   // in place
+            REQUIRE(std::equal(v.begin(), v.end(), serial.begin()));
+        }
+    }
+    dsa::Vector<int> m;
+    for (int i = 1; i <= 100000; i++)
+        m.push_back(i % 17 == 0 ? 1000 + i : i % 997);
+    auto larger = [](int a, int b){ return a > b ? a : b; };
+    REQUIRE(dsa::parallel::reduce(m.begin(), m.end(), 0, larger) == *std::max_element(m.begin(), m.end()));
+}
+
+TEST_CASE("deterministic reduce gives the same bits on any pool", "[parallel]") {
+    std::mt19937_64 gen(3);
+    std::uniform_real_distribution<double> dist(-1e6, 1e6);
+    dsa::Vector<double> v;
+    for (int i = 0; i < 1000000; i++)
+        v.push_back(dist(gen) * (i % 3 == 0 ? 1e-9 : 1.0));
+
+    dsa::ThreadPool solo(0);
+    double reference = dsa::parallel::reduce(v.begin(), v.end(), 0.0, std::plus<>(),
+                                             dsa::parallel::Reduction::deterministic, solo);
+    for (std::size_t workers : {1, 2, 3, 7}) {
+        dsa::ThreadPool pool(workers);
+        double s = dsa::parallel::reduce(v.begin(), v.end(), 0.0, std::plus<>(),
+                                         dsa::parallel::Reduction::deterministic, pool);
+        REQUIRE(s == reference);   // exact, not approximate
+    }
+    double serial = std::accumulate(v.begin(), v.end(), 0.0);
+    REQUIRE(reference == Approx(serial).epsilon(1e-9));
+}
+
+TEST_CASE("parallel sort orders like std::sort", "[parallel]") {
+    std::mt19937 gen(11);
+    for (std::size_t workers : {0, 1, 3, 6}) {
+        dsa::ThreadPool pool(workers);
+        for (std::size_t n : {0, 1, 7, 4095, 100003, 250000}) {
+            dsa::Vector<int> v;
+            for (std::size_t i = 0; i < n; i++)
+                v.push_back(static_cast<int>(gen() % 5000));
+            std::vector<int> expect(v.begin(), v.end());
+            std::sort(expect.begin(), expect.end(), std::greater<int>());
+            dsa::parallel::sort(v.begin(), v.end(), std::greater<int>(), pool);
+            REQUIRE(std::equal(v.begin(), v.end(), expect.begin()));
+        }
+    }
+}
+
+TEST_CASE("parallel algorithms rethrow the body's exception", "[parallel]") {
+    dsa::ThreadPool pool(3);
+    dsa::Vector<int> v;
+    v.resize(200000, 1);
+    v[150000] = -1;
+    REQUIRE_THROWS_AS(dsa::parallel::for_each(v.begin(), v.end(), [](int x){
+        if (x < 0) throw std::runtime_error("negative");
+    }, pool), std::runtime_error);
+}
@@ -0,0 +1,203 @@
+// test_serialization.cpp
+#include "catch2/catch.hpp"
+#include "serialization.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+namespace {
+
+template <typename T>
+void fillMatrix(dsa::BasicMatrix<T>& m){
+    for (std::size_t i = 0; i < m.getRows(); i++)
+        for (std::size_t j = 0; j < m.getCols(); j++)
+            m(i, j) = static_cast<T>(i * 1000 + j) / 4;
+}
+
+template <typename T>
+bool sameMatrix(const dsa::BasicMatrix<T>& a, const dsa::BasicMatrix<T>& b){
+    if (a.getRows() != b.getRows() || a.getCols() != b.getCols())
+        return false;
+    for (std::size_t i = 0; i < a.getRows(); i++)
+        for (std::size_t j = 0; j < a.getCols(); j++)
+            if (a(i, j) != b(i, j))
+                return false;
+    return true;
+}
+
+std::string tempPath(const char* name){
+    std::FILE* shm = std::fopen("/dev/shm/.dsa_probe", "w");
+    std::string dir = shm ? "/dev/shm" : "/tmp";
+    if (shm) {
+        std::fclose(shm);
+        std::remove("/dev/shm/.dsa_probe");
+    }
+    return dir + "/dsa_serialization_" + name;
+}
+
+} // namespace
+
+TEST_CASE("Vector round-trips through a binary stream", "[serialization]") {
+    dsa::Vector<std::int64_t> v;
+    for (std::int64_t i = 0; i < 10000; i++)
+        v.push_back(i * i - 5000);
+
+    std::stringstream buf;
+    dsa::save(v, buf);
+    REQUIRE(buf.str().size() == 64 + 10000 * sizeof(std::int64_t));
+
+    dsa::Vector<std::int64_t> w;
+    w.push_back(99);                     // replaced, not appended to
+    dsa::load(buf, w);
+    REQUIRE(w.size() == v.size());
+    for (std::size_t i = 0; i < v.size(); i++)
+        REQUIRE(w[i] == v[i]);
+
+    dsa::Vector<double> empty, back;
+    std::stringstream buf2;
+    dsa::save(empty, buf2);
+    dsa::load(buf2, back);
+    REQUIRE(back.empty());
+}
+
+TEST_CASE("Matrix round-trips with padded and packed rows", "[serialization]") {
+    dsa::BasicMatrix<float> padded(7, 5);          // stride 16
+    dsa::BasicMatrix<float> packed(7, 5, 0);       // stride 5
+    fillMatrix(padded);
+    fillMatrix(packed);
+
+    std::stringstream a, b;
+    dsa::save(padded, a);
+    dsa::save(packed, b);
+    REQUIRE(a.str() == b.str());                   // padding is not saved
+    REQUIRE(a.str().size() == 64 + 7 * 5 * sizeof(float));
+
+    dsa::BasicMatrix<float> m(1, 1);
+    dsa::load(a, m);
+    REQUIRE(sameMatrix(m, padded));
+    REQUIRE(m.getStride() == padded.getStride());
+
+    dsa::BasicMatrix<double> wide(3, 64);          // stride == cols: one read
+    fillMatrix(wide);
+    std::stringstream c;
+    dsa::save(wide, c);
+    dsa::BasicMatrix<double> w(0, 0);
+    dsa::load(c, w);
+    REQUIRE(sameMatrix(w, wide));
+}
+
+TEST_CASE("load rejects other types, kinds and corrupt data", "[serialization]") {
+    dsa::Vector<int> v;
+    for (int i = 0; i < 100; i++)
+        v.push_back(i);
+    std::stringstream buf;
+    dsa::save(v, buf);
+    const std::string good = buf.str();
+
+    dsa::Vector<float> f;
+    std::stringstream s1(good);
+    REQUIRE_THROWS_AS(dsa::load(s1, f), std::runtime_error);        // int is not float
+
+    dsa::Vector<unsigned> u;
+    std::stringstream s2(good);
+    REQUIRE_THROWS_AS(dsa::load(s2, u), std::runtime_error);        // signedness differs
+
+    dsa::BasicMatrix<int> m(2, 2);
+    std::stringstream s3(good);
+    REQUIRE_THROWS_AS(dsa::load(s3, m), std::runtime_error);        // vector, not matrix
+    REQUIRE(m.getRows() == 2);
+
+    std::string flipped = good;
+    flipped[64 + 17] ^= 1;
+    dsa::Vector<int> w;
+    std::stringstream s4(flipped);
+    REQUIRE_THROWS_AS(dsa::load(s4, w), std::runtime_error);        // checksum
+    REQUIRE(w.empty());
+
+    std::stringstream s5(good.substr(0, good.size() - 4));
+    REQUIRE_THROWS_AS(dsa::load(s5, w), std::runtime_error);        // truncated
+
+    std::stringstream s6(std::string(64, 'x'));
+    REQUIRE_THROWS_AS(dsa::load(s6, w), std::runtime_error);        // no magic
+}
+
+TEST_CASE("load reports a file from the other byte order", "[serialization]") {
+    dsa::Vector<int> v;
+    v.push_back(1);
+    std::stringstream buf;
+    dsa::save(v, buf);
+    std::string swapped = buf.str();
+
+    // what the header looks like when written on a machine of the other byte order
+    auto swapField = [&](std::size_t offset, std::size_t size){
+        std::reverse(swapped.begin() + offset, swapped.begin() + offset + size);
+    };
+    swapField(offsetof(dsa::detail::FileHeader, version), sizeof(std::uint16_t));
+    swapField(offsetof(dsa::detail::FileHeader, byteOrder), sizeof(std::uint32_t));
+
+    dsa::Vector<int> w;
+    std::stringstream in(swapped);
+    REQUIRE_THROWS_WITH(dsa::load(in, w), "dsa file was written with the other byte order");
+}
+
+TEST_CASE("load checks a huge size against the stream before allocating", "[serialization]") {
+    dsa::Vector<int> v;
+    v.push_back(1);
+    std::stringstream buf;
+    dsa::save(v, buf);
+    std::string forged = buf.str();
+
+    // claim 2^40 ints (4 TiB) while the stream holds one
+    auto setField = [&](std::size_t offset, std::uint64_t value){
+        std::memcpy(&forged[offset], &value, sizeof(value));
+    };
+    setField(offsetof(dsa::detail::FileHeader, rows), std::uint64_t(1) << 40);
+    setField(offsetof(dsa::detail::FileHeader, payloadBytes), (std::uint64_t(1) << 40) * sizeof(int));
+
+    dsa::Vector<int> w;
+    std::stringstream s1(forged);
+    REQUIRE_THROWS_WITH(dsa::load(s1, w), "dsa file is truncated");
+    REQUIRE(w.empty());
+
+    // the same header as a 2^20 x 2^20 matrix
+    forged[offsetof(dsa::detail::FileHeader, kind)] = 2;
+    setField(offsetof(dsa::detail::FileHeader, rows), std::uint64_t(1) << 20);
+    setField(offsetof(dsa::detail::FileHeader, cols), std::uint64_t(1) << 20);
+    dsa::BasicMatrix<int> m(1, 1);
+    std::stringstream s2(forged);
+    REQUIRE_THROWS_WITH(dsa::load(s2, m), "dsa file is truncated");
+    REQUIRE(m.getRows() == 1);
+}
+
+TEST_CASE("saveFile/loadFile and MappedArray read the same file", "[serialization]") {
+    const std::string path = tempPath("matrix");
+    dsa::BasicMatrix<double> m(33, 17);
+    fillMatrix(m);
+    dsa::saveFile(path, m);
+
+    dsa::BasicMatrix<double> back(0, 0);
+    dsa::loadFile(path, back);
+    REQUIRE(sameMatrix(back, m));
+
+#if defined(__unix__) || defined(__APPLE__)
+    {
+        dsa::MappedArray<double> view(path);
+        REQUIRE(view.isMatrix());
+        REQUIRE(view.getRows() == 33);
+        REQUIRE(view.getCols() == 17);
+        REQUIRE(view.size() == 33 * 17);
+        REQUIRE(view.verify());
+        for (std::size_t i = 0; i < 33; i++)
+            for (std::size_t j = 0; j < 17; j++)
+                REQUIRE(view(i, j) == m(i, j));
+        REQUIRE(view.row(2)[3] == m(2, 3));
+        REQUIRE_THROWS_AS(dsa::MappedArray<float>(path), std::runtime_error);
+    }
+#endif
+    std::remove(path.c_str());
+    REQUIRE_THROWS_AS(dsa::loadFile(path, back), std::runtime_error);
+}
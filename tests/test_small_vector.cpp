@@ -0,0 +1,109 @@
+// test_small_vector.cpp
+#include "catch2/catch.hpp"
+#include "small_vector.hpp"
+#include <memory>
+#include <string>
+
+namespace {
+
+int heapBlocks = 0;  // live blocks from CountingAllocator
+
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+    CountingAllocator() = default;
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&) {}
+    T* allocate(std::size_t n){ heapBlocks++; return std::allocator<T>().allocate(n); }
+    void deallocate(T* p, std::size_t n){ heapBlocks--; std::allocator<T>().deallocate(p, n); }
+    bool operator==(const CountingAllocator&) const { return true; }
+    bool operator!=(const CountingAllocator&) const { return false; }
+};
+
+using Small = dsa::SmallVector<std::string, 4, CountingAllocator<std::string>>;
+
+}
+
+TEST_CASE("SmallVector stays inline up to N elements", "[small_vector]") {
+    heapBlocks = 0;
+    {
+        Small v;
+        REQUIRE(v.capacity() == 4);
+        REQUIRE(Small::inline_capacity == 4);
+        for (int i{0}; i < 4; ++i)
+            v.push_back(std::to_string(i));
+        REQUIRE(heapBlocks == 0);
+
+        v.push_back("4");                // spills
+        REQUIRE(heapBlocks == 1);
+        REQUIRE(v.capacity() == 8);
+        REQUIRE(v[0] == "0");
+        REQUIRE(v[4] == "4");
+
+        v.pop_back();
+        v.pop_back();
+        v.shrink_to_fit();               // back into the inline buffer
+        REQUIRE(heapBlocks == 0);
+        REQUIRE(v.capacity() == 4);
+        REQUIRE(v.back() == "2");
+    }
+    REQUIRE(heapBlocks == 0);
+}
+
+TEST_CASE("SmallVector shares Vector's API and iterators", "[small_vector]") {
+    dsa::SmallVector<int, 8> v;
+    for (int i{0}; i < 6; ++i)
+        v.push_back(i);
+    v.insert(0, 10);
+    v.erase(3);
+    v.emplace(v.begin(), 20);
+
+    int sum = 0;
+    for (auto it = v.begin(); it != v.end(); ++it)
+        sum += *it;
+    REQUIRE(sum == 20 + 10 + 0 + 1 + 3 + 4 + 5);
+    REQUIRE(v.at(0) == 20);
+    REQUIRE_THROWS_AS(v.at(7), std::out_of_range);
+
+    dsa::SmallVector<int, 8>::const_iterator cit = static_cast<const dsa::SmallVector<int, 8>&>(v).begin();
+    REQUIRE(*cit == 20);
+}
+
+TEST_CASE("SmallVector copies and moves inline and spilled contents", "[small_vector]") {
+    heapBlocks = 0;
+    {
+        Small in, out;
+        in.push_back("a");
+        in.push_back("b");
+        for (int i{0}; i < 10; ++i)
+            out.push_back(std::string(30, static_cast<char>('a' + i)));
+        REQUIRE(heapBlocks == 1);
+
+        Small copyIn(in), copyOut(out);
+        REQUIRE(copyIn[1] == "b");
+        REQUIRE(copyOut[9] == std::string(30, 'j'));
+        REQUIRE(heapBlocks == 2);
+
+        Small movedIn(std::move(in));    // inline: elements relocate
+        REQUIRE(movedIn.size() == 2);
+        REQUIRE(movedIn[0] == "a");
+        REQUIRE(in.size() == 0);
+        REQUIRE(in.capacity() == 4);
+
+        Small movedOut(std::move(out));  // heap block is stolen
+        REQUIRE(heapBlocks == 2);
+        REQUIRE(movedOut.size() == 10);
+        REQUIRE(out.capacity() == 4);
+
+        copyOut = movedIn;               // heap -> inline on assignment
+        REQUIRE(heapBlocks == 1);
+        REQUIRE(copyOut.size() == 2);
+
+        swap(movedIn, movedOut);         // mixed inline/heap swap
+        REQUIRE(movedIn.size() == 10);
+        REQUIRE(movedOut.size() == 2);
+        REQUIRE(movedOut[1] == "b");
+        REQUIRE(movedIn[0] == std::string(30, 'a'));
+    }
+    REQUIRE(heapBlocks == 0);
+}
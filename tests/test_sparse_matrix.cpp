@@ -0,0 +1,170 @@
+// test_sparse_matrix.cpp
+#include "catch2/catch.hpp"
+#include "sparse_matrix.hpp"
+#include "thread_pool.hpp"
+#include <random>
+#include <stdexcept>
+
+namespace {
+
+using Sparse = dsa::SparseMatrix<int>;
+
+// dense matrix with about density of its cells set to small non-zero ints
+dsa::Matrix randomDense(int rows, int cols, double density, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    dsa::Matrix m(rows, cols);
+    for (int i = 0; i < rows; ++i)
+        for (int j = 0; j < cols; ++j)
+            if (coin(gen) < density)
+                m(i, j) = static_cast<int>(gen() % 19) - 9 + (gen() % 2 ? 10 : -10);
+    return m;
+}
+
+bool same(const dsa::Matrix& X, const dsa::Matrix& Y) {
+    if (X.getRows() != Y.getRows() || X.getCols() != Y.getCols()) return false;
+    for (std::size_t i = 0; i < X.getRows(); ++i)
+        for (std::size_t j = 0; j < X.getCols(); ++j)
+            if (X(i, j) != Y(i, j)) return false;
+    return true;
+}
+
+}
+
+TEST_CASE("SparseMatrix builds in COO and compresses to CSR and CSC", "[sparse]") {
+    Sparse a(3, 4);
+    REQUIRE(a.format() == dsa::SparseFormat::coo);
+    a.insert(2, 1, 5);
+    a.insert(0, 3, 1);
+    a.insert(2, 1, 2);    // duplicate: summed
+    a.insert(1, 0, 4);
+    a.insert(1, 2, 3);
+    a.insert(1, 2, -3);   // cancels: dropped
+    REQUIRE(a.nonZeros() == 6);
+    REQUIRE(a(2, 1) == 7);
+    REQUIRE(a(1, 2) == 0);
+
+    Sparse csr = a.toCSR();
+    REQUIRE(csr.format() == dsa::SparseFormat::csr);
+    REQUIRE(csr.nonZeros() == 3);
+    const std::size_t offsets[] = {0, 1, 2, 3};
+    const unsigned cols[] = {3, 0, 1};
+    const int values[] = {1, 4, 7};
+    for (std::size_t k = 0; k < 4; ++k) REQUIRE(csr.getOffsets()[k] == offsets[k]);
+    for (std::size_t k = 0; k < 3; ++k) {
+        REQUIRE(csr.getInner()[k] == cols[k]);
+        REQUIRE(csr.getValues()[k] == values[k]);
+    }
+
+    Sparse csc = a.toCSC();
+    REQUIRE(csc.format() == dsa::SparseFormat::csc);
+    REQUIRE(csc.getOffsets().size() == 5);
+    REQUIRE(csc.nonZeros() == 3);
+    for (std::size_t i = 0; i < 3; ++i)
+        for (std::size_t j = 0; j < 4; ++j) {
+            REQUIRE(csc(i, j) == a(i, j));
+            REQUIRE(csr(i, j) == a(i, j));
+        }
+    REQUIRE(same(csc.toCSR().toCOO().toDense(), csr.toDense()));
+
+    REQUIRE_THROWS_AS(a.insert(3, 0, 1), std::out_of_range);
+    REQUIRE_THROWS_AS(csr.insert(0, 0, 1), std::logic_error);
+    REQUIRE_THROWS_AS(csr(0, 4), std::out_of_range);
+    REQUIRE_THROWS_AS(Sparse(-1, 2), std::out_of_range);
+    REQUIRE_THROWS_AS((dsa::SparseMatrix<int, std::uint8_t>(300, 2)), std::length_error);
+}
+
+TEST_CASE("SparseMatrix round-trips dense matrices", "[sparse]") {
+    for (double density : {0.0, 0.01, 0.3, 1.0}) {
+        dsa::Matrix d = randomDense(37, 53, density, 5);
+        for (auto f : {dsa::SparseFormat::coo, dsa::SparseFormat::csr, dsa::SparseFormat::csc}) {
+            Sparse s = Sparse::fromDense(d, f);
+            REQUIRE(s.format() == f);
+            REQUIRE(same(s.toDense(), d));
+        }
+    }
+    Sparse empty(0, 0);
+    REQUIRE(empty.toCSR().toDense().getRows() == 0);
+
+    // a 1%-dense matrix stores far less than its dense form
+    dsa::Matrix d = randomDense(400, 400, 0.01, 8);
+    Sparse s = Sparse::fromDense(d);
+    REQUIRE(s.memoryBytes() * 20 < d.getRows() * d.getStride() * sizeof(int));
+}
+
+TEST_CASE("SparseMatrix addition", "[sparse]") {
+    dsa::Matrix da = randomDense(30, 41, 0.1, 1), db = randomDense(30, 41, 0.1, 2);
+    dsa::Matrix expect = da + db;
+    Sparse a = Sparse::fromDense(da, dsa::SparseFormat::coo);
+    Sparse b = Sparse::fromDense(db, dsa::SparseFormat::csc);
+
+    Sparse sum = a + b;
+    REQUIRE(sum.format() == dsa::SparseFormat::csr);
+    REQUIRE(same(sum.toDense(), expect));
+    Sparse csc_sum = a.toCSC() + b;
+    REQUIRE(csc_sum.format() == dsa::SparseFormat::csc);
+    REQUIRE(same(csc_sum.toDense(), expect));
+
+    REQUIRE(same(a + db, expect));
+    REQUIRE(same(da + b, expect));
+
+    // x + (-x) stores nothing
+    dsa::Matrix neg = da * -1;
+    REQUIRE((a + Sparse::fromDense(neg)).nonZeros() == 0);
+
+    REQUIRE_THROWS_AS(a + Sparse(30, 40), std::out_of_range);
+    REQUIRE_THROWS_AS(a + dsa::Matrix(31, 41), std::out_of_range);
+}
+
+TEST_CASE("SparseMatrix SpMV and SpMM match the dense product", "[sparse]") {
+    dsa::ThreadPool pool(3);
+    dsa::Matrix dA = randomDense(60, 45, 0.05, 3), dB = randomDense(45, 70, 0.5, 4);
+    dsa::Matrix expect = dA.multiply(dB, pool);
+
+    dsa::Matrix xcol(45, 1);
+    dsa::Vector<int> x;
+    for (int j = 0; j < 45; ++j) {
+        x.push_back(j % 7 - 3);
+        xcol(j, 0) = j % 7 - 3;
+    }
+    dsa::Matrix ycol = dA.multiply(xcol, pool);
+
+    for (auto f : {dsa::SparseFormat::coo, dsa::SparseFormat::csr, dsa::SparseFormat::csc}) {
+        Sparse A = Sparse::fromDense(dA, f);
+        dsa::Vector<int> y = A * x;
+        dsa::Vector<int> yp = A.multiply(x, dsa::execution::par.on(pool).withGrain(4));
+        REQUIRE(y.size() == 60);
+        bool ok = true;
+        for (std::size_t i = 0; i < 60; ++i)
+            ok = ok && y[i] == ycol(i, 0) && yp[i] == y[i];
+        REQUIRE(ok);
+
+        REQUIRE(same(A * dB, expect));
+        REQUIRE(same(A.multiply(dB, dsa::execution::par.on(pool)), expect));
+        Sparse B = Sparse::fromDense(dB, f);
+        Sparse C = A * B;
+        REQUIRE(C.format() == dsa::SparseFormat::csr);
+        REQUIRE(same(C.toDense(), expect));
+    }
+
+    Sparse A = Sparse::fromDense(dA);
+    REQUIRE_THROWS_AS(A * dsa::Vector<int>(), std::out_of_range);
+    REQUIRE_THROWS_AS(A * dA, std::out_of_range);
+    REQUIRE_THROWS_AS(A * A, std::out_of_range);
+}
+
+TEST_CASE("SparseMatrix works with floating point values", "[sparse]") {
+    dsa::SparseMatrix<double> a(2, 2);
+    a.insert(0, 0, 0.5);
+    a.insert(1, 1, 0.25);
+    a.insert(1, 0, 1.5);
+    dsa::Vector<double> x;
+    x.push_back(2.0);
+    x.push_back(4.0);
+    dsa::Vector<double> y = a.toCSC() * x;
+    REQUIRE(y[0] == Approx(1.0));
+    REQUIRE(y[1] == Approx(4.0));
+    dsa::BasicMatrix<double> d = a.toDense();
+    REQUIRE(d(1, 0) == 1.5);
+    REQUIRE(d(0, 1) == 0.0);
+}
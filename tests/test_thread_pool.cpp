@@ -0,0 +1,191 @@
+// test_thread_pool.cpp
+#include "catch2/catch.hpp"
+#include "execution.hpp"
+#include "matrix.hpp"
+#include "parallel.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// the threads that ran body over [0, n)
+template <typename Run>
+std::set<std::thread::id> threadsUsed(std::size_t n, Run run) {
+    std::mutex lock;
+    std::set<std::thread::id> ids;
+    run(n, [&](std::size_t) {
+        std::lock_guard<std::mutex> guard(lock);
+        ids.insert(std::this_thread::get_id());
+    });
+    return ids;
+}
+
+}
+
+TEST_CASE("ThreadPool parallel_for honours the grain", "[thread_pool]") {
+    dsa::ThreadPool pool(3);
+    for (std::size_t grain : {1u, 7u, 64u, 1000u}) {
+        std::vector<std::atomic<int>> hits(1000);
+        for (auto& h : hits) h = 0;
+        pool.parallel_for(0, hits.size(), grain, [&](std::size_t i) { hits[i]++; });
+        REQUIRE(std::all_of(hits.begin(), hits.end(), [](const std::atomic<int>& h) { return h == 1; }));
+    }
+    // one piece: never leaves the caller
+    auto ids = threadsUsed(100, [&](std::size_t n, std::function<void(std::size_t)> body) {
+        pool.parallel_for(0, n, n, body);
+    });
+    REQUIRE(ids.size() == 1);
+    REQUIRE(*ids.begin() == std::this_thread::get_id());
+    REQUIRE(pool.defaultGrain(0) == 1);
+    REQUIRE(pool.defaultGrain(3200) == 100);
+}
+
+TEST_CASE("ThreadPool idle workers steal irregular work", "[thread_pool]") {
+    dsa::ThreadPool pool(3);
+    // the caller keeps the lowest piece, so the slow front has to be stolen
+    auto ids = threadsUsed(32, [&](std::size_t n, std::function<void(std::size_t)> body) {
+        pool.parallel_for(0, n, 1, [&](std::size_t i) {
+            if (i < 8) std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            body(i);
+        });
+    });
+    REQUIRE(ids.size() > 1);
+}
+
+TEST_CASE("ThreadPool submit runs every task before the pool is gone", "[thread_pool]") {
+    std::atomic<int> done{0};
+    {
+        dsa::ThreadPool pool(2);
+        for (int i = 0; i < 200; i++)
+            pool.submit([&] { done++; });
+        // tasks may fork and join from inside a worker
+        pool.submit([&] {
+            pool.parallel_for(0, 50, 1, [&](std::size_t) { done++; });
+        });
+    }
+    REQUIRE(done == 250);
+
+    dsa::ThreadPool inline_pool(0);
+    inline_pool.submit([&] { done++; });
+    REQUIRE(done == 251);
+}
+
+TEST_CASE("ThreadPool with pinned workers still runs everything", "[thread_pool]") {
+    dsa::ThreadPool pool(2, dsa::ThreadPool::Affinity::pinned);
+    REQUIRE(pool.size() == 2);
+    std::atomic<int> total{0};
+    pool.parallel_for(0, 1000, 1, [&](std::size_t) { total++; });
+    REQUIRE(total == 1000);
+    REQUIRE_FALSE(dsa::ThreadPool(2).pinned());
+    REQUIRE_FALSE(dsa::ThreadPool(0, dsa::ThreadPool::Affinity::pinned).pinned());
+}
+
+TEST_CASE("ThreadPool keeps the first exception and finishes the rest", "[thread_pool]") {
+    dsa::ThreadPool pool(3);
+    std::atomic<int> ran{0};
+    REQUIRE_THROWS_AS(pool.parallel_for(0, 256, 1, [&](std::size_t i) {
+        ran++;
+        if (i % 50 == 3) throw std::runtime_error("boom");
+    }), std::runtime_error);
+    REQUIRE(ran == 256);   // one failing piece does not cancel the others
+
+    std::atomic<int> total{0};
+    pool.parallel_for(0, 100, [&](std::size_t) { total++; });   // still usable
+    REQUIRE(total == 100);
+}
+
+TEST_CASE("a throwing submitted task run by a helping caller waits for the join", "[thread_pool]") {
+    dsa::ThreadPool pool(1);
+    std::atomic<bool> release{false}, busy{false};
+    pool.submit([&] {
+        busy = true;
+        while (!release) std::this_thread::yield();
+    });
+    while (!busy) std::this_thread::yield();
+    // queued ahead of the pieces, so the caller steals it while helping
+    pool.submit([] { throw std::logic_error("foreign"); });
+
+    std::atomic<int> ran{0};
+    // the worker stays busy until the last piece, so the caller runs them all
+    REQUIRE_THROWS_AS(pool.parallel_for(0, 64, 1, [&](std::size_t) {
+        if (++ran == 64) release = true;
+    }), std::logic_error);
+    REQUIRE(ran == 64);
+
+    // many short joins back to back: the caller must not outrun the last done()
+    std::atomic<long> total{0};
+    for (int k = 0; k < 2000; k++)
+        pool.parallel_for(0, 8, 1, [&](std::size_t) { total++; });
+    REQUIRE(total == 16000);
+}
+
+TEST_CASE("execution policies pick the pool and the grain", "[thread_pool][parallel]") {
+    dsa::ThreadPool pool(3);
+    dsa::Vector<long> v;
+    for (long i = 0; i < 300000; i++)
+        v.push_back(i % 1000 - 500);
+    long expect = std::accumulate(v.begin(), v.end(), 0L);
+
+    // seq: the caller alone
+    std::mutex lock;
+    std::set<std::thread::id> ids;
+    dsa::parallel::for_each(dsa::execution::seq, v.begin(), v.end(), [&](long&) {
+        std::lock_guard<std::mutex> guard(lock);
+        ids.insert(std::this_thread::get_id());
+    });
+    REQUIRE(ids.size() == 1);
+    REQUIRE(*ids.begin() == std::this_thread::get_id());
+
+    REQUIRE(dsa::parallel::reduce(dsa::execution::seq, v.begin(), v.end(), 0L) == expect);
+    REQUIRE(dsa::parallel::reduce(dsa::execution::par, v.begin(), v.end(), 0L) == expect);
+    auto fine = dsa::execution::par.on(pool).withGrain(1000);
+    REQUIRE(&fine.getPool() == &pool);
+    REQUIRE(dsa::parallel::detail::split(&v[0], v.size(), pool.concurrency(), 1000).size() ==
+            pool.concurrency() * dsa::parallel::kChunksPerThread + 1);
+    REQUIRE(dsa::parallel::reduce(fine, v.begin(), v.end(), 0L, std::plus<>(),
+                                  dsa::parallel::Reduction::deterministic) == expect);
+
+    dsa::Vector<long> out;
+    out.resize(v.size());
+    dsa::parallel::transform(fine, v.begin(), v.end(), out.begin(), [](long x) { return 2 * x; });
+    dsa::parallel::transform(fine, out.begin(), out.end(), v.begin(), out.begin(), std::minus<long>());
+    REQUIRE(std::equal(out.begin(), out.end(), v.begin()));
+
+    std::vector<long> scanned(v.size());
+    std::partial_sum(v.begin(), v.end(), scanned.begin());
+    dsa::parallel::inclusive_scan(fine, v.begin(), v.end(), out.begin());
+    REQUIRE(std::equal(out.begin(), out.end(), scanned.begin()));
+
+    dsa::parallel::sort(fine, v.begin(), v.end(), std::greater<long>());
+    REQUIRE(std::is_sorted(v.begin(), v.end(), std::greater<long>()));
+}
+
+TEST_CASE("Matrix multiply takes an execution policy", "[thread_pool][matrix]") {
+    dsa::ThreadPool pool(2);
+    dsa::Matrix A(150, 90), B(90, 700);
+    for (std::size_t i = 0; i < A.getRows(); ++i)
+        for (std::size_t j = 0; j < A.getCols(); ++j)
+            A(i, j) = static_cast<int>((i * 7 + j * 3) % 11) - 5;
+    for (std::size_t i = 0; i < B.getRows(); ++i)
+        for (std::size_t j = 0; j < B.getCols(); ++j)
+            B(i, j) = static_cast<int>((i * 5 + j) % 9) - 4;
+
+    dsa::Matrix serial = A.multiply(B, dsa::execution::seq);
+    dsa::Matrix parallel = A.multiply(B, dsa::execution::par.on(pool).withGrain(1));
+    dsa::Matrix viaPool = A.multiply(B, pool);
+    bool same = true;
+    for (std::size_t i = 0; i < serial.getRows(); ++i)
+        for (std::size_t j = 0; j < serial.getCols(); ++j)
+            same = same && serial(i, j) == parallel(i, j) && serial(i, j) == viaPool(i, j);
+    REQUIRE(same);
+    REQUIRE_THROWS_AS(B.multiply(B, dsa::execution::seq), std::out_of_range);
+}
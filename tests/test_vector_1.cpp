@@ -2,7 +2,13 @@
 #define CATCH_CONFIG_MAIN
 #include "catch2/catch.hpp"
 #include "vector.hpp"
+#include <cstddef>
+#include <cstdlib>
+#include <iterator>
+#include <memory>
+#include <sstream>
 #include <stdexcept>
+#include <string>
 
 // test cases from Part 1
 // create const vector for testing
@@ -11,7 +17,7 @@ TEST_CASE("Default constructor creates empty vector", "[constructor]") {
     bool ok{true};
     REQUIRE(ok);
     REQUIRE(v.size() == 0);
-    REQUIRE(v.capacity() >= 0);
+    REQUIRE(v.capacity() >= v.size());
 }
 
 TEST_CASE("Reserve increases capacity", "[reserve]") {
@@ -19,7 +25,7 @@ TEST_CASE("Reserve increases capacity", "[reserve]") {
     for (int i{0}; i < 5; ++i) 
         v.push_back(i);
     
-    int old_cap = v.capacity();
+    std::size_t old_cap = v.capacity();
 
     v.reserve(old_cap + 2);
     REQUIRE(v.capacity() == old_cap + 2);
@@ -38,7 +44,7 @@ TEST_CASE("Reserve with small", "[reserve]") {
     for (int i{0}; i < 5; ++i) 
         v.push_back(i);
 
-    int old_cap = v.capacity();
+    std::size_t old_cap = v.capacity();
     v.reserve(1);
     REQUIRE(v.capacity() == old_cap);
 }
@@ -47,7 +53,7 @@ TEST_CASE("push_back grows size and stores", "[push_back]") {
     dsa::Vector<int> v;
     for (int i = 0; i < 5; ++i) {
         v.push_back(i);
-        REQUIRE(v.size() == i + 1);
+        REQUIRE(v.size() == static_cast<std::size_t>(i) + 1);
         REQUIRE(v[i] == i);
     }
 }
@@ -57,7 +63,7 @@ TEST_CASE("pop_back reduces size", "[pop_back]") {
     for (int i{0}; i < 5; ++i) 
         v.push_back(i);
 
-    int old_cap = v.capacity();
+    std::size_t old_cap = v.capacity();
     v.pop_back();
     REQUIRE(v.size() == 4);
     REQUIRE(v.capacity() <= old_cap); // shrink may happen
@@ -66,10 +72,23 @@ TEST_CASE("pop_back reduces size", "[pop_back]") {
 TEST_CASE("pop_back on empty vector", "[pop_back][edge]") {
     dsa::Vector<int> v;
     REQUIRE(v.size() == 0);
-    v.pop_back(); // should not throw
-    REQUIRE(v.size() == -1);
+    REQUIRE_THROWS_AS(v.pop_back(), std::out_of_range);
+    REQUIRE(v.size() == 0);
 }
 
+TEST_CASE("pop_back and erase on empty vector leave non-trivial elements alone", "[pop_back][erase][edge]") {
+    dsa::Vector<std::string> v;
+    REQUIRE_THROWS_AS(v.pop_back(), std::out_of_range);
+    REQUIRE_THROWS_AS(v.erase(0), std::out_of_range);
+    REQUIRE(v.size() == 0);
+
+    v.push_back("a long string that does not fit the small-string buffer");
+    v.pop_back();
+    REQUIRE_THROWS_AS(v.pop_back(), std::out_of_range);
+    REQUIRE_THROWS_AS(v.erase(v.begin()), std::out_of_range);
+    REQUIRE(v.empty());
+}   // destructor must only see the 0 live elements
+
 TEST_CASE("insert in middle and end", "[insert]") {
     dsa::Vector<int> v;
     for (int i{0}; i < 5; ++i) 
@@ -219,7 +238,7 @@ TEST_CASE("shrink when size <= cap/4, shrink keeps at least one slot", "[shrink]
     dsa::Vector<int> v;
     for (int i{0}; i < 5; ++i) 
         v.push_back(i);
-    int old_cap = v.capacity();
+    std::size_t old_cap = v.capacity();
 
     // Remove elements so size <= cap/4
     for (int i = 0; i < 4; ++i)
@@ -235,7 +254,7 @@ TEST_CASE("shrink when size > cap/4", "[shrink]") {
     for (int i{0}; i < 5; ++i) 
         v.push_back(i);
 
-    int old_cap = v.capacity();
+    std::size_t old_cap = v.capacity();
     v.shrink();
     REQUIRE(v.capacity() == old_cap); // should not shrink
 }
@@ -245,7 +264,7 @@ TEST_CASE("shrink via pop-back", "[shrink][pop-back]") {
     for (int i{0}; i < 5; ++i) 
         v.push_back(i);
 
-    int old_cap = v.capacity(); //cap = 8
+    std::size_t old_cap = v.capacity(); //cap = 8
     for (int i = 0; i < 3; ++i) 
         v.pop_back();  // shrink triggered internally, until size <= cap/4 = 2
 
@@ -278,7 +297,408 @@ TEST_CASE("shrink_to_fit when size==cap", "[shrink][edge]") {
     dsa::Vector<int> v;
     for (int i{0}; i < 4; ++i) 
         v.push_back(i);
-    int old_cap = v.capacity();
+    std::size_t old_cap = v.capacity();
     v.shrink_to_fit();
     REQUIRE(v.capacity() == old_cap); // 4 elements
-}
\ No newline at end of file
+}
+TEST_CASE("reserve does not default-construct spare capacity", "[reserve][storage]") {
+    struct NoDefault {
+        int value;
+        explicit NoDefault(int v) : value(v) {}
+    };
+
+    dsa::Vector<NoDefault> v;
+    v.reserve(16);
+    REQUIRE(v.capacity() == 16);
+    REQUIRE(v.size() == 0);
+
+    for (int i{0}; i < 40; ++i)
+        v.push_back(NoDefault(i));
+    for (int i{0}; i < 40; ++i)
+        REQUIRE(v[i].value == i);
+}
+
+TEST_CASE("growth keeps non-trivial elements intact", "[reserve][storage]") {
+    dsa::Vector<std::string> v;
+    for (int i{0}; i < 100; ++i)
+        v.push_back(std::string(32, static_cast<char>('a' + i % 26)));
+
+    v.push_back(v[0]); // element aliasing the buffer that is about to move
+    v.insert(1, v[2]);
+    REQUIRE(v.size() == 102);
+    REQUIRE(v.back() == std::string(32, 'a'));
+    REQUIRE(v[1] == std::string(32, 'c'));
+    REQUIRE(v[2] == std::string(32, 'b'));
+
+    v.shrink_to_fit();
+    REQUIRE(v[99 + 1] == std::string(32, 'v'));
+}
+
+TEST_CASE("push_back and insert accept rvalues", "[push_back][insert][move]") {
+    dsa::Vector<std::string> v;
+    std::string s(40, 'x');
+    v.push_back(std::move(s));
+    REQUIRE(v.size() == 1);
+    REQUIRE(v[0] == std::string(40, 'x'));
+
+    std::string t(40, 'y');
+    v.insert(0, std::move(t));
+    REQUIRE(v[0] == std::string(40, 'y'));
+    REQUIRE(v[1] == std::string(40, 'x'));
+}
+
+TEST_CASE("emplace_back and emplace construct in place", "[emplace]") {
+    dsa::Vector<std::string> v;
+    REQUIRE(v.emplace_back(3, 'a') == "aaa");
+    v.emplace_back("ccc");
+    v.emplace(1, 3, 'b');
+    REQUIRE(v.size() == 3);
+    REQUIRE(v[0] == "aaa");
+    REQUIRE(v[1] == "bbb");
+    REQUIRE(v[2] == "ccc");
+
+    auto it = v.emplace(v.begin(), "zzz");
+    REQUIRE(*it == "zzz");
+    REQUIRE(v.size() == 4);
+    REQUIRE(v.back() == "ccc");
+}
+
+TEST_CASE("size_type is 64-bit and growth saturates at max_size", "[size_type]") {
+    using size_type = dsa::Vector<unsigned char>::size_type;
+    REQUIRE(sizeof(size_type) >= 8);
+    REQUIRE(dsa::Vector<unsigned char>::max_size() > size_type(1) << 32);
+    REQUIRE(dsa::Vector<int>::max_size() < dsa::Vector<unsigned char>::max_size());
+
+    dsa::Vector<int> v;
+    REQUIRE_THROWS_AS(v.reserve(dsa::Vector<int>::max_size() + 1), std::length_error);
+    REQUIRE(v.capacity() == 0);
+}
+
+// Needs several GB of RAM; run explicitly with: my_test "[large]"
+// DSA_LARGE_ELEMS overrides the element count (default 3 * 2^30).
+TEST_CASE("multi-billion element byte vector", "[.][large][size_type]") {
+    using size_type = dsa::Vector<unsigned char>::size_type;
+    size_type n = size_type(3) << 30;
+    if (const char* env = std::getenv("DSA_LARGE_ELEMS"))
+        n = static_cast<size_type>(std::strtoull(env, nullptr, 10));
+
+    dsa::Vector<unsigned char> v;
+    for (size_type i = 0; i < n; ++i)
+        v.push_back(static_cast<unsigned char>(i));
+
+    REQUIRE(v.size() == n);
+    REQUIRE(v.capacity() >= n);
+    REQUIRE(v[n - 1] == static_cast<unsigned char>(n - 1));
+    REQUIRE(v.at(n - 1) == static_cast<unsigned char>(n - 1));
+    if (n > size_type(1) << 31)
+        REQUIRE(v[size_type(1) << 31] == 0); // past the old int limit
+
+    size_type count = 0;
+    for (auto it = v.begin(); it != v.end(); ++it)
+        ++count;
+    REQUIRE(count == n);
+
+    REQUIRE_THROWS_AS(v.at(n), std::out_of_range);
+}
+
+TEST_CASE("resize grows with a fill value and shrinks by destroying the tail", "[resize]") {
+    dsa::Vector<std::string> v;
+    v.resize(3, "ab");
+    REQUIRE(v.size() == 3);
+    REQUIRE(v.capacity() == 3);
+    REQUIRE(v[2] == "ab");
+
+    v.resize(5);
+    REQUIRE(v.size() == 5);
+    REQUIRE(v[4].empty());
+
+    v.resize(1);
+    REQUIRE(v.size() == 1);
+    REQUIRE(v.capacity() == 5);
+    REQUIRE(v[0] == "ab");
+}
+
+// allocator with an id and shared counters; Propagate sets all three
+// propagate_on_container_* flags
+template <typename T, bool Propagate>
+struct TrackingAllocator {
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::integral_constant<bool, Propagate>;
+    using propagate_on_container_move_assignment = std::integral_constant<bool, Propagate>;
+    using propagate_on_container_swap = std::integral_constant<bool, Propagate>;
+
+    struct Counts {
+        int allocations{0};
+        int live{0};
+    };
+
+    int id{0};
+    std::shared_ptr<Counts> counts{std::make_shared<Counts>()};
+
+    TrackingAllocator() = default;
+    explicit TrackingAllocator(int i) : id(i) {}
+    template <typename U>
+    TrackingAllocator(const TrackingAllocator<U, Propagate>& o) : id(o.id), counts(o.counts) {}
+
+    template <typename U>
+    struct rebind { using other = TrackingAllocator<U, Propagate>; };
+
+    T* allocate(std::size_t n){
+        counts->allocations++;
+        counts->live++;
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T* p, std::size_t n){
+        counts->live--;
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    bool operator==(const TrackingAllocator& o) const { return id == o.id; }
+    bool operator!=(const TrackingAllocator& o) const { return id != o.id; }
+};
+
+TEST_CASE("Vector draws all storage from its allocator", "[allocator]") {
+    using Alloc = TrackingAllocator<std::string, false>;
+    Alloc a(1);
+    {
+        dsa::Vector<std::string, Alloc> v(a);
+        for (int i{0}; i < 100; ++i)
+            v.push_back(std::string(20, 'a'));
+        v.insert(0, "front");
+        v.shrink_to_fit();
+        REQUIRE(v.get_allocator() == a);
+        REQUIRE(a.counts->allocations > 1);
+        REQUIRE(a.counts->live == 1);
+
+        dsa::Vector<std::string, Alloc> copy(v);
+        REQUIRE(copy.get_allocator() == a);
+        REQUIRE(copy[0] == "front");
+        REQUIRE(a.counts->live == 2);
+    }
+    REQUIRE(a.counts->live == 0);
+}
+
+TEST_CASE("allocator stays put unless it propagates", "[allocator]") {
+    using Alloc = TrackingAllocator<int, false>;
+    Alloc a(1), b(2);
+    dsa::Vector<int, Alloc> x(a), y(b);
+    for (int i{0}; i < 10; ++i)
+        x.push_back(i);
+
+    y = x;                               // copy: y keeps b
+    REQUIRE(y.get_allocator() == b);
+    REQUIRE(y.size() == 10);
+    REQUIRE(b.counts->live == 1);
+
+    y = std::move(x);                    // unequal, no propagation: element-wise move
+    REQUIRE(y.get_allocator() == b);
+    REQUIRE(y[9] == 9);
+    REQUIRE(b.counts->live == 1);
+
+    dsa::Vector<int, Alloc> z(std::move(y), a);  // allocator-extended move
+    REQUIRE(z.get_allocator() == a);
+    REQUIRE(z[9] == 9);
+}
+
+TEST_CASE("propagating allocator follows the elements", "[allocator]") {
+    using Alloc = TrackingAllocator<int, true>;
+    Alloc a(1), b(2);
+    dsa::Vector<int, Alloc> x(a), y(b);
+    x.push_back(1);
+    y.push_back(2);
+
+    swap(x, y);
+    REQUIRE(x.get_allocator() == b);
+    REQUIRE(y.get_allocator() == a);
+    REQUIRE(x[0] == 2);
+
+    y = x;                               // copy assignment propagates
+    REQUIRE(y.get_allocator() == b);
+    REQUIRE(a.counts->live == 0);
+
+    dsa::Vector<int, Alloc> z(a);
+    z.push_back(3);
+    int* before = &z[0];
+    x = std::move(z);                    // move assignment steals block and allocator
+    REQUIRE(x.get_allocator() == a);
+    REQUIRE(&x[0] == before);
+}
+
+TEST_CASE("stateless default allocator adds no size", "[allocator]") {
+    struct Plain { std::size_t cap, sz; int* data; };
+#if !DSA_VECTOR_STATS   // the counters live in the object
+    REQUIRE(sizeof(dsa::Vector<int>) == sizeof(Plain));
+#endif
+}
+
+TEST_CASE("range insert shifts once and reallocates at most once", "[insert][range]") {
+    dsa::Vector<int> v;
+    for (int i{0}; i < 6; ++i)
+        v.push_back(i);                  // 0..5, cap 8
+    int src[] = {10, 11};
+    v.insert(2, src, src + 2);           // fits: in place
+    REQUIRE(v.size() == 8);
+    REQUIRE(v.capacity() == 8);
+    REQUIRE(v[1] == 1);
+    REQUIRE(v[2] == 10);
+    REQUIRE(v[3] == 11);
+    REQUIRE(v[4] == 2);
+
+    int more[] = {20, 21, 22, 23, 24, 25, 26, 27, 28, 29};
+    auto it = v.insert(v.begin() + 8, more, more + 10);   // one reallocation
+    REQUIRE(*it == 20);
+    REQUIRE(v.size() == 18);
+    REQUIRE(v.capacity() == 18);
+    REQUIRE(v[17] == 29);
+    REQUIRE(v[7] == 5);
+
+    v.insert(0, 3, v[17]);               // value aliases an element
+    REQUIRE(v.size() == 21);
+    REQUIRE(v[0] == 29);
+    REQUIRE(v[2] == 29);
+    REQUIRE(v[3] == 0);
+}
+
+TEST_CASE("range insert of non-trivial elements", "[insert][range]") {
+    dsa::Vector<std::string> v;
+    for (int i{0}; i < 5; ++i)
+        v.push_back(std::string(20, static_cast<char>('a' + i)));
+    v.reserve(20);
+
+    dsa::Vector<std::string> w;
+    w.push_back("x");
+    w.push_back("y");
+    w.push_back("z");
+    v.insert(v.begin() + 1, w.begin(), w.end());          // tail longer than the range
+    v.insert(8, w.begin(), w.end());                      // at the end
+    v.insert(v.begin() + 7, std::size_t(2), std::string("q"));
+    REQUIRE(v.size() == 13);
+    REQUIRE(v[0] == std::string(20, 'a'));
+    REQUIRE(v[1] == "x");
+    REQUIRE(v[3] == "z");
+    REQUIRE(v[4] == std::string(20, 'b'));
+    REQUIRE(v[7] == "q");
+    REQUIRE(v[9] == std::string(20, 'e'));
+    REQUIRE(v[10] == "x");
+    REQUIRE(v[12] == "z");
+
+    std::istringstream in("p q r");      // single-pass input
+    v.insert(v.begin(), std::istream_iterator<std::string>(in), std::istream_iterator<std::string>());
+    REQUIRE(v.size() == 16);
+    REQUIRE(v[0] == "p");
+    REQUIRE(v[2] == "r");
+    REQUIRE(v[3] == std::string(20, 'a'));
+}
+
+TEST_CASE("append accepts any range, including the vector itself", "[append][range]") {
+    dsa::Vector<std::string> v;
+    v.push_back("a");
+    v.push_back("b");
+    v.append(v);
+    REQUIRE(v.size() == 4);
+    REQUIRE(v[3] == "b");
+
+    const char* words[] = {"c", "d"};
+    v.append(words);
+    REQUIRE(v.size() == 6);
+    REQUIRE(v.back() == "d");
+}
+
+TEST_CASE("range erase removes a block with one shift", "[erase][range]") {
+    dsa::Vector<int> v;
+    for (int i{0}; i < 10; ++i)
+        v.push_back(i);
+    auto it = v.erase(v.begin() + 2, v.begin() + 5);
+    REQUIRE(*it == 5);
+    REQUIRE(v.size() == 7);
+    REQUIRE(v[1] == 1);
+    REQUIRE(v[2] == 5);
+    REQUIRE(v[6] == 9);
+
+    dsa::Vector<std::string> s;
+    for (int i{0}; i < 8; ++i)
+        s.push_back(std::to_string(i));
+    s.erase(0, 6);                       // shrinks: 2 <= 8/4
+    REQUIRE(s.size() == 2);
+    REQUIRE(s[0] == "6");
+    REQUIRE(s.capacity() == 4);
+    s.erase(1, 1);                       // empty range
+    REQUIRE(s.size() == 2);
+}
+
+TEST_CASE("assign replaces contents from a range or a fill value", "[assign][range]") {
+    dsa::Vector<std::string> v;
+    v.push_back("old");
+    std::string words[] = {"a", "b", "c"};
+    v.assign(words, words + 3);          // grows: one allocation
+    REQUIRE(v.size() == 3);
+    REQUIRE(v.capacity() == 3);
+    REQUIRE(v[2] == "c");
+
+    v.assign(words + 1, words + 2);      // shrinks in place
+    REQUIRE(v.size() == 1);
+    REQUIRE(v[0] == "b");
+    REQUIRE(v.capacity() == 3);
+
+    v.assign(5, "z");
+    REQUIRE(v.size() == 5);
+    REQUIRE(v[4] == "z");
+
+    std::istringstream in("1 2");
+    dsa::Vector<int> n;
+    n.assign(std::istream_iterator<int>(in), std::istream_iterator<int>());
+    REQUIRE(n.size() == 2);
+    REQUIRE(n[1] == 2);
+    n.assign(std::size_t(0), 7);
+    REQUIRE(n.empty());
+}
+
+TEST_CASE("GrowthPolicy sets the growth factor and step cap", "[growth]") {
+    dsa::Vector<int, std::allocator<int>, 0, dsa::CompactGrowth> v;
+    std::size_t caps[8];
+    for (int i{0}; i < 8; ++i) {
+        v.push_back(i);
+        caps[i] = v.capacity();
+    }
+    REQUIRE(caps[0] == 1);
+    REQUIRE(caps[1] == 2);
+    REQUIRE(caps[2] == 3);               // 2 * 1.5
+    REQUIRE(caps[3] == 4);               // 3 * 1.5 = 4
+    REQUIRE(caps[4] == 6);
+    REQUIRE(caps[6] == 9);
+
+    using Capped = dsa::GeometricGrowth<2, 1, 4, 100>;
+    dsa::Vector<int, std::allocator<int>, 0, Capped> c;
+    c.reserve(1000);
+    for (int i{0}; i < 1001; ++i)
+        c.push_back(i);
+    REQUIRE(c.capacity() == 1100);       // +100, not x2
+
+    REQUIRE(dsa::GeometricGrowth<>::grow(dsa::Vector<int>::max_size() - 1, dsa::Vector<int>::max_size()) ==
+            dsa::Vector<int>::max_size());
+}
+
+TEST_CASE("GrowthPolicy sets the shrink threshold", "[growth][shrink]") {
+    dsa::Vector<int, std::allocator<int>, 0, dsa::NoShrinkGrowth> keep;
+    for (int i{0}; i < 64; ++i)
+        keep.push_back(i);
+    while (!keep.empty())
+        keep.pop_back();
+    REQUIRE(keep.capacity() == 64);      // only shrink_to_fit gives memory back
+    keep.shrink_to_fit();
+    REQUIRE(keep.capacity() == 1);
+
+    dsa::Vector<int, std::allocator<int>, 0, dsa::GeometricGrowth<2, 1, 8>> lazy;
+    for (int i{0}; i < 64; ++i)
+        lazy.push_back(i);
+    lazy.erase(0, 48);                   // 16 left: above 64/8
+    REQUIRE(lazy.capacity() == 64);
+    lazy.erase(0, 8);                    // 8 left: halve
+    REQUIRE(lazy.capacity() == 32);
+}
+
+TEST_CASE("stats() is all zeros unless instrumentation is enabled", "[stats]") {
+    dsa::Vector<int> v;
+    v.push_back(1);
+    REQUIRE(v.stats().allocations == (DSA_VECTOR_STATS ? 1u : 0u));
+}
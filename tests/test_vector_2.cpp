@@ -2,6 +2,12 @@
 //#define CATCH_CONFIG_MAIN // must be in one
 #include "catch2/catch.hpp"
 #include <algorithm>  //for std::max
+#include <cmath>      //for std::signbit
+#include <cstdint>    //for std::uintptr_t
+#include <iterator>   //for std::iterator_traits
+#include <numeric>    //for std::accumulate, std::iota
+#include <string>
+#include <type_traits>
 #include "vector.hpp"
 #include "matrix.hpp"
 
@@ -140,6 +146,91 @@ TEST_CASE("const_iterator cannot mutate elements", "[const_iterator]") {
     REQUIRE(cv.at(0) == 0);
 }
 
+TEST_CASE("iterators are random access", "[iterator][random-access]") {
+    static_assert(std::is_same<std::iterator_traits<dsa::Vector<int>::iterator>::iterator_category,
+                               std::random_access_iterator_tag>::value, "iterator category");
+    static_assert(std::is_same<std::iterator_traits<dsa::Vector<int>::const_iterator>::reference,
+                               const int&>::value, "const_iterator reference");
+
+    dsa::Vector<int> v;
+    for (int i{0}; i < 10; ++i)
+        v.push_back(i * 10);
+
+    auto it = v.begin() + 3;
+    REQUIRE(*it == 30);
+    REQUIRE(it[2] == 50);
+    REQUIRE(*(2 + it) == 50);
+    it += 4;
+    REQUIRE(*it == 70);
+    it -= 6;
+    REQUIRE(*(it - 1) == 0);
+    REQUIRE(v.end() - v.begin() == 10);
+    REQUIRE(v.begin() < it);
+    REQUIRE(it <= it);
+    REQUIRE(v.end() > it);
+
+    const dsa::Vector<int>& cv = v;
+    dsa::Vector<int>::const_iterator cit = v.begin();   // iterator converts
+    REQUIRE(cit == cv.begin());
+    REQUIRE(v.begin() == cv.begin());
+    REQUIRE(cv.end() - cit == 10);
+    REQUIRE(*v.rbegin() == 90);
+    REQUIRE(*(cv.rend() - 1) == 0);
+}
+
+TEST_CASE("std algorithms run on Vector iterators", "[iterator][random-access]") {
+    dsa::Vector<int> v;
+    for (int i{0}; i < 100; ++i)
+        v.push_back((i * 37) % 100);
+
+    std::sort(v.begin(), v.end());
+    REQUIRE(std::is_sorted(v.begin(), v.end()));
+    REQUIRE(*std::lower_bound(v.begin(), v.end(), 42) == 42);
+    REQUIRE(std::distance(v.begin(), std::find(v.begin(), v.end(), 63)) == 63);
+
+    dsa::Vector<int> w;
+    w.resize(100);
+    std::copy(v.cbegin(), v.cend(), w.begin());
+    std::reverse(w.begin(), w.end());
+    REQUIRE(w[0] == 99);
+    REQUIRE(std::accumulate(w.begin(), w.end(), 0) == 4950);
+}
+
+TEST_CASE("resize_for_overwrite keeps old elements and leaves new ones to the caller", "[vector]") {
+    dsa::Vector<int> v;
+    v.push_back(7);
+    v.push_back(8);
+    v.resize_for_overwrite(1000);
+    REQUIRE(v.size() == 1000);
+    REQUIRE(v.capacity() >= 1000);
+    REQUIRE(v[0] == 7);
+    REQUIRE(v[1] == 8);
+    std::iota(v.begin() + 2, v.end(), 2);
+    REQUIRE(v[999] == 999);
+    v.resize_for_overwrite(3);
+    REQUIRE(v.size() == 3);
+    REQUIRE(v[2] == 2);
+
+    // non-trivial elements are value-initialized as by resize
+    dsa::Vector<std::string> s;
+    s.resize_for_overwrite(4);
+    REQUIRE(s.size() == 4);
+    REQUIRE(s[3].empty());
+}
+
+TEST_CASE("iterator insert and erase return valid positions after reallocation", "[iterator]") {
+    dsa::Vector<int> v;
+    v.push_back(1);
+    v.push_back(3);                      // cap 2: next insert reallocates
+    auto it = v.insert(v.begin() + 1, 2);
+    REQUIRE(*it == 2);
+    REQUIRE(it - v.begin() == 1);
+
+    it = v.erase(v.begin());
+    REQUIRE(*it == 2);
+    REQUIRE(it == v.begin());
+}
+
 /* matrix test cases */
 TEST_CASE("Constructor", "[matrix]") {
     dsa::Matrix A(2, 3);
@@ -204,4 +295,85 @@ TEST_CASE("Matrix Addition, same size", "[matrix]") {
             REQUIRE(A_plus_B_actual(i,j) == A_plus_B_expected(i, j));
         }
     }
-}
\ No newline at end of file
+}
+TEST_CASE("Matrix rows are contiguous and padded to the row alignment", "[matrix][storage]") {
+    dsa::Matrix A(3, 5);                 // default: one 64-byte cache line per row chunk
+    REQUIRE(A.getStride() == 16);
+    REQUIRE(&A(1, 0) - &A(0, 0) == 16);
+    REQUIRE(&A(0, 4) - &A(0, 0) == 4);
+
+    dsa::Matrix P(3, 5, 0);              // packed
+    REQUIRE(P.getStride() == 5);
+    REQUIRE(&P(2, 0) - &P(0, 0) == 10);
+
+    dsa::Matrix S(2, 17, 32);            // 32-byte (AVX) rows
+    REQUIRE(S.getStride() == 24);
+    REQUIRE_THROWS_AS(dsa::Matrix(2, 2, 6), std::invalid_argument);
+
+    // padding is not addressable through operator()
+    REQUIRE_THROWS_AS(A(0, 5), std::out_of_range);
+
+    A(2, 4) = 7;
+    dsa::Matrix B(3, 5, 0);
+    B(2, 4) = 1;
+    dsa::Matrix C = A + B;               // mixed strides still add element-wise
+    REQUIRE(C(2, 4) == 8);
+    REQUIRE(C(0, 0) == 0);
+}
+
+TEST_CASE("Matrix rows start on the row alignment", "[matrix][storage]") {
+    dsa::Matrix A(5, 3);
+    for (int i{0}; i < 5; ++i)
+        REQUIRE(reinterpret_cast<std::uintptr_t>(A.row(i)) % 64 == 0);
+
+    dsa::BasicMatrix<double> D = dsa::BasicMatrix<double>(4, 9) * 2.0;
+    REQUIRE(reinterpret_cast<std::uintptr_t>(D.row(3)) % 64 == 0);
+}
+
+TEST_CASE("Matrix unchecked and row access", "[matrix][access]") {
+    dsa::Matrix A(3, 4);
+    A(1, 2) = 5;
+    REQUIRE(A.unchecked(1, 2) == 5);
+    A.unchecked(2, 3) = 9;
+    REQUIRE(A(2, 3) == 9);
+
+    int* r1 = A.row(1);
+    REQUIRE(r1[2] == 5);
+    REQUIRE(A.row(2) - A.row(1) == static_cast<std::ptrdiff_t>(A.getStride()));
+
+    const dsa::Matrix& CA = A;
+    REQUIRE(CA(1, 2) == 5);
+    REQUIRE(CA.row(2)[3] == 9);
+    REQUIRE_THROWS_AS(CA(3, 0), std::out_of_range);
+}
+
+TEST_CASE("Matrix filled and fromBuffer constructors", "[matrix][storage]") {
+    dsa::Matrix F = dsa::Matrix::filled(3, 5, 7);
+    REQUIRE(F.getStride() == 16);
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 5; j++)
+            REQUIRE(F(i, j) == 7);
+    REQUIRE(F.row(0)[5] == 0);   // padding stays zero
+    REQUIRE(dsa::Matrix::filled(2, 2, 0)(1, 1) == 0);
+
+    const int src[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12};
+    dsa::Matrix B = dsa::Matrix::fromBuffer(3, 4, src);
+    dsa::Matrix P = dsa::Matrix::fromBuffer(3, 4, src, 0, 0);        // packed: one copy
+    dsa::Matrix S = dsa::Matrix::fromBuffer(2, 3, src, 6);           // every other row of a 2x6
+    REQUIRE(P.getStride() == 4);
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 4; j++) {
+            REQUIRE(B(i, j) == src[i * 4 + j]);
+            REQUIRE(P(i, j) == src[i * 4 + j]);
+        }
+    REQUIRE(B.row(2)[4] == 0);
+    REQUIRE(S(1, 0) == 7);
+    REQUIRE(S(1, 2) == 9);
+    REQUIRE(dsa::Matrix::fromBuffer(0, 0, nullptr).getRows() == 0);
+    REQUIRE_THROWS_AS(dsa::Matrix::fromBuffer(2, 3, src, 2), std::invalid_argument);
+    REQUIRE_THROWS_AS(dsa::Matrix::fromBuffer(-1, 3, src), std::out_of_range);
+
+    dsa::BasicMatrix<double> D = dsa::BasicMatrix<double>::filled(4, 3, -0.0);
+    REQUIRE(D(3, 2) == 0.0);
+    REQUIRE(std::signbit(D(3, 2)));   // not taken for zero bits
+}
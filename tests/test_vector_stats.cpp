@@ -0,0 +1,129 @@
+// test_vector_stats.cpp - built with DSA_VECTOR_STATS=1 (its own executable)
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+#include "small_vector.hpp"
+#include "vector.hpp"
+#include <string>
+
+#if !DSA_VECTOR_STATS
+#error "test_vector_stats.cpp must be built with DSA_VECTOR_STATS=1"
+#endif
+
+namespace {
+
+// copy may throw, move may throw: relocation has to copy
+struct ThrowingMove {
+    int v;
+    ThrowingMove(int x) : v(x) {}
+    ThrowingMove(const ThrowingMove& o) : v(o.v) {}
+    ThrowingMove(ThrowingMove&& o) noexcept(false) : v(o.v) {}
+    ThrowingMove& operator=(const ThrowingMove& o) { v = o.v; return *this; }
+};
+
+} // namespace
+
+TEST_CASE("Stats count allocations, reallocations and bytes", "[stats]") {
+    dsa::Vector<int> v;
+    for (int i = 0; i < 5; i++) {
+        v.push_back(i);
+    }
+    // capacity 1, 2, 4, 8
+    dsa::VectorStats s = v.stats();
+    REQUIRE(s.allocations == 4);
+    REQUIRE(s.reallocations == 4);
+    REQUIRE(s.bytes_allocated == (1 + 2 + 4 + 8) * sizeof(int));
+    REQUIRE(s.elements_moved == 0 + 1 + 2 + 4);
+    REQUIRE(s.elements_copied == 0);
+    REQUIRE(s.peak_capacity == 8);
+    REQUIRE(s.shrinks == 0);
+}
+
+TEST_CASE("Stats count shrinks and the moves of insert and erase", "[stats]") {
+    dsa::Vector<int> v;
+    v.reserve(16);
+    for (int i = 0; i < 10; i++) {
+        v.push_back(i);
+    }
+    REQUIRE(v.stats().elements_moved == 0);
+
+    v.insert(2, 99);            // moves the 8 elements after index 2
+    REQUIRE(v.stats().elements_moved == 8);
+    v.erase(0);                 // moves the other 10
+    REQUIRE(v.stats().elements_moved == 18);
+    v.erase(2, 8);              // moves the 2 after the gap; 4 left of 16: shrink
+    REQUIRE(v.stats().elements_moved == 20 + 4);
+    REQUIRE(v.stats().shrinks == 1);
+    REQUIRE(v.capacity() == 8);
+}
+
+TEST_CASE("Stats count copies when T's move may throw", "[stats]") {
+    dsa::Vector<ThrowingMove> v;
+    for (int i = 0; i < 3; i++) {
+        v.push_back(ThrowingMove(i));
+    }
+    REQUIRE(v.stats().elements_copied == 0 + 1 + 2);
+    REQUIRE(v.stats().elements_moved == 0);
+
+    dsa::Vector<std::string> s;
+    s.assign(4, "x");
+    REQUIRE(s.stats().elements_copied == 0);
+    dsa::Vector<std::string> copy(s);
+    REQUIRE(copy.stats().elements_copied == 4);
+    REQUIRE(copy.stats().allocations == 1);
+}
+
+TEST_CASE("Copies and moves start with fresh counts", "[stats]") {
+    dsa::Vector<int> v;
+    for (int i = 0; i < 100; i++) {
+        v.push_back(i);
+    }
+    dsa::Vector<int> moved(std::move(v));
+    REQUIRE(moved.stats().allocations == 0);
+    REQUIRE(v.stats().allocations > 0);
+}
+
+TEST_CASE("SmallVector counts only heap blocks", "[stats]") {
+    dsa::SmallVector<int, 4> v;
+    for (int i = 0; i < 4; i++) {
+        v.push_back(i);
+    }
+    REQUIRE(v.stats().allocations == 0);
+    v.push_back(4);
+    REQUIRE(v.stats().allocations == 1);
+    REQUIRE(v.stats().elements_moved == 4);
+    v.shrink_to_fit();
+    v.pop_back();
+    v.shrink_to_fit();          // back into the inline buffer
+    REQUIRE(v.stats().shrinks == 2);
+}
+
+TEST_CASE("Registry keeps per-type totals", "[stats]") {
+    dsa::VectorStatsRegistry& registry = dsa::VectorStatsRegistry::instance();
+    registry.reset();
+    {
+        dsa::Vector<double> a;
+        dsa::Vector<double> b;
+        a.reserve(10);
+        b.reserve(20);
+        dsa::Vector<long> c;
+        c.reserve(5);
+    }
+
+    dsa::VectorStats doubles;
+    dsa::VectorStats longs;
+    for (const auto& entry : registry.snapshot()) {
+        if (entry.first.find("Vector<double") != std::string::npos) {
+            doubles = entry.second;
+        } else if (entry.first.find("Vector<long") != std::string::npos) {
+            longs = entry.second;
+        }
+    }
+    REQUIRE(doubles.allocations == 2);
+    REQUIRE(doubles.bytes_allocated == 30 * sizeof(double));
+    REQUIRE(doubles.peak_capacity == 20);
+    REQUIRE(longs.allocations == 1);
+    REQUIRE(registry.total().allocations == 3);
+
+    registry.reset();
+    REQUIRE(registry.total().allocations == 0);
+}